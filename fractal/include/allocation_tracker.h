@@ -0,0 +1,74 @@
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <stdint.h>
+#include <string>
+
+namespace Fractal {
+	constexpr uint32_t ALLOCATION_HISTORY_SIZE = 600;
+
+	enum class AllocationTag : uint8_t {
+		Unknown = 0,
+		Renderer,
+		Geometry,
+		Log,
+		File,
+		ImGui,
+		App,
+		Count
+	};
+
+	struct AllocationCounters {
+		uint64_t allocations = 0;
+		uint64_t bytes = 0;
+		uint64_t frees = 0;
+		uint64_t freed_bytes = 0;
+	};
+
+	struct AllocationFrame {
+		uint64_t frame = 0;
+		AllocationCounters counters[(size_t)AllocationTag::Count];
+		//Allocations made inside a no allocation scope.
+		uint64_t violations = 0;
+
+		AllocationCounters get_total() const;
+	};
+
+	//Allocations on this thread are counted against the tag until the scope ends.
+	class AllocationScope {
+	public:
+		AllocationScope(AllocationTag tag);
+		~AllocationScope();
+	private:
+		AllocationTag m_previous;
+	};
+
+	//Any allocation on this thread while the scope is alive is reported and asserts in debug builds.
+	class NoAllocationScope {
+	public:
+		NoAllocationScope();
+		~NoAllocationScope();
+	};
+
+	//True when built with FRACTAL_TRACK_ALLOCATIONS, otherwise every counter stays at zero.
+	bool is_allocation_tracking_enabled();
+	const char* get_allocation_tag_name(AllocationTag tag);
+
+	void end_allocation_frame();
+	const AllocationFrame& get_allocation_frame();
+	//Oldest first, returns how many frames were written to frames.
+	uint32_t get_allocation_history(AllocationFrame* frames, uint32_t max_frames);
+	bool write_allocation_csv(const std::string& path);
+}
+
+#ifdef FRACTAL_TRACK_ALLOCATIONS
+#define FRACTAL_ALLOCATION_CONCAT_IMPL(a, b) a##b
+#define FRACTAL_ALLOCATION_CONCAT(a, b) FRACTAL_ALLOCATION_CONCAT_IMPL(a, b)
+#define FRACTAL_ALLOCATION_SCOPE(tag) Fractal::AllocationScope FRACTAL_ALLOCATION_CONCAT(allocation_scope_, __LINE__)(Fractal::AllocationTag::tag)
+#define FRACTAL_NO_ALLOCATION_SCOPE() Fractal::NoAllocationScope FRACTAL_ALLOCATION_CONCAT(no_allocation_scope_, __LINE__)
+#else
+#define FRACTAL_ALLOCATION_SCOPE(tag)
+#define FRACTAL_NO_ALLOCATION_SCOPE()
+#endif
+
+#endif // !ALLOCATION_TRACKER_H
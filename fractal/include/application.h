@@ -9,14 +9,32 @@
 #include "window_event.h"
 #include "layer.h"
 #include "imgui_layer.h"
+#include "frame_buffer.h"
+#include "video_capture.h"
+#include "asset_pack.h"
+#include "frame_sync.h"
+#include "job_system.h"
+#include "fixed_timestep.h"
+#include "frame_pacer.h"
+
+#ifndef FRACTAL_ASSET_PACK_PATH
+#define FRACTAL_ASSET_PACK_PATH "resources.fpak"
+#endif
 
 int main(int argc, char* argv[]);
 
 namespace Fractal {
+    struct OfflineRenderSettings {
+        CaptureSettings capture;
+        float time_step = 0.0f;
+        uint32_t frame_count = 0;
+    };
+
     class Application {
     public:
         virtual ~Application();
-        void initialize(const char* name = "Fractal Application", uint32_t width = 1280, uint32_t height = 720, int flags = 0);
+        void initialize(const char* name = "Fractal Application", uint32_t width = 1280, uint32_t height = 720, int flags = 0,
+            const JobSystemSettings& job_settings = JobSystemSettings());
         void run();
 
         static Application& get() { return *m_instance; }
@@ -25,11 +43,33 @@ namespace Fractal {
         int const get_fps();
         float const get_frame_time();
 
+        void begin_offline_render(const OfflineRenderSettings& settings);
+        void end_offline_render();
+        inline bool is_offline_rendering() const { return m_offline_buffer != nullptr; }
+        inline VideoCapture* get_video_capture() { return &m_video_capture; }
+        inline FrameSync* get_frame_sync() { return &m_frame_sync; }
+        inline JobSystem* get_job_system() { return m_job_system; }
+        //Applies vsync to the window, low latency also drops to a single frame in flight.
+        void set_frame_pacing(const FramePacerSettings& settings);
+        inline FramePacer* get_frame_pacer() { return &m_frame_pacer; }
+
+        //Layers and on_fixed_update get whole ticks of tick_rate, on_update keeps the variable frame time for rendering.
+        void enable_fixed_timestep(const FixedTimestepSettings& settings = FixedTimestepSettings());
+        void disable_fixed_timestep();
+        inline bool is_fixed_timestep() const { return m_fixed; }
+        inline FixedTimestep* get_fixed_timestep() { return &m_fixed_timestep; }
+        //Alpha of the state rendering reads, one when the timestep is variable so interpolation lands on the current state.
+        inline float get_interpolation_alpha() const { return m_fixed ? m_interpolation_alpha : 1.0f; }
+
         virtual void on_user_event(Event& event) { }
         virtual void on_create() { }
         virtual void on_update() { }
         virtual void on_destroy() { }
         virtual void on_gui() { }
+        virtual void on_fixed_update(float step) { }
+        //Called on the main thread once the ticks of a frame are done and none are running,
+        //threaded ticks should copy what rendering reads here.
+        virtual void on_simulation_sync() { }
     protected:
         WindowProperties m_properties;
         Window* m_window = nullptr;
@@ -39,11 +79,34 @@ namespace Fractal {
   		void on_close(const QuitEvent& event);
 		void on_resize(const ResizeEvent& event);
 		void on_event(Event& event);  
+        void begin_offline_frame();
+        void end_offline_frame();
+        void update_simulation();
+        void tick(uint32_t steps, float step);
     private:
         static Application* m_instance;
         int m_fps = 0;
         float m_current_frame_time = 0.0f;
         bool m_running = true;
+
+        OfflineRenderSettings m_offline_settings;
+        VideoCapture m_video_capture;
+        FrameSync m_frame_sync;
+        FramePacer m_frame_pacer;
+        //Frames in flight to go back to when low latency mode is turned off.
+        uint32_t m_paced_frames_in_flight = 0;
+        JobSystem* m_job_system = nullptr;
+        FixedTimestep m_fixed_timestep;
+        JobCounter m_tick_counter;
+        bool m_fixed = false;
+        //Written by the tick job, only read once m_tick_counter is done.
+        float m_tick_ms = 0.0f;
+        float m_interpolation_alpha = 0.0f;
+        //Alpha of the last batch launched, threaded ticks only hand it to rendering once they are synced.
+        float m_pending_alpha = 0.0f;
+        FrameBuffer* m_offline_buffer = nullptr;
+        uint32_t m_offline_frame = 0;
+        AssetPack* m_asset_pack = nullptr;
 		friend int ::main(int argc, char** argv);
     };
 
@@ -0,0 +1,123 @@
+#ifndef ASSET_MANAGER_H
+#define ASSET_MANAGER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include "texture.h"
+#include "texture_loader.h"
+#include "shader.h"
+
+namespace Fractal {
+	class AssetManager;
+
+	enum class AssetType {
+		Texture,
+		Shader
+	};
+
+	struct AssetEntry {
+		AssetType type;
+		std::string path;
+		TextureSpecification specification;
+		std::shared_ptr<Texture> texture;
+		std::shared_ptr<Shader> shader;
+		uint32_t ref_count = 0;
+		uint64_t last_used_frame = 0;
+		uint64_t memory_size = 0;
+		uint32_t load_count = 0;
+	};
+
+	struct AssetManagerSettings {
+		uint64_t memory_budget = 512ull * 1024 * 1024;
+		TextureLoader* texture_loader = nullptr;
+	};
+
+	struct AssetStatistics {
+		uint32_t asset_count = 0;
+		uint32_t resident_count = 0;
+		uint64_t memory_used = 0;
+		uint64_t memory_budget = 0;
+		uint32_t loads = 0;
+		uint32_t reloads = 0;
+		uint32_t evictions = 0;
+	};
+
+	class AssetHandle {
+	public:
+		AssetHandle() = default;
+		AssetHandle(AssetManager* manager, AssetEntry* entry);
+		AssetHandle(const AssetHandle& other);
+		AssetHandle(AssetHandle&& other);
+		AssetHandle& operator=(const AssetHandle& other);
+		AssetHandle& operator=(AssetHandle&& other);
+		virtual ~AssetHandle();
+
+		void reset();
+		inline bool valid() const { return m_entry != nullptr; }
+		inline const std::string& get_path() const { return m_entry->path; }
+	protected:
+		AssetManager* m_manager = nullptr;
+		AssetEntry* m_entry = nullptr;
+	};
+
+	class TextureHandle : public AssetHandle {
+	public:
+		using AssetHandle::AssetHandle;
+
+		Texture* get() const;
+		inline Texture* operator->() const { return get(); }
+	};
+
+	class ShaderHandle : public AssetHandle {
+	public:
+		using AssetHandle::AssetHandle;
+
+		Shader* get() const;
+		inline Shader* operator->() const { return get(); }
+	};
+
+	class AssetManager {
+	public:
+		AssetManager(const AssetManagerSettings& settings = AssetManagerSettings());
+		virtual ~AssetManager();
+
+		TextureHandle load_texture(const std::string& path, const TextureSpecification& specification = TextureSpecification());
+		ShaderHandle load_shader(const std::string& path);
+
+		void begin_frame();
+		void collect();
+
+		inline void set_memory_budget(uint64_t budget) { m_settings.memory_budget = budget; }
+		inline uint64_t get_memory_budget() const { return m_settings.memory_budget; }
+		AssetStatistics get_statistics() const;
+		std::vector<const AssetEntry*> get_entries() const;
+	private:
+		friend class AssetHandle;
+		friend class TextureHandle;
+		friend class ShaderHandle;
+
+		AssetEntry* find_or_create(AssetType type, const std::string& path);
+		void use(AssetEntry* entry);
+		void release(AssetEntry* entry);
+		void load(AssetEntry* entry);
+		void unload(AssetEntry* entry);
+		void update_memory_size(AssetEntry* entry);
+		void evict();
+		bool is_resident(const AssetEntry* entry) const;
+	private:
+		AssetManagerSettings m_settings;
+		std::unordered_map<std::string, AssetEntry*> m_entries;
+
+		uint64_t m_frame = 1;
+		uint64_t m_memory_used = 0;
+		uint32_t m_loads = 0;
+		uint32_t m_reloads = 0;
+		uint32_t m_evictions = 0;
+		bool m_over_budget = false;
+	};
+}
+
+#endif // !ASSET_MANAGER_H
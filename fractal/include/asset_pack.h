@@ -0,0 +1,121 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "mapped_file.h"
+#include "texture_compression.h"
+#include "model.h"
+
+namespace Fractal {
+	constexpr uint32_t ASSET_PACK_MAGIC = 0x4B415046;
+	constexpr uint32_t ASSET_PACK_VERSION = 1;
+	constexpr uint32_t ASSET_PACK_ALIGNMENT = 64;
+
+	constexpr uint32_t ASSET_PACK_COMPRESSED = 0x1;
+	constexpr uint32_t ASSET_PACK_BLOCK_COMPRESSED = 0x2;
+
+	enum class AssetPackType : uint32_t {
+		Raw = 0,
+		Texture = 1,
+		Shader = 2,
+		Mesh = 3
+	};
+
+	struct AssetPackHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t entry_count;
+		uint32_t flags;
+		uint64_t toc_offset;
+		uint64_t names_offset;
+		uint64_t names_size;
+	};
+
+	struct AssetPackEntry {
+		uint64_t name_hash;
+		uint32_t name_offset;
+		uint32_t name_length;
+		uint64_t offset;
+		uint64_t size;
+		uint64_t original_size;
+		AssetPackType type;
+		uint32_t flags;
+
+		uint32_t width;
+		uint32_t height;
+		uint32_t level_count;
+		uint32_t internal_format;
+		uint32_t data_format;
+		uint32_t data_type;
+		uint32_t row_alignment;
+		uint32_t reserved;
+	};
+
+	std::string normalize_asset_name(const std::string& path);
+	uint64_t hash_asset_name(const std::string& name);
+
+	class AssetPack {
+	public:
+		AssetPack() = default;
+		virtual ~AssetPack() = default;
+
+		bool open(const std::string& path);
+		void close();
+
+		const AssetPackEntry* find(const std::string& name) const;
+		std::string get_name(const AssetPackEntry& entry) const;
+
+		bool read(const AssetPackEntry& entry, std::vector<uint8_t>& scratch, const uint8_t*& data) const;
+		bool read_texture(const AssetPackEntry& entry, TextureImage& image) const;
+		bool read_text(const AssetPackEntry& entry, std::string& text) const;
+		bool read_mesh(const AssetPackEntry& entry, Model& model) const;
+
+		inline bool is_open() const { return m_file.is_open(); }
+		inline uint32_t get_entry_count() const { return m_entry_count; }
+		inline const AssetPackEntry* get_entries() const { return m_entries; }
+		inline const std::string& get_path() const { return m_file.path(); }
+	private:
+		MappedFile m_file;
+		const AssetPackEntry* m_entries = nullptr;
+		const char* m_names = nullptr;
+		uint32_t m_entry_count = 0;
+	};
+
+	class AssetPackWriter {
+	public:
+		AssetPackWriter(bool compress = true);
+
+		void add(const std::string& name, AssetPackType type, const void* data, uint64_t size);
+		void add_texture(const std::string& name, const TextureImage& image);
+		void add_shader(const std::string& name, const std::string& source);
+		void add_mesh(const std::string& name, const Model& model);
+		bool write(const std::string& path);
+
+		inline uint64_t get_original_size() const { return m_original_size; }
+		inline uint64_t get_stored_size() const { return m_stored_size; }
+	private:
+		struct PendingEntry {
+			AssetPackEntry entry;
+			std::string name;
+			std::vector<uint8_t> data;
+		};
+
+		PendingEntry& create_entry(const std::string& name, AssetPackType type, const void* data, uint64_t size);
+	private:
+		bool m_compress;
+		std::vector<PendingEntry> m_entries;
+		uint64_t m_original_size = 0;
+		uint64_t m_stored_size = 0;
+	};
+
+	void mount_asset_pack(AssetPack* pack);
+	void unmount_asset_pack(AssetPack* pack);
+	bool find_packed_asset(const std::string& path, const AssetPack*& pack, const AssetPackEntry*& entry);
+	bool load_packed_texture(const std::string& path, TextureImage& image);
+	bool load_packed_text(const std::string& path, std::string& text);
+	bool load_packed_model(const std::string& path, Model& model);
+}
+
+#endif // !ASSET_PACK_H
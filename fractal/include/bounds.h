@@ -0,0 +1,49 @@
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <cfloat>
+#include <glm/glm.hpp>
+
+namespace Fractal {
+	struct BoundingBox {
+		glm::vec3 min = glm::vec3(FLT_MAX);
+		glm::vec3 max = glm::vec3(-FLT_MAX);
+
+		void expand(const glm::vec3& point);
+		void expand(const BoundingBox& box);
+		BoundingBox transform(const glm::mat4& matrix) const;
+
+		inline bool valid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+		inline glm::vec3 get_center() const { return (min + max) * 0.5f; }
+		inline glm::vec3 get_extent() const { return max - min; }
+	};
+
+	struct BoundingSphere {
+		glm::vec3 center = glm::vec3(0.0f);
+		float radius = 0.0f;
+	};
+
+	enum class FrustumTest {
+		Outside,
+		Intersects,
+		Inside
+	};
+
+	//Planes point inward, taken from a projection view matrix.
+	struct Frustum {
+		glm::vec4 planes[6];
+
+		Frustum() = default;
+		Frustum(const glm::mat4& proj_view);
+
+		FrustumTest test(const BoundingBox& box) const;
+		inline bool intersects(const BoundingBox& box) const { return test(box) != FrustumTest::Outside; }
+	};
+
+	BoundingBox compute_bounding_box(const void* positions, size_t count, uint32_t stride);
+	BoundingSphere compute_bounding_sphere(const void* positions, size_t count, uint32_t stride);
+}
+
+#endif // !BOUNDS_H
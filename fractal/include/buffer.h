@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include "handle_pool.h"
 
 namespace Fractal {
 	enum class VertexShaderType {
@@ -81,10 +82,12 @@ namespace Fractal {
 		void set_data(void* data, uint32_t size, uint32_t offset = 0);
 
 		uint32_t get_id() const { return m_vertex_buffer_id; }
+		Handle<VertexBuffer> get_handle() const { return m_handle; }
 
 		void set_layout(const VertexBufferLayout& lay) { m_layout = std::make_shared<VertexBufferLayout>(lay); }
 		std::shared_ptr<VertexBufferLayout> get_layout() { return m_layout; }
 	private:
+		Handle<VertexBuffer> m_handle;
 		uint32_t m_vertex_buffer_id;
 		std::shared_ptr<VertexBufferLayout> m_layout;
 	};
@@ -99,8 +102,10 @@ namespace Fractal {
 		void bind();
 		void unbind();
 		uint32_t get_id() const { return m_index_buffer_id; }
+		Handle<IndexBuffer> get_handle() const { return m_handle; }
 		uint32_t get_count() const { return m_count; }
 	private:
+		Handle<IndexBuffer> m_handle;
 		uint32_t m_index_buffer_id;
 		uint32_t m_count = 0;
 	};
@@ -118,8 +123,10 @@ namespace Fractal {
 		void bind();
 		void unbind();
 		uint32_t get_id() const;
+		Handle<UniformBuffer> get_handle() const { return m_handle; }
 		void set_data(void* data, uint32_t size, uint32_t offset);
 	private:
+		Handle<UniformBuffer> m_handle;
 		uint32_t m_uniform_buffer_id;
 		uint32_t m_uniform_buffer_point;
 		uint32_t m_size_of_buffer;
@@ -133,9 +140,11 @@ namespace Fractal {
 		void bind();
 		void unbind();
 		uint32_t get_id() const;
+		Handle<IndirectDrawBuffer> get_handle() const { return m_handle; }
 		void set_data(void* data, uint32_t size, uint32_t offset);
 		void allocate_data(uint32_t size, void* data);
 	private:
+		Handle<IndirectDrawBuffer> m_handle;
 		uint32_t m_indirect_buffer_id;
 		uint32_t m_size_of_buffer;
 	};
@@ -152,13 +161,55 @@ namespace Fractal {
 		void bind();
 		void unbind();
 		uint32_t get_id() const;
+		Handle<ShaderStorageBuffer> get_handle() const { return m_handle; }
 		void set_data(void* data, uint32_t size, uint32_t offset);
 		void allocate_data(uint32_t size, void* data);
 	private:
+		Handle<ShaderStorageBuffer> m_handle;
 		uint32_t m_shader_storage_id;
 		uint32_t m_binding_point;
 		uint32_t m_size_of_buffer;
 	};
+
+	class PixelPackBuffer {
+	public:
+		PixelPackBuffer(uint32_t size);
+		virtual ~PixelPackBuffer();
+
+		void bind();
+		void unbind();
+		uint32_t get_id() const { return m_pixel_pack_id; }
+		Handle<PixelPackBuffer> get_handle() const { return m_handle; }
+		uint32_t get_size() const { return m_size_of_buffer; }
+		void allocate_data(uint32_t size);
+
+		const void* map(uint32_t size);
+		void unmap();
+	private:
+		Handle<PixelPackBuffer> m_handle;
+		uint32_t m_pixel_pack_id;
+		uint32_t m_size_of_buffer;
+	};
+
+	class PixelUnpackBuffer {
+	public:
+		PixelUnpackBuffer(uint32_t size);
+		virtual ~PixelUnpackBuffer();
+
+		void bind();
+		void unbind();
+		uint32_t get_id() const { return m_pixel_unpack_id; }
+		Handle<PixelUnpackBuffer> get_handle() const { return m_handle; }
+		uint32_t get_size() const { return m_size_of_buffer; }
+		void allocate_data(uint32_t size);
+
+		void* map(uint32_t size);
+		void unmap();
+	private:
+		Handle<PixelUnpackBuffer> m_handle;
+		uint32_t m_pixel_unpack_id;
+		uint32_t m_size_of_buffer;
+	};
 }
 
 #endif // !BUFFER_H
\ No newline at end of file
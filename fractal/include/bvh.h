@@ -0,0 +1,116 @@
+#ifndef BVH_H
+#define BVH_H
+
+#include <stdint.h>
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include "bounds.h"
+#include "thread_pool.h"
+
+namespace Fractal {
+	constexpr uint32_t BVH_NULL = 0xFFFFFFFF;
+	constexpr uint32_t BVH_BIN_COUNT = 16;
+	//Subtrees with more objects than this are built on the thread pool.
+	constexpr uint32_t BVH_PARALLEL_THRESHOLD = 16384;
+
+	//Leaves hold one object, children of an internal node are left and right.
+	struct BvhNode {
+		BoundingBox bounds;
+		uint32_t parent = BVH_NULL;
+		uint32_t left = BVH_NULL;
+		uint32_t right = BVH_NULL;
+		uint32_t object = BVH_NULL;
+
+		inline bool is_leaf() const { return object != BVH_NULL; }
+	};
+
+	struct Ray {
+		glm::vec3 origin = glm::vec3(0.0f);
+		glm::vec3 direction = glm::vec3(0.0f, 0.0f, -1.0f);
+		float max_distance = FLT_MAX;
+	};
+
+	struct RayHit {
+		uint32_t object = BVH_NULL;
+		float distance = FLT_MAX;
+
+		inline bool hit() const { return object != BVH_NULL; }
+	};
+
+	struct BvhStatistics {
+		uint32_t object_count = 0;
+		uint32_t node_count = 0;
+		float build_ms = 0.0f;
+		float refit_ms = 0.0f;
+		//Summed over every query since the last reset.
+		float query_ms = 0.0f;
+		uint32_t queries = 0;
+		uint64_t nodes_visited = 0;
+	};
+
+	//Refines a ray hit against the object's real shape, returns false on a miss.
+	using RayIntersector = std::function<bool(uint32_t object, const Ray& ray, float& distance)>;
+
+	//Queries may run on any thread at once while the tree is not changing, their counters are atomic.
+	class Bvh {
+	public:
+		Bvh() = default;
+
+		//Inserts into the current tree without a rebuild and returns the object's id.
+		uint32_t insert(const BoundingBox& bounds);
+		void remove(uint32_t object);
+		//Moves an object, its ancestors are resized on the next refit.
+		void update(uint32_t object, const BoundingBox& bounds);
+		void refit();
+		//Rebuilds the whole tree with the surface area heuristic, in parallel when a pool is given.
+		void build(ThreadPool* pool = nullptr);
+		void clear();
+
+		void query_frustum(const Frustum& frustum, std::vector<uint32_t>& objects) const;
+		void query_overlap(const BoundingBox& box, std::vector<uint32_t>& objects) const;
+		//Closest hit along the ray, boxes are the hit shape unless an intersector is given.
+		bool raycast(const Ray& ray, RayHit& hit, const RayIntersector& intersector = nullptr) const;
+
+		inline const BoundingBox& get_bounds(uint32_t object) const { return m_objects[object].bounds; }
+		inline bool contains(uint32_t object) const { return object < m_objects.size() && m_objects[object].node != BVH_NULL; }
+		inline const std::vector<BvhNode>& get_nodes() const { return m_nodes; }
+		inline uint32_t get_root() const { return m_root; }
+
+		BvhStatistics get_statistics() const;
+		void reset_query_statistics() const;
+	private:
+		struct BvhObject {
+			BoundingBox bounds;
+			uint32_t node = BVH_NULL;
+		};
+
+		struct BuildTasks;
+
+		uint32_t allocate_node();
+		void free_node(uint32_t node);
+		void insert_leaf(uint32_t leaf);
+		void remove_leaf(uint32_t leaf);
+		void refit_from(uint32_t node);
+		void build_range(uint32_t node, uint32_t parent, uint32_t* objects, uint32_t count, ThreadPool* pool, BuildTasks* tasks);
+		void collect_leaves(uint32_t node, std::vector<uint32_t>& objects, std::vector<uint32_t>& stack, uint64_t& visited) const;
+		void record_query(const std::chrono::high_resolution_clock::time_point& start, uint64_t visited) const;
+	private:
+		std::vector<BvhNode> m_nodes;
+		std::vector<uint32_t> m_free_nodes;
+		uint32_t m_root = BVH_NULL;
+
+		std::vector<BvhObject> m_objects;
+		std::vector<uint32_t> m_free_objects;
+		std::vector<uint32_t> m_dirty;
+
+		//Only the build and refit figures, queries count into the atomics.
+		BvhStatistics m_statistics;
+		mutable std::atomic<uint64_t> m_query_ns{ 0 };
+		mutable std::atomic<uint32_t> m_queries{ 0 };
+		mutable std::atomic<uint64_t> m_nodes_visited{ 0 };
+	};
+}
+
+#endif // !BVH_H
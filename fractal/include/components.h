@@ -0,0 +1,63 @@
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <glm/glm.hpp>
+#include "ecs.h"
+#include "renderer.h"
+
+namespace Fractal {
+	struct Transform {
+		glm::vec3 position = glm::vec3(0.0f);
+		glm::vec3 scale = glm::vec3(1.0f);
+		glm::vec3 orientation = glm::vec3(0.0f, 0.0f, 1.0f);
+		float degree = 0.0f;
+
+		glm::mat4 get_matrix() const;
+	};
+
+	//State at the start of the last fixed tick, rendering blends it with Transform by the interpolation alpha.
+	struct PreviousTransform {
+		Transform transform;
+	};
+
+	Transform interpolate(const Transform& previous, const Transform& current, float alpha);
+
+	struct Velocity {
+		glm::vec3 linear = glm::vec3(0.0f);
+		glm::vec3 acceleration = glm::vec3(0.0f);
+	};
+
+	enum class RenderableShape {
+		Quad,
+		Cube,
+		Mesh
+	};
+
+	struct Renderable {
+		RenderableShape shape = RenderableShape::Quad;
+		glm::vec4 color = glm::vec4(1.0f);
+		//Zero draws the color only.
+		uint32_t texture = 0;
+		//Vertices in model space, only used by RenderableShape::Mesh.
+		const Mesh* mesh = nullptr;
+		//Hidden renderables are skipped by render_entities, such as ones drawn after culling a scene index.
+		bool visible = true;
+	};
+
+	//Integrates every Velocity into its Transform.
+	void update_motion(World& world, float delta);
+	SystemAccess get_motion_access();
+
+	//Run before anything that moves entities in a tick.
+	void store_previous_transforms(World& world, float delta);
+	SystemAccess get_previous_transform_access();
+
+	//Transforms the shape and submits it to the batch of the renderer.
+	void submit_renderable(RendererFrame* renderer, const Transform& transform, const Renderable& renderable);
+	//Submits every visible Renderable with a Transform, call between begin_scene and end_scene.
+	//Entities with a PreviousTransform are drawn alpha of the way from it to their Transform.
+	void render_entities(World& world, RendererFrame* renderer, float alpha = 1.0f);
+	SystemAccess get_render_access();
+}
+
+#endif // !COMPONENTS_H
@@ -0,0 +1,12 @@
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include <stdint.h>
+
+namespace Fractal {
+	uint32_t get_compress_bound(uint32_t size);
+	uint32_t compress_block(const uint8_t* source, uint32_t size, uint8_t* destination, uint32_t capacity);
+	bool decompress_block(const uint8_t* source, uint32_t size, uint8_t* destination, uint32_t decompressed_size);
+}
+
+#endif // !COMPRESSION_H
@@ -0,0 +1,76 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <vector>
+#include "frame_buffer.h"
+#include "gpu_timer.h"
+#include "shader.h"
+#include "vertex_array.h"
+
+namespace Fractal {
+	enum class UpscaleFilter {
+		Bilinear = 0,
+		Sharpen = 1
+	};
+
+	struct DynamicResolutionSettings {
+		float target_frame_ms = 16.0f;
+		float min_scale = 0.5f;
+		float max_scale = 1.0f;
+		float max_scale_down = 0.1f;
+		float max_scale_up = 0.02f;
+		float smoothing = 0.2f;
+		float dead_band = 0.02f;
+		UpscaleFilter filter = UpscaleFilter::Bilinear;
+		float sharpness = 0.5f;
+		uint32_t history_size = 240;
+	};
+
+	class DynamicResolution {
+	public:
+		DynamicResolution(const DynamicResolutionSettings& settings = DynamicResolutionSettings());
+		virtual ~DynamicResolution();
+
+		void begin();
+		void end();
+
+		inline void set_enabled(bool enabled) { m_enabled = enabled; }
+		inline bool is_enabled() const { return m_enabled; }
+
+		inline DynamicResolutionSettings& settings() { return m_settings; }
+		inline float get_scale() const { return m_scale; }
+		inline float get_gpu_time() const { return m_smoothed_ms; }
+		inline uint32_t get_render_width() const { return m_render_width; }
+		inline uint32_t get_render_height() const { return m_render_height; }
+		inline FrameBuffer* get_frame_buffer() { return &m_frame_buffer; }
+
+		inline const std::vector<float>& get_scale_history() const { return m_scale_history; }
+		inline const std::vector<float>& get_gpu_time_history() const { return m_gpu_time_history; }
+		inline uint32_t get_history_offset() const { return m_history_offset; }
+	private:
+		void update_scale();
+		void record_history();
+		void upscale();
+	private:
+		DynamicResolutionSettings m_settings;
+		FrameBuffer m_frame_buffer;
+		GpuTimer m_timer;
+		Shader m_upscale_shader;
+		VertexArray* m_vao = nullptr;
+
+		bool m_enabled = true;
+		bool m_in_frame = false;
+		int m_target_id = 0;
+		int m_target_viewport[4] = { 0 };
+		float m_scale = 1.0f;
+		float m_smoothed_ms = 0.0f;
+		uint32_t m_render_width = 0;
+		uint32_t m_render_height = 0;
+
+		std::vector<float> m_scale_history;
+		std::vector<float> m_gpu_time_history;
+		uint32_t m_history_offset = 0;
+	};
+}
+
+#endif // !DYNAMIC_RESOLUTION_H
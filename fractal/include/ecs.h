@@ -0,0 +1,279 @@
+#ifndef ECS_H
+#define ECS_H
+
+#include <stdint.h>
+#include <vector>
+#include <bitset>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <functional>
+#include "handle_pool.h"
+#include "thread_pool.h"
+#include "job_system.h"
+
+namespace Fractal {
+	struct EntityTag { };
+	using Entity = Handle<EntityTag>;
+
+	constexpr uint32_t MAX_COMPONENT_TYPES = 64;
+	constexpr uint32_t ECS_INVALID_INDEX = 0xFFFFFFFF;
+	using ComponentMask = std::bitset<MAX_COMPONENT_TYPES>;
+
+	uint32_t next_component_id();
+	void report_dead_entity(Entity entity);
+
+	//Ids are handed out the first time a component type is used.
+	template <typename T>
+	inline uint32_t get_component_id() {
+		static const uint32_t id = next_component_id();
+		return id;
+	}
+
+	//Sparse set, the sparse array maps an entity index to its packed index.
+	class ComponentStorageBase {
+	public:
+		virtual ~ComponentStorageBase() = default;
+
+		virtual void remove(uint32_t entity) = 0;
+		virtual void clear() = 0;
+
+		inline bool contains(uint32_t entity) const { return entity < m_sparse.size() && m_sparse[entity] != ECS_INVALID_INDEX; }
+		inline size_t size() const { return m_entities.size(); }
+		//Entity index of every packed component, in the same order as the components.
+		inline const std::vector<uint32_t>& entities() const { return m_entities; }
+	protected:
+		std::vector<uint32_t> m_sparse;
+		std::vector<uint32_t> m_entities;
+	};
+
+	//Each component type lives in its own packed array, so a system only streams the types it touches.
+	template <typename T>
+	class ComponentStorage : public ComponentStorageBase {
+	public:
+		template <typename... Args>
+		T& add(uint32_t entity, Args&&... args) {
+			if (contains(entity)) {
+				T& component = m_components[m_sparse[entity]];
+				component = T{ std::forward<Args>(args)... };
+				return component;
+			}
+
+			if (entity >= m_sparse.size())
+				m_sparse.resize(entity + 1, ECS_INVALID_INDEX);
+			m_sparse[entity] = (uint32_t)m_entities.size();
+			m_entities.push_back(entity);
+			m_components.push_back(T{ std::forward<Args>(args)... });
+			return m_components.back();
+		}
+
+		virtual void remove(uint32_t entity) override {
+			if (!contains(entity))
+				return;
+
+			uint32_t index = m_sparse[entity];
+			uint32_t last = (uint32_t)m_entities.size() - 1;
+			if (index != last) {
+				m_components[index] = std::move(m_components[last]);
+				m_entities[index] = m_entities[last];
+				m_sparse[m_entities[index]] = index;
+			}
+			m_components.pop_back();
+			m_entities.pop_back();
+			m_sparse[entity] = ECS_INVALID_INDEX;
+		}
+
+		virtual void clear() override {
+			m_sparse.clear();
+			m_entities.clear();
+			m_components.clear();
+		}
+
+		inline T* get(uint32_t entity) { return contains(entity) ? &m_components[m_sparse[entity]] : nullptr; }
+		inline const T* get(uint32_t entity) const { return contains(entity) ? &m_components[m_sparse[entity]] : nullptr; }
+		inline T& get_unchecked(uint32_t entity) { return m_components[m_sparse[entity]]; }
+
+		inline T* data() { return m_components.data(); }
+		inline const T* data() const { return m_components.data(); }
+	private:
+		std::vector<T> m_components;
+	};
+
+	//Entities, components and systems may read it from many threads, but only one thread may add or remove.
+	class World {
+	public:
+		World() = default;
+		World(const World&) = delete;
+		World& operator=(const World&) = delete;
+
+		Entity create();
+		void destroy(Entity entity);
+		void clear();
+
+		inline bool alive(Entity entity) const { return entity.valid() && entity.index < m_slots.size() && m_slots[entity.index].alive && m_slots[entity.index].generation == entity.generation; }
+		inline size_t size() const { return m_alive; }
+
+		//A stale handle would write into a freed slot that the next create inherits, so the
+		//component is built in a scratch copy that belongs to no entity instead.
+		template <typename T, typename... Args>
+		T& add(Entity entity, Args&&... args) {
+			if (!alive(entity)) {
+				report_dead_entity(entity);
+				static thread_local T discarded;
+				discarded = T{ std::forward<Args>(args)... };
+				return discarded;
+			}
+			return storage<T>().add(entity.index, std::forward<Args>(args)...);
+		}
+
+		template <typename T>
+		void remove(Entity entity) {
+			ComponentStorage<T>* components = find_storage<T>();
+			if (components && alive(entity))
+				components->remove(entity.index);
+		}
+
+		template <typename T>
+		T* get(Entity entity) {
+			ComponentStorage<T>* components = find_storage<T>();
+			return (components && alive(entity)) ? components->get(entity.index) : nullptr;
+		}
+
+		template <typename T>
+		bool has(Entity entity) const {
+			const ComponentStorage<T>* components = find_storage<T>();
+			return components && alive(entity) && components->contains(entity.index);
+		}
+
+		template <typename T>
+		ComponentStorage<T>& storage() {
+			uint32_t id = get_component_id<T>();
+			if (id >= m_storages.size())
+				m_storages.resize(id + 1);
+			if (!m_storages[id])
+				m_storages[id].reset(new ComponentStorage<T>());
+			return *static_cast<ComponentStorage<T>*>(m_storages[id].get());
+		}
+
+		//Calls function(entity, components...) for every entity holding all of Ts. Walks the smallest
+		//storage, so the rarest component decides the cost. Do not add or remove Ts inside the function.
+		template <typename... Ts, typename F>
+		void each(F&& function) {
+			each_impl<Ts...>(function, std::index_sequence_for<Ts...>());
+		}
+
+		inline Entity get_entity(uint32_t index) const {
+			Entity entity;
+			entity.index = index;
+			entity.generation = m_slots[index].generation;
+			return entity;
+		}
+	private:
+		template <typename T>
+		ComponentStorage<T>* find_storage() {
+			uint32_t id = get_component_id<T>();
+			return (id < m_storages.size()) ? static_cast<ComponentStorage<T>*>(m_storages[id].get()) : nullptr;
+		}
+
+		template <typename T>
+		const ComponentStorage<T>* find_storage() const {
+			uint32_t id = get_component_id<T>();
+			return (id < m_storages.size()) ? static_cast<const ComponentStorage<T>*>(m_storages[id].get()) : nullptr;
+		}
+
+		template <typename... Ts, typename F, size_t... I>
+		void each_impl(F& function, std::index_sequence<I...>) {
+			std::tuple<ComponentStorage<Ts>*...> components(find_storage<Ts>()...);
+			ComponentStorageBase* storages[] = { std::get<I>(components)... };
+
+			ComponentStorageBase* smallest = nullptr;
+			for (ComponentStorageBase* storage : storages) {
+				if (!storage)
+					return;
+				if (!smallest || storage->size() < smallest->size())
+					smallest = storage;
+			}
+
+			const std::vector<uint32_t>& entities = smallest->entities();
+			for (size_t i = 0; i < entities.size(); i++) {
+				uint32_t index = entities[i];
+				bool match = true;
+				for (ComponentStorageBase* storage : storages)
+					match = match && storage->contains(index);
+
+				if (match)
+					function(get_entity(index), std::get<I>(components)->get_unchecked(index)...);
+			}
+		}
+	private:
+		struct EntitySlot {
+			uint32_t generation = 1;
+			bool alive = false;
+		};
+
+		std::vector<EntitySlot> m_slots;
+		std::vector<uint32_t> m_free;
+		size_t m_alive = 0;
+		std::vector<std::unique_ptr<ComponentStorageBase>> m_storages;
+	};
+
+	class SystemAccess {
+	public:
+		template <typename T>
+		SystemAccess& read() { m_reads.set(get_component_id<T>()); return *this; }
+		template <typename T>
+		SystemAccess& write() { m_writes.set(get_component_id<T>()); return *this; }
+		//Runs alone on the thread calling run, for systems that use the GL context or create and destroy entities.
+		SystemAccess& exclusive() { m_exclusive = true; return *this; }
+
+		bool conflicts(const SystemAccess& other) const;
+
+		inline const ComponentMask& get_reads() const { return m_reads; }
+		inline const ComponentMask& get_writes() const { return m_writes; }
+		inline bool is_exclusive() const { return m_exclusive; }
+	private:
+		ComponentMask m_reads;
+		ComponentMask m_writes;
+		bool m_exclusive = false;
+	};
+
+	using SystemFunction = std::function<void(World& world, float delta)>;
+
+	struct SystemStatistics {
+		std::string name;
+		//Systems in the same batch ran at the same time.
+		uint32_t batch = 0;
+		float ms = 0.0f;
+	};
+
+	//Systems keep the order they were added in whenever their access conflicts, anything else may overlap.
+	class SystemScheduler {
+	public:
+		SystemScheduler() = default;
+
+		void add(const std::string& name, const SystemAccess& access, const SystemFunction& update);
+		//Without a pool every system runs in order on the calling thread.
+		void run(World& world, float delta, ThreadPool* pool = nullptr);
+		void run(World& world, float delta, JobSystem* jobs);
+
+		inline uint32_t get_batch_count() const { return (uint32_t)m_batches.size(); }
+		inline const std::vector<SystemStatistics>& get_statistics() const { return m_statistics; }
+	private:
+		void schedule();
+		void run_system(uint32_t system, World& world, float delta);
+	private:
+		struct System {
+			std::string name;
+			SystemAccess access;
+			SystemFunction update;
+		};
+
+		std::vector<System> m_systems;
+		std::vector<std::vector<uint32_t>> m_batches;
+		std::vector<SystemStatistics> m_statistics;
+		bool m_scheduled = false;
+	};
+}
+
+#endif // !ECS_H
@@ -0,0 +1,27 @@
+#ifndef FENCE_H
+#define FENCE_H
+
+#include <stdint.h>
+
+namespace Fractal {
+	class Fence {
+	public:
+		Fence() = default;
+		Fence(const Fence&) = delete;
+		Fence(Fence&& other) : m_sync(other.m_sync) { other.m_sync = nullptr; }
+		virtual ~Fence();
+
+		Fence& operator=(const Fence&) = delete;
+
+		void insert();
+		void reset();
+		bool signaled();
+		bool wait(uint64_t timeout_ns);
+
+		inline bool is_active() const { return m_sync != nullptr; }
+	private:
+		void* m_sync = nullptr;
+	};
+}
+
+#endif // !FENCE_H
@@ -5,8 +5,13 @@
 #include <functional>
 #include <sstream>
 #include <fstream>
+#include <vector>
 
 namespace Fractal {
+    std::vector<std::string> list_directory(const std::string& directory, bool recursive = true);
+    bool create_directory(const std::string& directory);
+    bool file_exists(const std::string& path);
+
     class File {
     public:
         File(const std::string& filepath);
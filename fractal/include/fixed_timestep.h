@@ -0,0 +1,51 @@
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+#include <stdint.h>
+
+namespace Fractal {
+	struct FixedTimestepSettings {
+		//Ticks per second of simulated time.
+		float tick_rate = 60.0f;
+		//Ticks allowed in one frame, time past that is dropped so a slow frame cannot snowball.
+		uint32_t max_steps = 5;
+		//Runs the ticks as a job while the frame renders the last completed state.
+		bool threaded = false;
+	};
+
+	struct FixedTimestepStatistics {
+		uint32_t steps = 0;
+		float alpha = 0.0f;
+		//Time spent running the ticks of the last batch.
+		float tick_ms = 0.0f;
+		float dropped_ms = 0.0f;
+		uint64_t total_ticks = 0;
+		uint64_t dropped_frames = 0;
+	};
+
+	//Accumulates frame time and hands it out in whole ticks, the remainder becomes the interpolation alpha.
+	class FixedTimestep {
+	public:
+		FixedTimestep(const FixedTimestepSettings& settings = FixedTimestepSettings());
+
+		//Adds the frame time and returns how many ticks to run for it.
+		uint32_t advance(float frame_time);
+		void reset();
+
+		void set_settings(const FixedTimestepSettings& settings);
+		inline const FixedTimestepSettings& get_settings() const { return m_settings; }
+		inline float get_step() const { return m_step; }
+		//How far the frame is between the last tick and the next one, blend previous and current state by it.
+		inline float get_alpha() const { return m_accumulator / m_step; }
+
+		inline void set_tick_ms(float tick_ms) { m_statistics.tick_ms = tick_ms; }
+		inline const FixedTimestepStatistics& get_statistics() const { return m_statistics; }
+	private:
+		FixedTimestepSettings m_settings;
+		float m_step = 1.0f / 60.0f;
+		float m_accumulator = 0.0f;
+		FixedTimestepStatistics m_statistics;
+	};
+}
+
+#endif // !FIXED_TIMESTEP_H
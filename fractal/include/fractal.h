@@ -6,11 +6,39 @@
 #include "layer.h"
 #include "file.h"
 #include "texture.h"
+#include "texture_loader.h"
+#include "texture_compression.h"
+#include "texture_atlas.h"
+#include "asset_manager.h"
+#include "asset_pack.h"
+#include "model.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplifier.h"
+#include "mesh_lod.h"
+#include "bounds.h"
+#include "bvh.h"
+#include "occlusion_culling.h"
 #include "shader.h"
 #include "renderer.h"
 #include "camera.h"
 #include "geometry.h"
 #include "frame_buffer.h"
+#include "dynamic_resolution.h"
+#include "readback.h"
+#include "picking.h"
+#include "video_capture.h"
+#include "thread_pool.h"
+#include "job_system.h"
+#include "ecs.h"
+#include "components.h"
+#include "frame_arena.h"
+#include "allocation_tracker.h"
+#include "gpu_memory.h"
+#include "handle_pool.h"
+#include "gpu_resources.h"
+#include "frame_sync.h"
+#include "fixed_timestep.h"
+#include "frame_pacer.h"
 #include "utility.h"
 
 #include "event.h"
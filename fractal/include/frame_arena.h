@@ -0,0 +1,102 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <string>
+
+namespace Fractal {
+	constexpr size_t FRAME_ARENA_SIZE = 1024 * 1024;
+
+	struct ArenaStatistics {
+		size_t used = 0;
+		size_t capacity = 0;
+		size_t peak = 0;
+		uint32_t allocations = 0;
+		//Allocations that did not fit and went to the heap, the arena grows to cover them on reset.
+		uint32_t overflows = 0;
+	};
+
+	//Bump allocator, memory is only given back all at once by reset. Not thread safe.
+	class LinearArena {
+	public:
+		LinearArena(size_t capacity = FRAME_ARENA_SIZE);
+		~LinearArena();
+
+		LinearArena(const LinearArena&) = delete;
+		LinearArena& operator=(const LinearArena&) = delete;
+
+		void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		void reset();
+
+		template <typename T>
+		T* allocate_array(size_t count) { return (T*)allocate(sizeof(T) * count, alignof(T)); }
+
+		inline const ArenaStatistics& get_statistics() const { return m_statistics; }
+		//Statistics of the frame before the last reset.
+		inline const ArenaStatistics& get_last_statistics() const { return m_last_statistics; }
+	private:
+		uint8_t* m_base = nullptr;
+		size_t m_offset = 0;
+		size_t m_capacity = 0;
+		std::vector<uint8_t*> m_overflow;
+
+		ArenaStatistics m_statistics;
+		ArenaStatistics m_last_statistics;
+	};
+
+	//Two arenas that alternate every frame, so data handed to the render thread stays valid while the next frame is built.
+	class DoubleBufferedArena {
+	public:
+		DoubleBufferedArena(size_t capacity = FRAME_ARENA_SIZE);
+
+		//Resets the arena that becomes current, the previous one stays untouched for a frame.
+		void swap();
+
+		inline LinearArena& get_current() { return *m_arenas[m_index]; }
+		inline LinearArena& get_previous() { return *m_arenas[m_index ^ 1]; }
+	private:
+		LinearArena m_first;
+		LinearArena m_second;
+		LinearArena* m_arenas[2];
+		uint32_t m_index = 0;
+	};
+
+	//Owned by the main thread and swapped at the end of every frame.
+	DoubleBufferedArena& get_frame_arenas();
+	inline LinearArena& get_frame_arena() { return get_frame_arenas().get_current(); }
+
+	//Lets standard containers allocate from an arena, deallocation is a no op.
+	template <typename T>
+	class ArenaAllocator {
+	public:
+		using value_type = T;
+
+		ArenaAllocator() : m_arena(&get_frame_arena()) { }
+		ArenaAllocator(LinearArena& arena) : m_arena(&arena) { }
+
+		template <typename U>
+		ArenaAllocator(const ArenaAllocator<U>& other) : m_arena(other.get_arena()) { }
+
+		T* allocate(size_t count) { return (T*)m_arena->allocate(sizeof(T) * count, alignof(T)); }
+		void deallocate(T*, size_t) { }
+
+		inline LinearArena* get_arena() const { return m_arena; }
+	private:
+		LinearArena* m_arena;
+	};
+
+	template <typename T, typename U>
+	inline bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.get_arena() == b.get_arena(); }
+
+	template <typename T, typename U>
+	inline bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.get_arena() != b.get_arena(); }
+
+	//Containers for data that only lives until the end of the frame.
+	template <typename T>
+	using FrameVector = std::vector<T, ArenaAllocator<T>>;
+	using FrameString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+}
+
+#endif // !FRAME_ARENA_H
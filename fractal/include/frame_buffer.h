@@ -2,24 +2,43 @@
 #define OPENGL_FRAME_BUFFER_H
 
 #include <memory>
+#include "handle_pool.h"
 
 namespace Fractal {
+	enum class FrameBufferFormat {
+		RGBA8,
+		//One unsigned integer per pixel, such as object ids. Read with nearest filtering only.
+		R32UI
+	};
+
 	class FrameBuffer {
 	public:
-		FrameBuffer(uint32_t width, uint32_t height);
-		FrameBuffer() = default;
+		FrameBuffer(uint32_t width, uint32_t height, FrameBufferFormat format = FrameBufferFormat::RGBA8);
+		explicit FrameBuffer(FrameBufferFormat format = FrameBufferFormat::RGBA8);
 
 		void init(uint32_t width, uint32_t height);
+		void resize(uint32_t width, uint32_t height);
+		void destroy();
 		virtual ~FrameBuffer();
 
 		void bind();
 		void unbind();
+		void blit_to(FrameBuffer* target, uint32_t width, uint32_t height);
+		uint32_t get_id() const { return m_frame_buffer_id; }
+		Handle<FrameBuffer> get_handle() const { return m_handle; }
 		uint32_t get_color_attachment() { return m_color_attachment; }
 		uint32_t get_buffer_stencil_attachment() const { return m_depth_stencil_attachment; }
+		uint32_t get_width() const { return m_width; }
+		uint32_t get_height() const { return m_height; }
+		FrameBufferFormat get_format() const { return m_format; }
 	private:
-		uint32_t m_frame_buffer_id;
-		uint32_t m_color_attachment;
-		uint32_t m_depth_stencil_attachment;
+		Handle<FrameBuffer> m_handle;
+		FrameBufferFormat m_format = FrameBufferFormat::RGBA8;
+		uint32_t m_frame_buffer_id = 0;
+		uint32_t m_color_attachment = 0;
+		uint32_t m_depth_stencil_attachment = 0;
+		uint32_t m_width = 0;
+		uint32_t m_height = 0;
 	};
 
 	class RenderBuffer {
@@ -0,0 +1,86 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace Fractal {
+	constexpr uint32_t FRAME_PACER_HISTORY_SIZE = 240;
+
+	enum class VsyncMode {
+		Off,
+		On,
+		//Syncs while the frame is on time and tears instead of waiting a whole refresh when it is late.
+		Adaptive
+	};
+
+	struct FramePacerSettings {
+		VsyncMode vsync = VsyncMode::On;
+		//Zero leaves the rate to vsync, or uncapped without it.
+		float target_fps = 0.0f;
+		//Holds input and simulation back until just enough time is left to build the frame before its deadline.
+		bool low_latency = false;
+		//The limiter sleeps until this close to the deadline and spins the rest, sleeps are only coarse.
+		float spin_ms = 2.0f;
+		//Room left on top of the predicted work of a frame in low latency mode.
+		float latency_margin_ms = 1.0f;
+	};
+
+	struct FramePacerStatistics {
+		//Present to present.
+		float frame_ms = 0.0f;
+		float average_frame_ms = 0.0f;
+		//Standard deviation of the frame times in the history.
+		float jitter_ms = 0.0f;
+		float min_frame_ms = 0.0f;
+		float max_frame_ms = 0.0f;
+		//Input to the start of present, smoothed, what low latency mode leaves room for.
+		float work_ms = 0.0f;
+		float sleep_ms = 0.0f;
+		float spin_ms = 0.0f;
+		float latency_wait_ms = 0.0f;
+		//Frames that took over one and a half periods.
+		uint64_t missed_deadlines = 0;
+	};
+
+	//Caps the frame rate with a hybrid sleep and spin wait and tracks how evenly frames are presented.
+	class FramePacer {
+	public:
+		FramePacer(const FramePacerSettings& settings = FramePacerSettings());
+		~FramePacer();
+
+		//Call right before present, swap blocks on vsync so it is kept out of the predicted work.
+		void end_work();
+		//Call right after present, waits out the rest of the frame when a target rate is set.
+		void end_frame();
+		//Call before input is sampled, only waits in low latency mode.
+		void begin_frame();
+
+		void set_settings(const FramePacerSettings& settings);
+		inline const FramePacerSettings& get_settings() const { return m_settings; }
+		//Paces low latency mode when vsync decides the rate.
+		inline void set_refresh_rate(float refresh_rate) { m_refresh_rate = refresh_rate; }
+		//Seconds between deadlines, zero when nothing limits the rate.
+		float get_period() const;
+
+		inline const FramePacerStatistics& get_statistics() const { return m_statistics; }
+		inline const std::vector<float>& get_history() const { return m_history; }
+		inline uint32_t get_history_offset() const { return m_history_offset; }
+	private:
+		void wait_until(double target_ms, float& sleep_ms, float& spin_ms);
+		void record_frame(float frame_ms);
+	private:
+		FramePacerSettings m_settings;
+		float m_refresh_rate = 0.0f;
+		double m_deadline = 0.0;
+		double m_last_present = 0.0;
+		double m_begin = 0.0;
+
+		FramePacerStatistics m_statistics;
+		std::vector<float> m_history;
+		uint32_t m_history_offset = 0;
+		uint32_t m_history_count = 0;
+	};
+}
+
+#endif // !FRAME_PACER_H
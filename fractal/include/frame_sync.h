@@ -0,0 +1,45 @@
+#ifndef FRAME_SYNC_H
+#define FRAME_SYNC_H
+
+#include "fence.h"
+
+namespace Fractal {
+	constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;
+
+	struct FrameSyncStatistics {
+		//Time the last frame spent blocked on the GPU before it could start.
+		float wait_ms = 0.0f;
+		float average_wait_ms = 0.0f;
+		float average_frame_ms = 0.0f;
+		uint32_t frames_in_flight = 0;
+		uint64_t waits = 0;
+		//Set when the CPU spends a noticeable part of each frame waiting on the GPU.
+		bool gpu_bound = false;
+	};
+
+	//Keeps the CPU at most a few frames ahead of the GPU by fencing the end of every frame.
+	class FrameSync {
+	public:
+		FrameSync(uint32_t frames_in_flight = 2);
+
+		//Waits on the fence of the frame that last used this slot, only blocks when the CPU is too far ahead.
+		void begin_frame();
+		void end_frame();
+		//Waits for every frame in flight and deletes the fences, call while the context is still alive.
+		void reset();
+
+		void set_frames_in_flight(uint32_t frames_in_flight);
+		inline uint32_t get_frames_in_flight() const { return m_frames_in_flight; }
+		//Slot of the frame being recorded, for resources that need a copy per frame in flight.
+		inline uint32_t get_frame_index() const { return m_frame_index; }
+		inline const FrameSyncStatistics& get_statistics() const { return m_statistics; }
+	private:
+		Fence m_fences[MAX_FRAMES_IN_FLIGHT];
+		uint32_t m_frames_in_flight = 2;
+		uint32_t m_frame_index = 0;
+		double m_last_begin = 0.0;
+		FrameSyncStatistics m_statistics;
+	};
+}
+
+#endif // !FRAME_SYNC_H
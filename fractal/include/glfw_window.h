@@ -19,6 +19,10 @@ namespace Fractal {
 
         virtual void* get_native_window() override;
         virtual void update() override;
+        virtual void swap_buffers() override;
+        virtual void poll_events() override;
+        virtual VsyncMode set_vsync(VsyncMode mode) override;
+        virtual float get_refresh_rate() override;
         virtual void destroy() override;
         virtual void quit() override;
     private:
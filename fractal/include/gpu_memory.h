@@ -0,0 +1,71 @@
+#ifndef GPU_MEMORY_H
+#define GPU_MEMORY_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Fractal {
+	enum class GpuResourceType : uint8_t {
+		Buffer,
+		Texture,
+		RenderBuffer,
+		Program,
+		FrameBuffer,
+		VertexArray
+	};
+
+	enum class GpuMemoryCategory : uint8_t {
+		VertexBuffer = 0,
+		IndexBuffer,
+		UniformBuffer,
+		IndirectBuffer,
+		StorageBuffer,
+		StagingBuffer,
+		Texture,
+		FrameBuffer,
+		Count
+	};
+
+	struct GpuAllocation {
+		GpuResourceType type = GpuResourceType::Buffer;
+		uint32_t id = 0;
+		GpuMemoryCategory category = GpuMemoryCategory::VertexBuffer;
+		uint64_t size = 0;
+		//GL usage hint for buffers, internal format for textures.
+		uint32_t usage = 0;
+		std::string name;
+	};
+
+	struct GpuMemoryStatistics {
+		uint64_t category_bytes[(size_t)GpuMemoryCategory::Count] = { 0 };
+		uint32_t category_counts[(size_t)GpuMemoryCategory::Count] = { 0 };
+		uint64_t total = 0;
+		uint64_t peak = 0;
+		uint64_t budget = 0;
+
+		//Filled from GL_NVX_gpu_memory_info or GL_ATI_meminfo when the driver has either.
+		bool driver_info = false;
+		uint64_t driver_total = 0;
+		uint64_t driver_available = 0;
+		//How much more the driver's usage grew than the tracked allocations since the first query.
+		int64_t untracked = 0;
+	};
+
+	//Registering an id that is already known updates its size, so reallocations only need to register again.
+	void register_gpu_allocation(GpuResourceType type, uint32_t id, GpuMemoryCategory category, uint64_t size, uint32_t usage, const std::string& name = "");
+	void release_gpu_allocation(GpuResourceType type, uint32_t id);
+	//Also labels the object for graphics debuggers.
+	void set_gpu_allocation_name(GpuResourceType type, uint32_t id, const std::string& name);
+
+	//A budget of zero disables the warning.
+	void set_gpu_memory_budget(uint64_t budget);
+	//Queries the driver every few frames and warns about budget overruns and untracked growth.
+	void update_gpu_memory();
+
+	GpuMemoryStatistics get_gpu_memory_statistics();
+	std::vector<GpuAllocation> get_gpu_allocations();
+	const char* get_gpu_memory_category_name(GpuMemoryCategory category);
+}
+
+#endif // !GPU_MEMORY_H
@@ -0,0 +1,41 @@
+#ifndef GPU_RESOURCES_H
+#define GPU_RESOURCES_H
+
+#include "handle_pool.h"
+#include "gpu_memory.h"
+
+namespace Fractal {
+	//Every live GPU object of type T, only touched from the thread that owns the GL context.
+	template <typename T>
+	HandlePool<T, T*>& get_gpu_resource_pool() {
+		static HandlePool<T, T*> pool;
+		return pool;
+	}
+
+	template <typename T>
+	inline Handle<T> register_gpu_resource(T* resource) {
+		return get_gpu_resource_pool<T>().create(resource);
+	}
+
+	template <typename T>
+	inline void unregister_gpu_resource(Handle<T> handle) {
+		get_gpu_resource_pool<T>().destroy(handle);
+	}
+
+	//Returns nullptr when the resource behind the handle has been destroyed.
+	template <typename T>
+	inline T* resolve(Handle<T> handle) {
+		T** resource = get_gpu_resource_pool<T>().get(handle);
+		return resource ? *resource : nullptr;
+	}
+
+	//The object is deleted once the GPU has finished the frame it was queued in.
+	void destroy_gpu_resource(GpuResourceType type, uint32_t id);
+	//Fences the frame's queued destructions and deletes every earlier batch the GPU has finished.
+	void end_gpu_frame();
+	//Deletes everything still queued, later destructions only release their tracking since the context is going away.
+	void flush_gpu_resources();
+	uint32_t get_pending_gpu_destructions();
+}
+
+#endif // !GPU_RESOURCES_H
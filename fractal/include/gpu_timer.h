@@ -0,0 +1,29 @@
+#ifndef GPU_TIMER_H
+#define GPU_TIMER_H
+
+#include <stdint.h>
+
+namespace Fractal {
+	constexpr uint32_t GPU_TIMER_QUERY_COUNT = 4;
+
+	class GpuTimer {
+	public:
+		GpuTimer();
+		virtual ~GpuTimer();
+
+		void begin();
+		void end();
+		bool poll();
+
+		inline float get_elapsed_ms() const { return m_elapsed_ms; }
+	private:
+		uint32_t m_queries[GPU_TIMER_QUERY_COUNT] = { 0 };
+		uint32_t m_write_index = 0;
+		uint32_t m_read_index = 0;
+		uint32_t m_pending = 0;
+		bool m_active = false;
+		float m_elapsed_ms = 0.0f;
+	};
+}
+
+#endif // !GPU_TIMER_H
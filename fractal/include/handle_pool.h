@@ -0,0 +1,111 @@
+#ifndef HANDLE_POOL_H
+#define HANDLE_POOL_H
+
+#include <stdint.h>
+#include <vector>
+#include <cstddef>
+
+namespace Fractal {
+	//A generation of zero is never handed out so a default handle is always invalid.
+	template <typename T>
+	struct Handle {
+		uint32_t index = 0;
+		uint32_t generation = 0;
+
+		inline bool valid() const { return generation != 0; }
+		inline bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+		inline bool operator!=(const Handle& other) const { return !(*this == other); }
+	};
+
+	//Values are kept packed for iteration, handles go through a slot that knows where each value lives.
+	template <typename T, typename V = T>
+	class HandlePool {
+	public:
+		HandlePool() = default;
+
+		Handle<T> create(const V& value) {
+			uint32_t index;
+			if (!m_free.empty()) {
+				index = m_free.back();
+				m_free.pop_back();
+			}
+			else {
+				index = (uint32_t)m_slots.size();
+				m_slots.push_back(Slot());
+			}
+
+			Slot& slot = m_slots[index];
+			slot.dense = (uint32_t)m_values.size();
+			m_values.push_back(value);
+			m_owners.push_back(index);
+
+			Handle<T> handle;
+			handle.index = index;
+			handle.generation = slot.generation;
+			return handle;
+		}
+
+		bool destroy(Handle<T> handle) {
+			if (!valid(handle))
+				return false;
+
+			Slot& slot = m_slots[handle.index];
+			uint32_t last = (uint32_t)m_values.size() - 1;
+			if (slot.dense != last) {
+				m_values[slot.dense] = m_values[last];
+				m_owners[slot.dense] = m_owners[last];
+				m_slots[m_owners[slot.dense]].dense = slot.dense;
+			}
+			m_values.pop_back();
+			m_owners.pop_back();
+
+			slot.dense = INVALID_INDEX;
+			if (++slot.generation == 0)
+				slot.generation = 1;
+			m_free.push_back(handle.index);
+			return true;
+		}
+
+		inline bool valid(Handle<T> handle) const {
+			return (handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation && m_slots[handle.index].dense != INVALID_INDEX);
+		}
+
+		//Returns nullptr once the handle has been destroyed, even if its slot was reused.
+		inline V* get(Handle<T> handle) { return valid(handle) ? &m_values[m_slots[handle.index].dense] : nullptr; }
+		inline const V* get(Handle<T> handle) const { return valid(handle) ? &m_values[m_slots[handle.index].dense] : nullptr; }
+
+		void clear() {
+			for (uint32_t index : m_owners) {
+				m_slots[index].dense = INVALID_INDEX;
+				if (++m_slots[index].generation == 0)
+					m_slots[index].generation = 1;
+				m_free.push_back(index);
+			}
+			m_values.clear();
+			m_owners.clear();
+		}
+
+		inline size_t size() const { return m_values.size(); }
+		inline bool empty() const { return m_values.empty(); }
+
+		inline typename std::vector<V>::iterator begin() { return m_values.begin(); }
+		inline typename std::vector<V>::iterator end() { return m_values.end(); }
+		inline typename std::vector<V>::const_iterator begin() const { return m_values.begin(); }
+		inline typename std::vector<V>::const_iterator end() const { return m_values.end(); }
+	private:
+		static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+		struct Slot {
+			uint32_t generation = 1;
+			uint32_t dense = INVALID_INDEX;
+		};
+
+		std::vector<Slot> m_slots;
+		std::vector<V> m_values;
+		//Slot index of every packed value so swap removal can fix up the moved value's slot.
+		std::vector<uint32_t> m_owners;
+		std::vector<uint32_t> m_free;
+	};
+}
+
+#endif // !HANDLE_POOL_H
@@ -0,0 +1,131 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <stdint.h>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace Fractal {
+	//Power of two, jobs past this go to the shared queue.
+	constexpr uint32_t JOB_DEQUE_CAPACITY = 4096;
+	constexpr uint32_t MAX_JOB_WORKERS = 64;
+
+	using JobFunction = std::function<void()>;
+	struct Job;
+
+	//Counts unfinished jobs. Jobs that depend on it are released the first time it reaches zero.
+	class JobCounter {
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		inline bool done() const { return m_count.load(std::memory_order_acquire) == 0; }
+		inline uint32_t get() const { return m_count.load(std::memory_order_acquire); }
+	private:
+		std::atomic<uint32_t> m_count{ 0 };
+		std::mutex m_mutex;
+		std::vector<Job*> m_waiting;
+
+		friend class JobSystem;
+	};
+
+	//Chase-Lev deque, the owning worker pushes and pops the bottom while thieves take from the top.
+	class JobDeque {
+	public:
+		JobDeque();
+
+		bool push(Job* job);
+		Job* pop();
+		Job* steal();
+	private:
+		std::atomic<int64_t> m_top{ 0 };
+		std::atomic<int64_t> m_bottom{ 0 };
+		std::atomic<Job*> m_jobs[JOB_DEQUE_CAPACITY];
+	};
+
+	struct JobSystemSettings {
+		//Zero starts one worker per hardware thread besides the main thread.
+		uint32_t worker_count = 0;
+		//Pins worker i to hardware thread affinity_offset + i, the main thread is left alone.
+		bool pin_threads = false;
+		uint32_t affinity_offset = 1;
+	};
+
+	//Index zero is the main thread, only the jobs it runs count as busy.
+	struct WorkerStatistics {
+		float busy_ms = 0.0f;
+		//Share of the last frame spent running jobs.
+		float utilization = 0.0f;
+		uint32_t jobs = 0;
+		uint32_t steals = 0;
+	};
+
+	class JobSystem {
+	public:
+		JobSystem(const JobSystemSettings& settings = JobSystemSettings());
+		virtual ~JobSystem();
+
+		//Queues a job once dependency reaches zero, counter is raised now and lowered when the job finishes.
+		void run(const JobFunction& job, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+		//Calls function on batches of [0, count) across every worker and returns once all are done.
+		void parallel_for(uint32_t count, uint32_t batch_size, const std::function<void(uint32_t begin, uint32_t end)>& function);
+		//Runs other jobs on the calling thread until the counter reaches zero.
+		void wait(JobCounter& counter);
+
+		//For work that needs the GL context, run by the main thread once a frame or while it waits.
+		void run_on_main_thread(const JobFunction& job, JobCounter* counter = nullptr);
+		void execute_main_thread_jobs();
+
+		//Turns the busy time of every worker into the statistics of the frame that just ended.
+		void end_frame();
+
+		bool is_main_thread() const;
+		inline uint32_t get_worker_count() const { return (uint32_t)m_threads.size(); }
+		inline const std::vector<WorkerStatistics>& get_statistics() const { return m_statistics; }
+	private:
+		struct Worker {
+			JobDeque deque;
+			std::atomic<uint64_t> busy_ns{ 0 };
+			std::atomic<uint32_t> jobs{ 0 };
+			std::atomic<uint32_t> steals{ 0 };
+		};
+
+		void worker_loop(uint32_t index);
+		void submit(Job* job);
+		void release(JobCounter* counter);
+		Job* find_job(uint32_t index);
+		bool execute_one(uint32_t index);
+		void execute(Job* job, uint32_t index);
+		void set_affinity(std::thread& thread, uint32_t core);
+	private:
+		JobSystemSettings m_settings;
+		std::thread::id m_main_thread;
+		std::vector<std::thread> m_threads;
+		//Worker zero belongs to the main thread.
+		std::vector<Worker*> m_workers;
+
+		//Jobs from threads without a deque and jobs that overflowed one.
+		std::deque<Job*> m_shared;
+		std::mutex m_shared_mutex;
+
+		std::vector<Job*> m_main_jobs;
+		std::mutex m_main_mutex;
+
+		std::atomic<uint32_t> m_queued{ 0 };
+		std::atomic<uint32_t> m_sleeping{ 0 };
+		std::mutex m_sleep_mutex;
+		std::condition_variable m_wake;
+		std::atomic<bool> m_stop{ false };
+
+		std::vector<WorkerStatistics> m_statistics;
+		uint64_t m_frame_start_ns = 0;
+	};
+}
+
+#endif // !JOB_SYSTEM_H
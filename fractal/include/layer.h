@@ -6,6 +6,8 @@
 #include "event.h"
 
 namespace Fractal {
+	class JobSystem;
+
 	class Layer {
 	public:
 		Layer(const std::string& name)
@@ -15,12 +17,20 @@ namespace Fractal {
 		virtual void on_attach() {}
 		virtual void on_detach() {}
 		virtual void on_update(float delta) {}
+		//Only called in fixed timestep mode, possibly on a worker thread.
+		virtual void on_fixed_update(float step) {}
 		virtual void user_def_event(Event& event) {}
 		virtual void update_gui() { }
 
 		inline std::string get_name() const { return m_name; }
+		//Set once the layer is pushed, so on_update can fan work out across the workers.
+		inline JobSystem* get_job_system() const { return m_job_system; }
 	protected:
 		std::string m_name;
+	private:
+		JobSystem* m_job_system = nullptr;
+
+		friend class Application;
 	};
 
 	class LayerStack {
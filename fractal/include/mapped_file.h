@@ -0,0 +1,32 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <stdint.h>
+#include <string>
+
+namespace Fractal {
+	class MappedFile {
+	public:
+		MappedFile() = default;
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		virtual ~MappedFile();
+
+		bool open(const std::string& path);
+		void close();
+
+		inline bool is_open() const { return m_data != nullptr; }
+		inline const uint8_t* data() const { return m_data; }
+		inline uint64_t size() const { return m_size; }
+		inline const std::string& path() const { return m_path; }
+	private:
+		std::string m_path;
+		const uint8_t* m_data = nullptr;
+		uint64_t m_size = 0;
+
+		void* m_file = nullptr;
+		void* m_mapping = nullptr;
+	};
+}
+
+#endif // !MAPPED_FILE_H
@@ -0,0 +1,54 @@
+#ifndef MESH_LOD_H
+#define MESH_LOD_H
+
+#include <stdint.h>
+#include <vector>
+#include "mesh.h"
+#include "bounds.h"
+#include "camera.h"
+
+namespace Fractal {
+	constexpr uint32_t MAX_LOD_LEVELS = 8;
+
+	struct LodLevelSettings {
+		//Fraction of the original triangles this level keeps.
+		float ratio = 0.5f;
+		//Switch to this level once the object covers less than this fraction of the screen height.
+		float screen_size = 0.5f;
+	};
+
+	struct LodSettings {
+		std::vector<LodLevelSettings> levels = { { 0.5f, 0.5f }, { 0.25f, 0.25f }, { 0.125f, 0.1f } };
+		//Largest simplification error allowed, relative to the mesh size.
+		float target_error = 0.05f;
+		//How far past a threshold the screen size has to move before the level changes back.
+		float hysteresis = 0.1f;
+	};
+
+	class LodMesh {
+	public:
+		LodMesh() = default;
+		LodMesh(const Mesh& mesh, const LodSettings& settings = LodSettings());
+
+		//The mesh indices must be relative to its own vertices.
+		void build(const Mesh& mesh, const LodSettings& settings = LodSettings());
+		uint32_t select_level(float screen_size);
+
+		inline Mesh& get_level(uint32_t level) { return m_levels[level]; }
+		inline uint32_t get_level_count() const { return (uint32_t)m_levels.size(); }
+		inline uint32_t get_current_level() const { return m_current_level; }
+		inline const BoundingSphere& get_bounds() const { return m_bounds; }
+		inline uint32_t get_triangle_count(uint32_t level) const { return (uint32_t)(m_levels[level].indices.size() / 3); }
+	private:
+		std::vector<Mesh> m_levels;
+		std::vector<float> m_screen_sizes;
+		BoundingSphere m_bounds;
+		float m_hysteresis = 0.1f;
+		uint32_t m_current_level = 0;
+	};
+
+	//Fraction of the screen height covered by the sphere.
+	float get_screen_size(const BoundingSphere& sphere, const Camera& camera);
+}
+
+#endif // !MESH_LOD_H
@@ -0,0 +1,41 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "mesh.h"
+#include "model.h"
+
+namespace Fractal {
+	struct MeshOptimizerSettings {
+		uint32_t cache_size = 16;
+		//Overdraw ordering may cost this much ACMR relative to the cache optimized order.
+		float overdraw_threshold = 1.05f;
+		bool weld = true;
+		bool optimize_overdraw = true;
+	};
+
+	struct VertexCacheStatistics {
+		uint32_t misses = 0;
+		float acmr = 0.0f;
+		float atvr = 0.0f;
+	};
+
+	struct MeshOptimizerStatistics {
+		uint32_t vertices_before = 0;
+		uint32_t vertices_after = 0;
+		VertexCacheStatistics before;
+		VertexCacheStatistics after;
+	};
+
+	uint32_t weld_vertices(void* vertices, uint32_t vertex_count, uint32_t vertex_size, uint32_t* indices, size_t index_count);
+	void optimize_vertex_cache(uint32_t* indices, size_t index_count, uint32_t cache_size = 16);
+	void optimize_overdraw(uint32_t* indices, size_t index_count, const void* positions, uint32_t vertex_stride, uint32_t cache_size = 16, float threshold = 1.05f);
+	uint32_t optimize_vertex_fetch(void* vertices, uint32_t vertex_count, uint32_t vertex_size, uint32_t* indices, size_t index_count);
+	VertexCacheStatistics analyze_vertex_cache(const uint32_t* indices, size_t index_count, uint32_t vertex_count, uint32_t cache_size = 16);
+
+	MeshOptimizerStatistics optimize_mesh(Mesh& mesh, const MeshOptimizerSettings& settings = MeshOptimizerSettings());
+	MeshOptimizerStatistics optimize_mesh(Model& model, const MeshOptimizerSettings& settings = MeshOptimizerSettings());
+}
+
+#endif // !MESH_OPTIMIZER_H
@@ -0,0 +1,15 @@
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Fractal {
+	//Quadric error edge collapse. Vertices are only ever collapsed onto other existing vertices so the
+	//result indexes the same vertex buffer. Errors are relative to the size of the mesh.
+	//Returns the number of indices written to destination, which must hold index_count indices.
+	size_t simplify_mesh(uint32_t* destination, const uint32_t* indices, size_t index_count, const void* positions, uint32_t vertex_count, uint32_t vertex_stride,
+		size_t target_index_count, float target_error, float* result_error = nullptr);
+}
+
+#endif // !MESH_SIMPLIFIER_H
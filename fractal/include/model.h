@@ -0,0 +1,47 @@
+#ifndef MODEL_H
+#define MODEL_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "mesh.h"
+#include "thread_pool.h"
+
+namespace Fractal {
+	struct ModelPrimitive {
+		std::string name;
+		uint32_t index_offset = 0;
+		uint32_t index_count = 0;
+		uint32_t material = 0;
+	};
+
+	struct Model {
+		std::vector<ModelVertex> vertices;
+		std::vector<uint32_t> indices;
+		std::vector<ModelPrimitive> primitives;
+		std::vector<std::string> materials;
+
+		void clear();
+		inline uint32_t get_triangle_count() const { return (uint32_t)(indices.size() / 3); }
+	};
+
+	struct ModelImportSettings {
+		//Parsing runs on this pool, a temporary one is created when it is null.
+		ThreadPool* thread_pool = nullptr;
+		uint32_t chunk_size = 4 * 1024 * 1024;
+		bool generate_normals = true;
+		bool optimize = true;
+	};
+
+	bool load_model(const std::string& path, Model& model, const ModelImportSettings& settings = ModelImportSettings());
+	//Imports the source file without looking in asset packs, works in cooked builds so tools can still import.
+	bool import_model(const std::string& path, Model& model, const ModelImportSettings& settings = ModelImportSettings());
+	bool load_obj(const std::string& path, Model& model, const ModelImportSettings& settings = ModelImportSettings());
+	bool load_gltf(const std::string& path, Model& model, const ModelImportSettings& settings = ModelImportSettings());
+
+	void generate_normals(Model& model);
+	void serialize_model(const Model& model, std::vector<uint8_t>& data);
+	bool deserialize_model(const uint8_t* data, uint64_t size, Model& model);
+}
+
+#endif // !MODEL_H
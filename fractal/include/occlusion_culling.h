@@ -0,0 +1,82 @@
+#ifndef OCCLUSION_CULLING_H
+#define OCCLUSION_CULLING_H
+
+#include <glm/glm.hpp>
+#include "buffer.h"
+#include "fence.h"
+#include "shader.h"
+
+namespace Fractal {
+	constexpr uint32_t OCCLUSION_COUNTER_SLOTS = 3;
+	//Above the batch texture slots so the pyramid never replaces a batched texture.
+	constexpr uint32_t OCCLUSION_TEXTURE_UNIT = 32;
+
+	enum class OcclusionPhase {
+		//Tests against the pyramid of the previous frame.
+		Early,
+		//Tests what the early phase culled against the depth drawn this frame.
+		Late
+	};
+
+	//World space box of a draw command, min greater than max means always visible.
+	struct OcclusionBounds {
+		glm::vec4 min = glm::vec4(1.0f);
+		glm::vec4 max = glm::vec4(-1.0f);
+	};
+
+	//Counts are read back a few frames late so nothing waits on the GPU.
+	struct OcclusionStatistics {
+		uint32_t tested = 0;
+		uint32_t visible = 0;
+		//Still hidden after the late phase, includes objects off screen.
+		uint32_t occluded = 0;
+		//Culled by the early phase but visible against this frame's depth.
+		uint32_t late_visible = 0;
+	};
+
+	class OcclusionCuller {
+	public:
+		OcclusionCuller(uint32_t max_commands);
+		virtual ~OcclusionCuller();
+
+		//Call once per frame before any culling.
+		void begin_frame();
+		//Writes the instance count of every command in the indirect buffer.
+		void cull(IndirectDrawBuffer* commands, const OcclusionBounds* bounds, uint32_t count, OcclusionPhase phase);
+		//Builds the depth pyramid from the depth attachment of the bound draw frame buffer.
+		bool build();
+
+		inline bool is_valid() const { return m_valid; }
+		inline uint32_t get_pyramid() const { return m_pyramid; }
+		inline uint32_t get_pyramid_levels() const { return m_levels; }
+		inline const OcclusionStatistics& get_statistics() const { return m_statistics; }
+	private:
+		void resize(uint32_t width, uint32_t height);
+	private:
+		Shader m_pyramid_shader;
+		Shader m_cull_shader;
+
+		uint32_t m_pyramid = 0;
+		uint32_t m_storage_width = 0;
+		uint32_t m_storage_height = 0;
+		//The part of the pyramid covering the viewport it was last built from.
+		uint32_t m_width = 0;
+		uint32_t m_height = 0;
+		uint32_t m_levels = 0;
+		bool m_valid = false;
+
+		uint32_t m_max_commands = 0;
+		ShaderStorageBuffer* m_bounds = nullptr;
+		ShaderStorageBuffer* m_visibility = nullptr;
+
+		ShaderStorageBuffer* m_counters[OCCLUSION_COUNTER_SLOTS] = { nullptr };
+		Fence m_counter_fences[OCCLUSION_COUNTER_SLOTS];
+		bool m_counter_pending[OCCLUSION_COUNTER_SLOTS] = { false };
+		uint32_t m_counter_index = 0;
+		bool m_counter_used = false;
+
+		OcclusionStatistics m_statistics;
+	};
+}
+
+#endif // !OCCLUSION_CULLING_H
@@ -0,0 +1,114 @@
+#ifndef PICKING_H
+#define PICKING_H
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "renderer.h"
+#include "readback.h"
+
+namespace Fractal {
+	//The id buffer is cleared to this, so object ids start at one.
+	constexpr uint32_t PICKING_NO_OBJECT = 0;
+	constexpr uint32_t PICKING_READBACK_SLOTS = 3;
+	constexpr size_t MAX_PICKING_VERTEX_COUNT = 10000;
+	constexpr size_t MAX_PICKING_INDEX_COUNT = 10000;
+
+	struct PickingVertex {
+		glm::vec3 position;
+		uint32_t object_id;
+	};
+
+	class PickingGraphicsDevice : public GraphicsDevice<PickingVertex> {
+	public:
+		PickingGraphicsDevice(uint32_t max_vertex_count, uint32_t max_index_count);
+
+		virtual void init() override;
+		virtual void setup() override;
+		//Writes the id set by set_object_id.
+		virtual bool submit(Mesh& mesh) override;
+		virtual void render() override;
+
+		//Indices are relative to the given vertices.
+		bool submit(const Vertex* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count, uint32_t object_id);
+
+		inline void set_object_id(uint32_t object_id) { m_object_id = object_id; }
+	private:
+		uint32_t m_object_id = PICKING_NO_OBJECT;
+	};
+
+	struct PickingSettings {
+		//Size of the id buffer relative to the target. Lower reads less but can miss objects thinner than a pixel.
+		float scale = 0.5f;
+	};
+
+	struct PickingResult {
+		//Requested region in target pixels, origin top left like the mouse position.
+		uint32_t x = 0, y = 0;
+		uint32_t width = 0, height = 0;
+		//Ids of the id buffer pixels covering the region, bottom row first.
+		std::vector<uint32_t> ids;
+		uint32_t columns = 0, rows = 0;
+
+		//Id at the center of the region.
+		uint32_t get_id() const;
+		void get_unique_ids(std::vector<uint32_t>& objects) const;
+	};
+
+	struct PickingStatistics {
+		uint32_t requested = 0;
+		uint32_t completed = 0;
+		uint32_t rejected = 0;
+		//Frames between a pick and its result of the last completed pick.
+		uint32_t latency_frames = 0;
+	};
+
+	class PickingPass {
+	public:
+		PickingPass(const PickingSettings& settings = PickingSettings());
+		virtual ~PickingPass();
+
+		//Renders into the id buffer at the scaled size of the bound target until end.
+		void begin(Camera* camera);
+		void submit(Mesh& mesh, uint32_t object_id);
+		void submit(const Vertex* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count, uint32_t object_id);
+		void end();
+
+		//Reads ids the last pass wrote without waiting, poll returns them in a later frame.
+		bool pick(const glm::vec2& position);
+		bool pick(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+		//Oldest finished pick, false while the GPU has not caught up.
+		bool poll(PickingResult& result);
+
+		inline PickingSettings& settings() { return m_settings; }
+		inline FrameBuffer* get_frame_buffer() { return &m_frame_buffer; }
+		inline const PickingStatistics& get_statistics() const { return m_statistics; }
+	private:
+		void flush();
+	private:
+		struct PickingRequest {
+			ReadbackTicket ticket;
+			PickingResult result;
+			uint64_t frame = 0;
+		};
+
+		PickingSettings m_settings;
+		FrameBuffer m_frame_buffer;
+		Shader m_shader;
+		PickingGraphicsDevice* m_gd = nullptr;
+		AsyncReadback m_readback;
+		std::vector<PickingRequest> m_requests;
+
+		glm::mat4 m_proj_view = glm::mat4(1.0f);
+		bool m_in_pass = false;
+		int m_target_id = 0;
+		int m_target_viewport[4] = { 0 };
+		//Part of the id buffer the last pass wrote.
+		uint32_t m_width = 0;
+		uint32_t m_height = 0;
+		uint64_t m_frame = 0;
+
+		PickingStatistics m_statistics;
+	};
+}
+
+#endif // !PICKING_H
@@ -0,0 +1,83 @@
+#ifndef READBACK_H
+#define READBACK_H
+
+#include <stdint.h>
+#include <vector>
+#include "buffer.h"
+#include "fence.h"
+#include "frame_buffer.h"
+
+namespace Fractal {
+	constexpr uint32_t INVALID_READBACK_SLOT = 0xFFFFFFFF;
+
+	enum class ReadbackFormat {
+		RGBA8,
+		R32UI,
+		Depth32F
+	};
+
+	enum class ReadbackStatus {
+		Invalid,
+		Pending,
+		Ready
+	};
+
+	struct ReadbackTicket {
+		uint32_t slot = INVALID_READBACK_SLOT;
+		uint32_t generation = 0;
+
+		inline bool valid() const { return slot != INVALID_READBACK_SLOT; }
+	};
+
+	struct ReadbackResult {
+		const void* data = nullptr;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t stride = 0;
+		ReadbackFormat format = ReadbackFormat::RGBA8;
+	};
+
+	struct ReadbackStatistics {
+		uint32_t requested = 0;
+		uint32_t completed = 0;
+		uint32_t rejected = 0;
+	};
+
+	uint32_t get_readback_pixel_size(ReadbackFormat format);
+
+	class AsyncReadback {
+	public:
+		AsyncReadback(uint32_t slot_count = 3);
+		virtual ~AsyncReadback();
+
+		ReadbackTicket request(FrameBuffer* frame_buffer, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+			ReadbackFormat format = ReadbackFormat::RGBA8, uint32_t attachment = 0);
+		ReadbackStatus poll(const ReadbackTicket& ticket);
+		ReadbackStatus wait(const ReadbackTicket& ticket, uint64_t timeout_ns);
+		bool map(const ReadbackTicket& ticket, ReadbackResult& result);
+		void release(ReadbackTicket& ticket);
+
+		inline const ReadbackStatistics& get_statistics() const { return m_statistics; }
+	private:
+		enum class SlotState {
+			Free, Pending, Ready, Mapped
+		};
+
+		struct Slot {
+			PixelPackBuffer* buffer = nullptr;
+			Fence fence;
+			SlotState state = SlotState::Free;
+			uint32_t generation = 0;
+			uint32_t width = 0, height = 0;
+			ReadbackFormat format = ReadbackFormat::RGBA8;
+			const void* mapped = nullptr;
+		};
+
+		Slot* find_slot(const ReadbackTicket& ticket);
+
+		std::vector<Slot> m_slots;
+		ReadbackStatistics m_statistics;
+	};
+}
+
+#endif // !READBACK_H
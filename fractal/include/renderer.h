@@ -2,10 +2,14 @@
 #define OPEN_RENDERER_H
 
 #include "shader.h"
+#include "gpu_resources.h"
 #include "vertex_array.h"
 #include "texture.h"
 #include "camera.h"
 #include "mesh.h"
+#include "mesh_lod.h"
+#include "occlusion_culling.h"
+#include "bvh.h"
 
 namespace Fractal {
 	constexpr uint32_t MAX_TEXTURE_SLOTS = 32;
@@ -35,8 +39,11 @@ namespace Fractal {
 		{ -1.0,  1.0, -1.0, 1.0 }
 	};
 
+	constexpr size_t QUAD_INDICES_COUNT = 6;
+	constexpr uint32_t quad_indices[] = { 0, 1, 2, 2, 3, 0 };
+
 	constexpr size_t CUBE_INDICES_COUNT = 36;
-	constexpr int cube_indices[] = {
+	constexpr uint32_t cube_indices[] = {
 		// front
 		0, 1, 2,
 		2, 3, 0,
@@ -64,7 +71,12 @@ namespace Fractal {
 		uint32_t max_vertex_count = 0;
 		uint32_t max_index_count = 0;
 
+		//Per frame, these survive the flushes that reset the counts above.
+		uint32_t lod_objects[MAX_LOD_LEVELS] = { 0 };
+		uint32_t lod_triangles[MAX_LOD_LEVELS] = { 0 };
+
 		void reset();
+		void reset_lod();
 	};
 
 	struct DrawElementsCommand {
@@ -89,14 +101,16 @@ namespace Fractal {
 		virtual bool submit(Mesh& mesh) = 0;
 		virtual void render() = 0;
 
-		inline void set_shader(Shader** shader) { m_shader = shader; }
+		inline void set_shader(Handle<Shader> shader) { m_shader = shader; }
 		inline bool empty() const { return (m_vert_base == m_vert_ptr); }
 		inline const DeviceStatistics get_device_stats() const { return m_ds; }
 
+		inline void record_lod(uint32_t level, uint32_t triangles) { m_ds.lod_objects[level]++; m_ds.lod_triangles[level] += triangles; }
+		inline void reset_lod_statistics() { m_ds.reset_lod(); }
+
 		inline uint32_t* index_ptr() { return m_indx_ptr; }
 	protected:
-		//Pointer to another shader that is also a pointer :)
-		Shader** m_shader = nullptr;
+		Handle<Shader> m_shader;
 
 		VertexArray* m_vao = nullptr;
 		VertexBuffer* m_vbo = nullptr;
@@ -122,13 +136,35 @@ namespace Fractal {
 		virtual bool submit(Mesh& mesh) override;
 		virtual void render() override;
 
+		//Offsets every index by base_vertex so meshes with local indices can share the batch.
+		bool submit(const Mesh& mesh, uint32_t base_vertex);
+		bool submit(const Vertex* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count, uint32_t base_vertex);
+
 		virtual void next_command();
 		virtual void make_command();
 
 		inline uint32_t index_offset() const { return m_index_offset; }
 		float calculate_texture_index(uint32_t id);
+
+		//The pre-pass draws the uploaded batch with this shader and no color before the main pass.
+		inline void set_depth_shader(Handle<Shader> shader) { m_depth_shader = shader; }
+		inline void set_depth_prepass(bool enabled) { m_depth_prepass = enabled; }
+		inline bool is_depth_prepass() const { return m_depth_prepass; }
+
+		//Every submit becomes its own draw command with bounds so the culler can drop it.
+		inline void set_occlusion_culler(OcclusionCuller* culler) { m_culler = culler; }
+		inline void set_occlusion_culling(bool enabled) { m_occlusion_culling = enabled; }
+		inline bool is_occlusion_culling() const { return m_occlusion_culling; }
+	private:
+		void draw(Shader* shader, Shader* depth_shader);
 	private:
 		IndirectDrawBuffer* m_idb = nullptr;
+		Handle<Shader> m_depth_shader;
+		bool m_depth_prepass = false;
+
+		OcclusionCuller* m_culler = nullptr;
+		bool m_occlusion_culling = false;
+		OcclusionBounds m_command_bounds[MAX_DRAW_COMMANDS];
 
 		uint32_t m_texture_slot_index = 0;
 		uint32_t m_textures[MAX_TEXTURE_SLOTS] = { 0 };
@@ -139,7 +175,7 @@ namespace Fractal {
 		uint32_t m_current_draw_command_vertex_size = 0;
 		DrawElementsCommand m_commands[MAX_DRAW_COMMANDS];
 
-		void add_vertex(Vertex* v);
+		void add_vertex(const Vertex* v);
 		void add_index(uint32_t index);
 	};
 
@@ -156,18 +192,21 @@ namespace Fractal {
 		virtual void begin_scene(Camera* camera) = 0;
 		virtual void end_scene() = 0;
 		virtual void submit(Mesh& mesh) = 0;
+		//Indices are relative to the given vertices, nothing is copied until the batch.
+		virtual void submit(const Vertex* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count) = 0;
 
 		inline int get_flags() const { return m_flags; }
 		inline void set_flag(int flag, bool v) { if (v) m_flags |= flag; else m_flags &= ~flag; }
-		inline void set_shader(Shader* shader) { m_current_shader = shader; }
-		inline Shader* get_current_shader() { return m_current_shader; }
+		inline void set_shader(Shader* shader) { m_current_shader = shader ? shader->get_handle() : Handle<Shader>(); }
+		//Falls back to the default shader once the set shader has been destroyed.
+		inline Shader* get_current_shader() { Shader* shader = resolve(m_current_shader); return shader ? shader : &m_default_shader; }
 
 		inline BatchGraphicsDevice* get_graphics_device() { return m_gd; }
 	protected:
 		Camera* m_camera = nullptr;
 		glm::mat4 m_proj_view = glm::mat4(1.0f);
 		Shader m_default_shader;
-		Shader* m_current_shader = nullptr;
+		Handle<Shader> m_current_shader;
 		int m_flags = RenderFlags::None;
 		BatchGraphicsDevice* m_gd;
 	};
@@ -179,10 +218,27 @@ namespace Fractal {
 		virtual void begin_scene(Camera* camera) override;
 		virtual void end_scene() override;
 		virtual void submit(Mesh& mesh) override;
+		virtual void submit(const Vertex* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count) override;
+		void submit(LodMesh& mesh);
 
 		void init_renderer_shader(Shader* shader);
+
+		//Lays down depth for the whole batch first so the main pass only shades visible fragments.
+		//Every batched triangle is treated as opaque, translucent scenes should leave it off.
+		inline void set_depth_prepass(bool enabled) { m_gd->set_depth_prepass(enabled); }
+		inline bool is_depth_prepass() const { return m_gd->is_depth_prepass(); }
+
+		//Tests every submit against a depth pyramid of the bound frame buffer's depth attachment.
+		inline void set_occlusion_culling(bool enabled) { m_gd->set_occlusion_culling(enabled); }
+		inline bool is_occlusion_culling() const { return m_gd->is_occlusion_culling(); }
+		inline const OcclusionStatistics& get_occlusion_statistics() const { return m_culler.get_statistics(); }
+
+		//Appends the objects of the scene index inside the camera of the current scene.
+		void cull(const Bvh& bvh, std::vector<uint32_t>& visible) const;
 	private:
 		ShaderStorageBuffer* m_ssbo;
+		Shader m_depth_shader;
+		OcclusionCuller m_culler;
 	};
 }
 
@@ -23,6 +23,9 @@ namespace Fractal {
 		static void draw_multi_indirect(const void* indirect, uint32_t count, uint32_t stride);
 		static void polygon_mode(uint32_t face, uint32_t mode);
 		static void line_width(float width);
+		static void depth_func(uint32_t func);
+		static void depth_mask(bool write);
+		static void color_mask(bool write);
 	private:
 		static int decode_type();
     };
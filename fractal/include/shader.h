@@ -3,8 +3,10 @@
 
 #include <string>
 #include <memory>
+#include <sstream>
 #include <glm/glm.hpp>
 #include <unordered_map>
+#include "handle_pool.h"
 
 namespace Fractal {
 	using ShaderSources = std::unordered_map<uint32_t, std::stringstream>;
@@ -12,7 +14,7 @@ namespace Fractal {
 	class Shader {
 	public:
 		Shader(const std::string& file_path);
-		Shader() = default;
+		Shader();
 
 		virtual ~Shader();
 
@@ -20,9 +22,11 @@ namespace Fractal {
 		void unbind();
 
 		void init(const std::string& file_path);
+		void init_from_source(const std::string& name, const std::string& source);
 
 		/* Uniforms go here! */
 		void set1f(const std::string& name, float value);
+		void set1i(const std::string& name, int value);
 		void set_mat4f(const std::string& name, const glm::mat4& mat4);
 		void set_vec3f(const std::string& name, const glm::vec3& vec3);
 		void set_vec2f(const std::string& name, const glm::vec2& vec2);
@@ -30,9 +34,12 @@ namespace Fractal {
 
 		uint32_t get_uniform_location(const std::string& name);
 		uint32_t get_id() const { return m_shader_id; }
+		Handle<Shader> get_handle() const { return m_handle; }
 	private:
-		uint32_t m_shader_id;
-		ShaderSources parse_shader(const std::string& file_path);
+		uint32_t m_shader_id = 0;
+		Handle<Shader> m_handle;
+
+		ShaderSources parse_shader(std::istream& stream);
 		uint32_t compile_shader(const std::string& source, uint32_t type);
 		uint32_t create_shader(const ShaderSources& shader_sources);
 	};
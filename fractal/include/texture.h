@@ -3,14 +3,46 @@
 
 #include <memory>
 #include <string>
+#include "texture_compression.h"
+#include "handle_pool.h"
 
 namespace Fractal {
+	enum class TextureFilter {
+		Nearest,
+		Linear
+	};
+
+	enum class TextureWrap {
+		Repeat,
+		MirroredRepeat,
+		ClampToEdge,
+		ClampToBorder
+	};
+
+	struct TextureSpecification {
+		TextureFilter min_filter = TextureFilter::Linear;
+		TextureFilter mag_filter = TextureFilter::Nearest;
+		TextureFilter mip_filter = TextureFilter::Linear;
+		TextureWrap wrap_s = TextureWrap::Repeat;
+		TextureWrap wrap_t = TextureWrap::Repeat;
+		bool generate_mips = true;
+		float anisotropy = 8.0f;
+		uint32_t max_mip_levels = 0;
+		bool compress = false;
+	};
+
+	bool get_texture_format(int channels, uint32_t& internal_format, uint32_t& data_format);
+	uint32_t get_storage_level_count(const TextureImage& image, const TextureSpecification& specification);
+	void apply_texture_specification(uint32_t texture_id, const TextureSpecification& specification, uint32_t mip_levels);
+	bool load_texture_image(const std::string& path, const TextureSpecification& specification, TextureImage& image);
+
 	class Texture {
 	public:
-		Texture() = default;
+		Texture();
 
-		void initialize(const char* file_path);
-		void initialize(uint32_t width, uint32_t height);
+		void initialize(const char* file_path, const TextureSpecification& specification = TextureSpecification());
+		void initialize(uint32_t width, uint32_t height, const TextureSpecification& specification = TextureSpecification());
+		void initialize(const TextureImage& image, const TextureSpecification& specification = TextureSpecification());
 
 		virtual ~Texture();
 
@@ -20,18 +52,33 @@ namespace Fractal {
 		void set_data(void* data);
 		void* get_data() { return m_data; }
 
+		void set_specification(const TextureSpecification& specification);
+		const TextureSpecification& get_specification() const { return m_specification; }
+
 		uint32_t get_width() const { return m_width; }
 		uint32_t get_height() const { return m_height; }
 		uint32_t get_texture_id() const { return m_texture_id; }
+		Handle<Texture> get_handle() const { return m_handle; }
+		uint32_t get_mip_levels() const { return m_mip_levels; }
+		uint64_t get_memory_size() const;
+		bool is_compressed() const { return m_compressed; }
+		bool is_placeholder() const { return m_placeholder; }
 	private:
+		friend class TextureLoader;
+
+		Handle<Texture> m_handle;
 		uint32_t m_texture_id = 0;
+		bool m_placeholder = false;
 
 		uint32_t m_width = 0;
 		uint32_t m_height = 0;
+		uint32_t m_mip_levels = 1;
+		bool m_compressed = false;
 		uint32_t m_internal_format = 0, m_data_format = 0;
+		TextureSpecification m_specification;
 		std::string m_path;
 		void* m_data = nullptr;
 	};
 }
 
-#endif // !OPENGL_TEXTURE_H
\ No newline at end of file
+#endif // !OPENGL_TEXTURE_H
@@ -0,0 +1,94 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include "texture.h"
+
+namespace Fractal {
+	struct SubTexture {
+		uint32_t texture_id = 0;
+		uint32_t page = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		glm::vec2 uv_min = { 0, 0 };
+		glm::vec2 uv_max = { 0, 0 };
+		glm::vec2 tex_coords[4];
+	};
+
+	struct TextureAtlasSettings {
+		uint32_t page_width = 2048;
+		uint32_t page_height = 2048;
+		uint32_t padding = 4;
+		uint32_t max_pages = 8;
+		TextureSpecification specification;
+	};
+
+	class SkylinePacker {
+	public:
+		SkylinePacker(uint32_t width, uint32_t height);
+
+		bool pack(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y);
+		float get_occupancy() const;
+	private:
+		struct Node {
+			uint32_t x;
+			uint32_t y;
+			uint32_t width;
+		};
+
+		bool fits(uint32_t index, uint32_t width, uint32_t height, uint32_t& y) const;
+	private:
+		uint32_t m_width;
+		uint32_t m_height;
+		uint64_t m_used_area = 0;
+		std::vector<Node> m_skyline;
+	};
+
+	class TextureAtlas {
+	public:
+		TextureAtlas(const TextureAtlasSettings& settings = TextureAtlasSettings());
+		virtual ~TextureAtlas();
+
+		//Queues an image, its SubTexture can be looked up with get() once build() has placed it.
+		bool add(const std::string& path);
+		bool add(const std::string& name, const uint8_t* rgba, uint32_t width, uint32_t height);
+		void build();
+
+		const SubTexture* get(const std::string& name) const;
+		inline uint32_t get_page_count() const { return (uint32_t)m_pages.size(); }
+		inline Texture* get_page(uint32_t page) { return m_pages[page].texture; }
+		float get_occupancy(uint32_t page) const;
+	private:
+		struct Page {
+			Texture* texture;
+			SkylinePacker packer;
+			std::vector<uint8_t> pixels;
+			bool dirty;
+		};
+
+		struct PendingImage {
+			std::string name;
+			std::vector<uint8_t> pixels;
+			uint32_t width;
+			uint32_t height;
+		};
+
+		bool is_known(const std::string& name) const;
+		bool place(const PendingImage& image);
+		void blit(Page& page, const PendingImage& image, uint32_t x, uint32_t y);
+	private:
+		TextureAtlasSettings m_settings;
+		uint32_t m_gutter = 0;
+		uint32_t m_alignment = 1;
+
+		std::vector<Page> m_pages;
+		std::vector<PendingImage> m_pending;
+		std::unordered_map<std::string, SubTexture> m_sub_textures;
+	};
+}
+
+#endif // !TEXTURE_ATLAS_H
@@ -0,0 +1,61 @@
+#ifndef TEXTURE_COMPRESSION_H
+#define TEXTURE_COMPRESSION_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#define FRACTAL_COMPRESSED_RGB_S3TC_DXT1 0x83F0
+#define FRACTAL_COMPRESSED_RGBA_S3TC_DXT1 0x83F1
+#define FRACTAL_COMPRESSED_RGBA_S3TC_DXT3 0x83F2
+#define FRACTAL_COMPRESSED_RGBA_S3TC_DXT5 0x83F3
+
+namespace Fractal {
+	enum class BlockFormat {
+		BC1,
+		BC2,
+		BC3
+	};
+
+	struct TextureLevel {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t offset = 0;
+		uint32_t size = 0;
+	};
+
+	struct TextureImage {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t internal_format = 0;
+		uint32_t data_format = 0;
+		uint32_t data_type = 0;
+		uint32_t row_alignment = 4;
+		bool compressed = false;
+		std::vector<TextureLevel> levels;
+		std::vector<uint8_t> data;
+		const uint8_t* external_data = nullptr;
+
+		inline const uint8_t* get_data() const { return external_data ? external_data : data.data(); }
+	};
+
+	uint32_t get_mip_level_count(uint32_t width, uint32_t height);
+	uint32_t get_block_size(BlockFormat format);
+	uint32_t get_block_gl_format(BlockFormat format);
+	bool get_block_format(uint32_t gl_format, BlockFormat& format);
+	uint32_t get_compressed_size(BlockFormat format, uint32_t width, uint32_t height);
+	uint32_t get_row_size(const TextureImage& image, const TextureLevel& level);
+	uint32_t get_row_count(const TextureImage& image, const TextureLevel& level);
+
+	void downsample_rgba(const uint8_t* source, uint32_t width, uint32_t height, uint8_t* destination);
+	void compress_bc1(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* destination);
+	void compress_bc3(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* destination);
+	void build_mip_chain(const uint8_t* rgba, uint32_t width, uint32_t height, TextureImage& image);
+	bool compress_image(const uint8_t* rgba, uint32_t width, uint32_t height, bool has_alpha, bool generate_mips, TextureImage& image);
+
+	bool load_dds(const std::string& path, TextureImage& image);
+	bool load_ktx(const std::string& path, TextureImage& image);
+	void flip_image(TextureImage& image);
+}
+
+#endif // !TEXTURE_COMPRESSION_H
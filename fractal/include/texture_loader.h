@@ -0,0 +1,89 @@
+#ifndef TEXTURE_LOADER_H
+#define TEXTURE_LOADER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include "texture.h"
+#include "buffer.h"
+#include "fence.h"
+#include "thread_pool.h"
+
+namespace Fractal {
+	constexpr uint32_t TEXTURE_STAGING_BUFFER_COUNT = 3;
+	constexpr uint32_t TEXTURE_STAGING_BUFFER_SIZE = 4 * 1024 * 1024;
+
+	struct TextureLoadStatistics {
+		std::string path;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		float decode_ms = 0.0f;
+		float upload_ms = 0.0f;
+		bool failed = false;
+	};
+
+	struct TextureLoadProgress {
+		uint32_t requested = 0;
+		uint32_t decoded = 0;
+		uint32_t completed = 0;
+		uint32_t failed = 0;
+
+		inline float fraction() const { return requested ? (float)(completed + failed) / (float)requested : 1.0f; }
+	};
+
+	class TextureLoader {
+	public:
+		TextureLoader(uint32_t worker_count = 0);
+		virtual ~TextureLoader();
+
+		std::shared_ptr<Texture> load(const std::string& path, const TextureSpecification& specification = TextureSpecification());
+		void update(float budget_ms);
+
+		bool is_idle() const;
+		TextureLoadProgress get_progress() const;
+		inline const std::vector<TextureLoadStatistics>& get_statistics() const { return m_statistics; }
+		inline uint32_t get_placeholder_id() const { return m_placeholder_id; }
+	private:
+		struct Request {
+			std::weak_ptr<Texture> texture;
+			std::string path;
+			TextureSpecification specification;
+			TextureImage image;
+			bool loaded = false;
+			uint32_t texture_id = 0;
+			uint32_t mip_levels = 0;
+			uint32_t level = 0;
+			uint32_t rows_uploaded = 0;
+			float decode_ms = 0.0f;
+			float upload_ms = 0.0f;
+		};
+
+		struct StagingBuffer {
+			PixelUnpackBuffer* buffer = nullptr;
+			Fence fence;
+		};
+
+		void decode(Request* request);
+		bool upload_slice(Request* request);
+		void finish(Request* request, bool failed);
+		StagingBuffer* acquire_staging_buffer(uint32_t size);
+	private:
+		ThreadPool* m_workers = nullptr;
+		uint32_t m_placeholder_id = 0;
+
+		mutable std::mutex m_mutex;
+		std::deque<Request*> m_decoded;
+		Request* m_uploading = nullptr;
+
+		StagingBuffer m_staging[TEXTURE_STAGING_BUFFER_COUNT];
+		uint32_t m_staging_index = 0;
+
+		TextureLoadProgress m_progress;
+		std::vector<TextureLoadStatistics> m_statistics;
+	};
+}
+
+#endif // !TEXTURE_LOADER_H
@@ -0,0 +1,36 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdint.h>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace Fractal {
+	class ThreadPool {
+	public:
+		ThreadPool(uint32_t thread_count = 0);
+		virtual ~ThreadPool();
+
+		void submit(const std::function<void()>& task);
+		void wait_idle();
+
+		uint32_t get_thread_count() const { return (uint32_t)m_threads.size(); }
+		uint32_t get_pending() const;
+	private:
+		void worker_loop();
+
+		std::vector<std::thread> m_threads;
+		std::deque<std::function<void()>> m_tasks;
+		mutable std::mutex m_mutex;
+		std::condition_variable m_task_condition;
+		std::condition_variable m_idle_condition;
+		uint32_t m_active = 0;
+		bool m_stop = false;
+	};
+}
+
+#endif // !THREAD_POOL_H
@@ -14,6 +14,7 @@ namespace Fractal {
 
     void set_icon(const char* path);
     std::string get_name_of_path(const std::string& path);
+    std::string get_canonical_path(const std::string& path);
 } // namespace Fractal
 
 #endif //!UTILITY_H
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define OPENGL_VERTEX_ARRAY_H
 
 #include "buffer.h"
+#include "handle_pool.h"
 
 namespace Fractal {
 	enum class VertexBufferFormat {
@@ -27,7 +28,9 @@ namespace Fractal {
 		void set_array_for_instancing(std::shared_ptr<VertexBuffer>& vertex_buf, uint32_t offset_sizes[], uint32_t stride_sizes[]);
 
 		uint32_t get_id() const { return m_vertex_array_buffer_id; }
+		Handle<VertexArray> get_handle() const { return m_handle; }
 	private:
+		Handle<VertexArray> m_handle;
 		uint32_t m_vertex_array_buffer_id;
 
 		std::vector<std::shared_ptr<VertexBuffer>> m_vertex_buffers;
@@ -0,0 +1,90 @@
+#ifndef VIDEO_CAPTURE_H
+#define VIDEO_CAPTURE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include "readback.h"
+#include "thread_pool.h"
+
+namespace Fractal {
+	enum class CaptureFormat {
+		Y4M,
+		PNGSequence
+	};
+
+	struct CaptureSettings {
+		std::string path = "capture";
+		CaptureFormat format = CaptureFormat::Y4M;
+		uint32_t width = 1280;
+		uint32_t height = 720;
+		uint32_t fps = 60;
+		uint32_t worker_count = 0;
+		uint32_t max_queued_frames = 8;
+	};
+
+	struct CaptureStatistics {
+		uint64_t frames_captured = 0;
+		uint64_t frames_written = 0;
+		uint64_t bytes_written = 0;
+		uint64_t frames_lost = 0;
+		uint64_t write_failures = 0;
+		float elapsed = 0.0f;
+		float frames_per_second = 0.0f;
+		float megabytes_per_second = 0.0f;
+	};
+
+	class VideoCapture {
+	public:
+		VideoCapture() = default;
+		virtual ~VideoCapture();
+
+		bool start(const CaptureSettings& settings);
+		void capture(FrameBuffer* frame_buffer);
+		void stop();
+
+		inline bool is_recording() const { return m_recording; }
+		inline const CaptureSettings& get_settings() const { return m_settings; }
+		CaptureStatistics get_statistics() const;
+	private:
+		struct PendingFrame {
+			ReadbackTicket ticket;
+			uint64_t index;
+		};
+
+		void collect(bool wait_for_oldest);
+		void queue_frame(const ReadbackResult& result, uint64_t index);
+		void encode_y4m(std::vector<uint8_t>* pixels, uint64_t index);
+		void encode_png(std::vector<uint8_t>* pixels, uint64_t index);
+		void recycle(std::vector<uint8_t>* pixels);
+	private:
+		CaptureSettings m_settings;
+		AsyncReadback* m_readback = nullptr;
+		ThreadPool* m_workers = nullptr;
+		FILE* m_file = nullptr;
+		bool m_recording = false;
+
+		std::deque<PendingFrame> m_pending;
+		uint64_t m_next_capture = 0;
+
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::vector<std::vector<uint8_t>*> m_free_frames;
+		uint32_t m_queued = 0;
+		uint64_t m_next_write = 0;
+
+		std::atomic<uint64_t> m_frames_written{ 0 };
+		std::atomic<uint64_t> m_bytes_written{ 0 };
+		std::atomic<uint32_t> m_write_failures{ 0 };
+		uint32_t m_lost_frames = 0;
+		float m_start_time = 0.0f;
+		float m_stop_time = 0.0f;
+	};
+}
+
+#endif // !VIDEO_CAPTURE_H
@@ -3,6 +3,7 @@
 
 #include "fractal.h"
 #include "event.h"
+#include "frame_pacer.h"
 
 namespace Fractal {
     enum WindowFlags {
@@ -31,7 +32,13 @@ namespace Fractal {
         virtual ~Window() = default;
 
         virtual void* get_native_window() = 0;
+        //Swaps then polls, split in two when input should be sampled later than the present.
         virtual void update() = 0;
+        virtual void swap_buffers() = 0;
+        virtual void poll_events() = 0;
+        //Returns the mode that was applied, adaptive falls back to on when the driver lacks it.
+        virtual VsyncMode set_vsync(VsyncMode mode) = 0;
+        virtual float get_refresh_rate() = 0;
         virtual void destroy() = 0;
         virtual void quit() = 0;
         
@@ -0,0 +1,280 @@
+/**
+ * @file allocation_tracker.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the global allocation hooks that count allocations
+ * per frame and per subsystem.
+ */
+
+#include "allocation_tracker.h"
+#include "log.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <algorithm>
+
+#if defined(FRACTAL_TRACK_ALLOCATIONS) && defined(_MSC_VER) && defined(_DEBUG)
+#include <crtdbg.h>
+#define FRACTAL_TRACK_MALLOC
+#endif
+
+namespace Fractal {
+	constexpr size_t ALLOCATION_TAG_COUNT = (size_t)AllocationTag::Count;
+
+	static const char* ALLOCATION_TAG_NAMES[ALLOCATION_TAG_COUNT] = {
+		"Unknown",
+		"Renderer",
+		"Geometry",
+		"Log",
+		"File",
+		"ImGui",
+		"App"
+	};
+
+	struct AtomicAllocationCounters {
+		std::atomic<uint64_t> allocations;
+		std::atomic<uint64_t> bytes;
+		std::atomic<uint64_t> frees;
+		std::atomic<uint64_t> freed_bytes;
+	};
+
+	//Zero initialized before any constructor runs, so allocations made during static initialization are safe to count.
+	static AtomicAllocationCounters counters[ALLOCATION_TAG_COUNT];
+	static std::atomic<uint64_t> violations;
+
+	static thread_local AllocationTag current_tag = AllocationTag::Unknown;
+	static thread_local uint32_t no_allocation_depth = 0;
+	//Set while the tracker itself allocates so nothing is counted twice or reported recursively.
+	static thread_local bool inside_tracker = false;
+
+	static AllocationFrame history[ALLOCATION_HISTORY_SIZE];
+	static uint32_t history_count = 0;
+	static uint32_t history_next = 0;
+	static AllocationFrame last_frame;
+	static uint64_t frame_index = 0;
+
+	AllocationCounters AllocationFrame::get_total() const {
+		AllocationCounters total;
+		for (const AllocationCounters& c : counters) {
+			total.allocations += c.allocations;
+			total.bytes += c.bytes;
+			total.frees += c.frees;
+			total.freed_bytes += c.freed_bytes;
+		}
+		return total;
+	}
+
+	AllocationScope::AllocationScope(AllocationTag tag) : m_previous(current_tag) {
+		current_tag = tag;
+	}
+
+	AllocationScope::~AllocationScope() {
+		current_tag = m_previous;
+	}
+
+	NoAllocationScope::NoAllocationScope() {
+		no_allocation_depth++;
+	}
+
+	NoAllocationScope::~NoAllocationScope() {
+		no_allocation_depth--;
+	}
+
+	bool is_allocation_tracking_enabled() {
+#ifdef FRACTAL_TRACK_ALLOCATIONS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	const char* get_allocation_tag_name(AllocationTag tag) {
+		return ((size_t)tag < ALLOCATION_TAG_COUNT) ? ALLOCATION_TAG_NAMES[(size_t)tag] : "Invalid";
+	}
+
+	void end_allocation_frame() {
+		AllocationFrame frame;
+		frame.frame = frame_index++;
+		for (size_t i = 0; i < ALLOCATION_TAG_COUNT; i++) {
+			frame.counters[i].allocations = counters[i].allocations.exchange(0, std::memory_order_relaxed);
+			frame.counters[i].bytes = counters[i].bytes.exchange(0, std::memory_order_relaxed);
+			frame.counters[i].frees = counters[i].frees.exchange(0, std::memory_order_relaxed);
+			frame.counters[i].freed_bytes = counters[i].freed_bytes.exchange(0, std::memory_order_relaxed);
+		}
+		frame.violations = violations.exchange(0, std::memory_order_relaxed);
+
+		last_frame = frame;
+		history[history_next] = frame;
+		history_next = (history_next + 1) % ALLOCATION_HISTORY_SIZE;
+		history_count = std::min(history_count + 1, ALLOCATION_HISTORY_SIZE);
+	}
+
+	const AllocationFrame& get_allocation_frame() {
+		return last_frame;
+	}
+
+	uint32_t get_allocation_history(AllocationFrame* frames, uint32_t max_frames) {
+		uint32_t count = std::min(history_count, max_frames);
+		uint32_t first = (history_next + ALLOCATION_HISTORY_SIZE - count) % ALLOCATION_HISTORY_SIZE;
+		for (uint32_t i = 0; i < count; i++)
+			frames[i] = history[(first + i) % ALLOCATION_HISTORY_SIZE];
+		return count;
+	}
+
+	bool write_allocation_csv(const std::string& path) {
+		std::ofstream file(path);
+		if (!file.is_open()) {
+			FRACTAL_LOG_ERROR("Could not write allocation statistics to '%s'", path.c_str());
+			return false;
+		}
+
+		file << "frame,subsystem,allocations,bytes,frees,freed_bytes,violations\n";
+		uint32_t first = (history_next + ALLOCATION_HISTORY_SIZE - history_count) % ALLOCATION_HISTORY_SIZE;
+		for (uint32_t i = 0; i < history_count; i++) {
+			const AllocationFrame& frame = history[(first + i) % ALLOCATION_HISTORY_SIZE];
+			for (size_t tag = 0; tag < ALLOCATION_TAG_COUNT; tag++) {
+				const AllocationCounters& c = frame.counters[tag];
+				file << frame.frame << "," << ALLOCATION_TAG_NAMES[tag] << "," << c.allocations << "," << c.bytes << "," << c.frees << "," << c.freed_bytes << ",\n";
+			}
+			AllocationCounters total = frame.get_total();
+			file << frame.frame << ",Total," << total.allocations << "," << total.bytes << "," << total.frees << "," << total.freed_bytes << "," << frame.violations << "\n";
+		}
+
+		FRACTAL_LOG("Wrote %d frames of allocation statistics to '%s'", history_count, path.c_str());
+		return true;
+	}
+
+#ifdef FRACTAL_TRACK_ALLOCATIONS
+	//Every tracked block starts with this so frees know their size and subsystem.
+	struct AllocationHeader {
+		uint64_t size;
+		uint64_t tag;
+	};
+	static_assert(sizeof(AllocationHeader) == 16, "Allocation header must keep blocks 16 byte aligned");
+
+	static void record_allocation(AllocationTag tag, size_t size) {
+		counters[(size_t)tag].allocations.fetch_add(1, std::memory_order_relaxed);
+		counters[(size_t)tag].bytes.fetch_add(size, std::memory_order_relaxed);
+
+		if (no_allocation_depth > 0 && !inside_tracker) {
+			violations.fetch_add(1, std::memory_order_relaxed);
+			inside_tracker = true;
+			FRACTAL_LOG_ERROR("Allocated %llu bytes inside a no allocation scope", (unsigned long long)size);
+			inside_tracker = false;
+			assert(!"Allocation inside a no allocation scope");
+		}
+	}
+
+	static void record_free(AllocationTag tag, size_t size) {
+		counters[(size_t)tag].frees.fetch_add(1, std::memory_order_relaxed);
+		counters[(size_t)tag].freed_bytes.fetch_add(size, std::memory_order_relaxed);
+	}
+
+	static void* tracked_allocate(size_t size) {
+		bool inside = inside_tracker;
+		inside_tracker = true;
+		AllocationHeader* header = (AllocationHeader*)malloc(sizeof(AllocationHeader) + std::max(size, (size_t)1));
+		inside_tracker = inside;
+		if (!header)
+			return nullptr;
+
+		header->size = size;
+		header->tag = (uint64_t)current_tag;
+		record_allocation(current_tag, size);
+		return header + 1;
+	}
+
+	static void tracked_free(void* pointer) {
+		if (!pointer)
+			return;
+
+		AllocationHeader* header = (AllocationHeader*)pointer - 1;
+		record_free((AllocationTag)header->tag, (size_t)header->size);
+
+		bool inside = inside_tracker;
+		inside_tracker = true;
+		free(header);
+		inside_tracker = inside;
+	}
+
+#ifdef FRACTAL_TRACK_MALLOC
+	//The debug CRT is the only place malloc can be hooked, frees do not report a size there.
+	static _CRT_ALLOC_HOOK previous_crt_hook = nullptr;
+
+	static int crt_allocation_hook(int type, void* data, size_t size, int block_type, long request, const unsigned char* filename, int line) {
+		if (block_type != _CRT_BLOCK && !inside_tracker) {
+			if (type == _HOOK_ALLOC || type == _HOOK_REALLOC)
+				record_allocation(current_tag, size);
+			else if (type == _HOOK_FREE)
+				record_free(current_tag, 0);
+		}
+
+		//Hooks installed before the tracker still see every request and can still veto it.
+		return previous_crt_hook ? previous_crt_hook(type, data, size, block_type, request, filename, line) : TRUE;
+	}
+
+	static bool crt_hook_installed = (previous_crt_hook = _CrtSetAllocHook(crt_allocation_hook), true);
+#endif
+#endif
+}
+
+#ifdef FRACTAL_TRACK_ALLOCATIONS
+void* operator new(size_t size) {
+	void* pointer = Fractal::tracked_allocate(size);
+	if (!pointer)
+		throw std::bad_alloc();
+	return pointer;
+}
+
+void* operator new[](size_t size) {
+	void* pointer = Fractal::tracked_allocate(size);
+	if (!pointer)
+		throw std::bad_alloc();
+	return pointer;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	return Fractal::tracked_allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return Fractal::tracked_allocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+	Fractal::tracked_free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+	Fractal::tracked_free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+	Fractal::tracked_free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+	Fractal::tracked_free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+	Fractal::tracked_free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+	Fractal::tracked_free(pointer);
+}
+#endif
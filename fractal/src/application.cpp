@@ -20,23 +20,51 @@
 #include "log.h"
 #include "renderer_commands.h"
 #include "utility.h"
+#include "allocation_tracker.h"
+#include "gpu_resources.h"
+
+#include <algorithm>
+#include <chrono>
 
 namespace Fractal {
     Application* Application::m_instance = nullptr;
 
     Application::~Application() {    
+        end_offline_render();
         m_layers.destroy();   
+        delete m_job_system;
         m_window->quit();
         delete m_window;
+
+        if (m_asset_pack) {
+            unmount_asset_pack(m_asset_pack);
+            delete m_asset_pack;
+        }
         FRACTAL_LOG("Destroying Application"); 
     }
 
-    void Application::initialize(const char* name, uint32_t width, uint32_t height, int flags) {
+    void Application::initialize(const char* name, uint32_t width, uint32_t height, int flags, const JobSystemSettings& job_settings) {
         m_instance = this;
+        m_job_system = new JobSystem(job_settings);
         m_properties = WindowProperties(name, width, height, flags);
         m_window = Window::create_glfw_window(m_properties, BIND_EVENT(on_event));
+        set_frame_pacing(m_frame_pacer.get_settings());
         FRACTAL_LOG("Initalized application '%s' with size %d by %d", name, width, height);
 
+        //Cooked assets take priority over loose files, release builds only use the pack.
+        m_asset_pack = new AssetPack();
+        if (m_asset_pack->open(FRACTAL_ASSET_PACK_PATH)) {
+            mount_asset_pack(m_asset_pack);
+            FRACTAL_LOG("Mounted asset pack '%s' with %d assets", FRACTAL_ASSET_PACK_PATH, m_asset_pack->get_entry_count());
+        }
+        else {
+#ifdef FRACTAL_COOKED_ASSETS
+            FRACTAL_LOG_ERROR("Could not open asset pack '%s', run the asset cooker first", FRACTAL_ASSET_PACK_PATH);
+#endif
+            delete m_asset_pack;
+            m_asset_pack = nullptr;
+        }
+
         RendererCommands::initialize();
         m_imgui_layer = new ImGuiLayer();
         push_layer(m_imgui_layer);
@@ -49,6 +77,7 @@ namespace Fractal {
     void Application::push_layer(Layer* layer) {
         FRACTAL_LOG("Created new layer '%s'", layer->get_name().c_str());
 		m_layers.push_layer(layer);
+        layer->m_job_system = m_job_system;
         layer->on_attach();
     }
 
@@ -62,8 +91,10 @@ namespace Fractal {
         int interm_fps = 0;
 
         while (m_running) {
+            m_frame_sync.begin_frame();
         	float current_time = Time::get_time(); 
-            m_current_frame_time = current_time - last_frame_time;
+            bool offline = is_offline_rendering();
+            m_current_frame_time = offline ? m_offline_settings.time_step : current_time - last_frame_time;
             last_frame_time = current_time;
 
             interm_fps++;
@@ -73,24 +104,190 @@ namespace Fractal {
                 previous_time = current_time;
             }
 
-            for (Layer* layer : m_layers)
-                layer->on_update(m_current_frame_time);
+            //Jobs queued for the GL context by last frame's workers.
+            m_job_system->execute_main_thread_jobs();
+
+            if (offline)
+                begin_offline_frame();
+
+            {
+                FRACTAL_ALLOCATION_SCOPE(App);
+                for (Layer* layer : m_layers)
+                    layer->on_update(m_current_frame_time);
+
+                if (offline) {
+                    on_update();
+                    end_offline_frame();
+                }
+            }
 
             m_imgui_layer->begin();
 
-			for (Layer* layer : m_layers)
-				layer->update_gui();
-            on_gui();
+            {
+                FRACTAL_ALLOCATION_SCOPE(ImGui);
+                for (Layer* layer : m_layers)
+                    layer->update_gui();
+                on_gui();
+            }
 
             m_imgui_layer->end();
 
-            m_window->update();
-            on_update();
+            m_frame_pacer.end_work();
+            m_window->swap_buffers();
+            m_frame_sync.end_frame();
+            if (!offline) {
+                //Caps the rate, then in low latency mode holds input back until just before the next deadline.
+                m_frame_pacer.end_frame();
+                m_frame_pacer.begin_frame();
+            }
+            m_window->poll_events();
+
+            //Everything that reads input or simulation state runs after the pacing wait, starting with the ticks.
+            if (m_fixed)
+                update_simulation();
+
+            if (!offline) {
+                FRACTAL_ALLOCATION_SCOPE(App);
+                on_update();
+            }
+
+            get_frame_arenas().swap();
+            end_allocation_frame();
+            update_gpu_memory();
+            end_gpu_frame();
+            m_job_system->end_frame();
         }
 
+        m_job_system->wait(m_tick_counter);
+        m_frame_sync.reset();
+        flush_gpu_resources();
 		m_window->destroy();
     }
 
+    void Application::set_frame_pacing(const FramePacerSettings& settings) {
+        FramePacerSettings applied = settings;
+        applied.vsync = m_window->set_vsync(settings.vsync);
+
+        if (applied.low_latency && m_paced_frames_in_flight == 0) {
+            m_paced_frames_in_flight = m_frame_sync.get_frames_in_flight();
+            m_frame_sync.set_frames_in_flight(1);
+        }
+        else if (!applied.low_latency && m_paced_frames_in_flight > 0) {
+            m_frame_sync.set_frames_in_flight(m_paced_frames_in_flight);
+            m_paced_frames_in_flight = 0;
+        }
+
+        m_frame_pacer.set_settings(applied);
+        m_frame_pacer.set_refresh_rate(m_window->get_refresh_rate());
+    }
+
+    void Application::enable_fixed_timestep(const FixedTimestepSettings& settings) {
+        m_job_system->wait(m_tick_counter);
+        m_fixed_timestep.set_settings(settings);
+        if (!m_fixed) {
+            m_fixed_timestep.reset();
+            m_interpolation_alpha = m_pending_alpha = 0.0f;
+        }
+        m_fixed = true;
+        FRACTAL_LOG("Fixed timestep enabled at %f ticks per second", m_fixed_timestep.get_settings().tick_rate);
+    }
+
+    void Application::disable_fixed_timestep() {
+        m_job_system->wait(m_tick_counter);
+        m_fixed = false;
+    }
+
+    void Application::update_simulation() {
+        bool threaded = m_fixed_timestep.get_settings().threaded;
+        if (threaded) {
+            //The last batch has to finish before its state is handed to rendering.
+            m_job_system->wait(m_tick_counter);
+            m_fixed_timestep.set_tick_ms(m_tick_ms);
+            on_simulation_sync();
+            m_interpolation_alpha = m_pending_alpha;
+        }
+
+        uint32_t steps = m_fixed_timestep.advance(m_current_frame_time);
+        float step = m_fixed_timestep.get_step();
+        if (steps == 0) {
+            //Nothing new is launched, so the synced state is also the latest one.
+            m_interpolation_alpha = m_pending_alpha = m_fixed_timestep.get_alpha();
+            return;
+        }
+
+        if (threaded) {
+            //Renders this frame from the state synced above while the next ticks run, the alpha
+            //of this batch is only used once its state is synced.
+            m_pending_alpha = m_fixed_timestep.get_alpha();
+            m_job_system->run([this, steps, step]() { tick(steps, step); }, &m_tick_counter);
+            return;
+        }
+
+        tick(steps, step);
+        m_fixed_timestep.set_tick_ms(m_tick_ms);
+        on_simulation_sync();
+        m_interpolation_alpha = m_pending_alpha = m_fixed_timestep.get_alpha();
+    }
+
+    void Application::tick(uint32_t steps, float step) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < steps; i++) {
+            for (Layer* layer : m_layers)
+                layer->on_fixed_update(step);
+            on_fixed_update(step);
+        }
+        m_tick_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void Application::begin_offline_render(const OfflineRenderSettings& settings) {
+        end_offline_render();
+
+        m_offline_settings = settings;
+        if (m_offline_settings.time_step <= 0.0f)
+            m_offline_settings.time_step = 1.0f / (float)std::max(m_offline_settings.capture.fps, 1u);
+
+        if (!m_video_capture.start(m_offline_settings.capture))
+            return;
+
+        //Presenting must not throttle the capture, the pacer's own setting comes back in end_offline_render.
+        m_window->set_vsync(VsyncMode::Off);
+
+        m_offline_buffer = new FrameBuffer(m_offline_settings.capture.width, m_offline_settings.capture.height);
+        m_offline_frame = 0;
+        FRACTAL_LOG("Offline render started with a time step of %f", m_offline_settings.time_step);
+    }
+
+    void Application::end_offline_render() {
+        if (!is_offline_rendering())
+            return;
+
+        m_video_capture.stop();
+        delete m_offline_buffer;
+        m_offline_buffer = nullptr;
+        m_window->set_vsync(m_frame_pacer.get_settings().vsync);
+
+        RendererCommands::set_viewport(0, 0, m_window->properties()->m_width, m_window->properties()->m_height);
+        FRACTAL_LOG("Offline render finished after %d frames", m_offline_frame);
+    }
+
+    void Application::begin_offline_frame() {
+        m_offline_buffer->bind();
+        RendererCommands::set_viewport(0, 0, m_offline_buffer->get_width(), m_offline_buffer->get_height());
+    }
+
+    void Application::end_offline_frame() {
+        m_offline_buffer->unbind();
+        m_video_capture.capture(m_offline_buffer);
+
+        //Preview the captured frame in the window.
+        RendererCommands::set_viewport(0, 0, m_window->properties()->m_width, m_window->properties()->m_height);
+        m_offline_buffer->blit_to(nullptr, m_window->properties()->m_width, m_window->properties()->m_height);
+
+        m_offline_frame++;
+        if (m_offline_settings.frame_count > 0 && m_offline_frame >= m_offline_settings.frame_count)
+            end_offline_render();
+    }
+
     int const Application::get_fps() {
         return m_fps;
     }
@@ -0,0 +1,272 @@
+/**
+ * @file asset_manager.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the asset manager. Assets are shared by canonical path,
+ * handed out through reference counted handles and evicted least recently
+ * used first when their estimated GPU memory goes over budget.
+ */
+
+#include "asset_manager.h"
+#include "utility.h"
+#include "log.h"
+#include "frame_arena.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+
+namespace Fractal {
+	AssetHandle::AssetHandle(AssetManager* manager, AssetEntry* entry) : m_manager(manager), m_entry(entry) {
+		if (m_entry)
+			m_entry->ref_count++;
+	}
+
+	AssetHandle::AssetHandle(const AssetHandle& other) : AssetHandle(other.m_manager, other.m_entry) { }
+
+	AssetHandle::AssetHandle(AssetHandle&& other) : m_manager(other.m_manager), m_entry(other.m_entry) {
+		other.m_manager = nullptr;
+		other.m_entry = nullptr;
+	}
+
+	AssetHandle& AssetHandle::operator=(const AssetHandle& other) {
+		if (this != &other) {
+			if (other.m_entry)
+				other.m_entry->ref_count++;
+			reset();
+			m_manager = other.m_manager;
+			m_entry = other.m_entry;
+		}
+		return *this;
+	}
+
+	AssetHandle& AssetHandle::operator=(AssetHandle&& other) {
+		if (this != &other) {
+			reset();
+			m_manager = other.m_manager;
+			m_entry = other.m_entry;
+			other.m_manager = nullptr;
+			other.m_entry = nullptr;
+		}
+		return *this;
+	}
+
+	AssetHandle::~AssetHandle() {
+		reset();
+	}
+
+	void AssetHandle::reset() {
+		if (m_entry)
+			m_manager->release(m_entry);
+		m_manager = nullptr;
+		m_entry = nullptr;
+	}
+
+	Texture* TextureHandle::get() const {
+		if (!m_entry)
+			return nullptr;
+		m_manager->use(m_entry);
+		return m_entry->texture.get();
+	}
+
+	Shader* ShaderHandle::get() const {
+		if (!m_entry)
+			return nullptr;
+		m_manager->use(m_entry);
+		return m_entry->shader.get();
+	}
+
+	AssetManager::AssetManager(const AssetManagerSettings& settings) : m_settings(settings) { }
+
+	AssetManager::~AssetManager() {
+		for (auto& entry : m_entries) {
+			if (entry.second->ref_count > 0)
+				FRACTAL_LOG_WARNING("Asset '%s' is still referenced when the asset manager is destroyed", entry.first.c_str());
+			delete entry.second;
+		}
+	}
+
+	TextureHandle AssetManager::load_texture(const std::string& path, const TextureSpecification& specification) {
+		AssetEntry* entry = find_or_create(AssetType::Texture, path);
+		if (!entry)
+			return TextureHandle();
+
+		if (entry->load_count == 0)
+			entry->specification = specification;
+
+		use(entry);
+		return TextureHandle(this, entry);
+	}
+
+	ShaderHandle AssetManager::load_shader(const std::string& path) {
+		AssetEntry* entry = find_or_create(AssetType::Shader, path);
+		if (!entry)
+			return ShaderHandle();
+
+		use(entry);
+		return ShaderHandle(this, entry);
+	}
+
+	AssetEntry* AssetManager::find_or_create(AssetType type, const std::string& path) {
+		std::string canonical = get_canonical_path(path);
+
+		auto it = m_entries.find(canonical);
+		if (it != m_entries.end()) {
+			if (it->second->type != type) {
+				FRACTAL_LOG_ERROR("Asset '%s' is already loaded as a different type", path.c_str());
+				return nullptr;
+			}
+			return it->second;
+		}
+
+		AssetEntry* entry = new AssetEntry();
+		entry->type = type;
+		entry->path = canonical;
+		m_entries[canonical] = entry;
+		return entry;
+	}
+
+	bool AssetManager::is_resident(const AssetEntry* entry) const {
+		return (entry->type == AssetType::Texture) ? (bool)entry->texture : (bool)entry->shader;
+	}
+
+	void AssetManager::use(AssetEntry* entry) {
+		entry->last_used_frame = m_frame;
+		if (!is_resident(entry))
+			load(entry);
+	}
+
+	void AssetManager::release(AssetEntry* entry) {
+		if (entry->ref_count > 0)
+			entry->ref_count--;
+	}
+
+	void AssetManager::load(AssetEntry* entry) {
+		if (entry->type == AssetType::Texture) {
+			if (m_settings.texture_loader)
+				entry->texture = m_settings.texture_loader->load(entry->path, entry->specification);
+			else {
+				entry->texture = std::make_shared<Texture>();
+				entry->texture->initialize(entry->path.c_str(), entry->specification);
+			}
+		}
+		else
+			entry->shader = std::make_shared<Shader>(entry->path);
+
+		if (entry->load_count++ > 0)
+			m_reloads++;
+		else
+			m_loads++;
+
+		update_memory_size(entry);
+		if (m_memory_used > m_settings.memory_budget)
+			evict();
+	}
+
+	void AssetManager::unload(AssetEntry* entry) {
+		entry->texture.reset();
+		entry->shader.reset();
+		m_memory_used -= entry->memory_size;
+		entry->memory_size = 0;
+	}
+
+	void AssetManager::update_memory_size(AssetEntry* entry) {
+		uint64_t size = 0;
+		if (entry->texture)
+			size = entry->texture->get_memory_size();
+		else if (entry->shader) {
+			int length = 0;
+			glGetProgramiv(entry->shader->get_id(), GL_PROGRAM_BINARY_LENGTH, &length);
+			size = (uint64_t)length;
+		}
+
+		m_memory_used = m_memory_used - entry->memory_size + size;
+		entry->memory_size = size;
+	}
+
+	void AssetManager::begin_frame() {
+		m_frame++;
+
+		//Asynchronously loaded textures only report their size once the upload finishes.
+		for (auto& entry : m_entries)
+			update_memory_size(entry.second);
+
+		if (m_memory_used > m_settings.memory_budget)
+			evict();
+		else
+			m_over_budget = false;
+	}
+
+	void AssetManager::evict() {
+		//Anything used this frame may still be referenced by a batch that has not been flushed.
+		FrameVector<AssetEntry*> candidates;
+		for (auto& entry : m_entries) {
+			if (is_resident(entry.second) && entry.second->last_used_frame < m_frame)
+				candidates.push_back(entry.second);
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [](const AssetEntry* a, const AssetEntry* b) {
+			if ((a->ref_count > 0) != (b->ref_count > 0))
+				return a->ref_count == 0;
+			return a->last_used_frame < b->last_used_frame;
+		});
+
+		for (AssetEntry* entry : candidates) {
+			if (m_memory_used <= m_settings.memory_budget)
+				break;
+
+			unload(entry);
+			m_evictions++;
+
+			if (entry->ref_count == 0) {
+				m_entries.erase(entry->path);
+				delete entry;
+			}
+		}
+
+		if (m_memory_used > m_settings.memory_budget && !m_over_budget)
+			FRACTAL_LOG_WARNING("Assets in use exceed the memory budget (%llu / %llu MB)", (unsigned long long)(m_memory_used >> 20), (unsigned long long)(m_settings.memory_budget >> 20));
+		m_over_budget = (m_memory_used > m_settings.memory_budget);
+	}
+
+	void AssetManager::collect() {
+		for (auto it = m_entries.begin(); it != m_entries.end();) {
+			if (it->second->ref_count == 0) {
+				unload(it->second);
+				delete it->second;
+				it = m_entries.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+
+	AssetStatistics AssetManager::get_statistics() const {
+		AssetStatistics statistics;
+		statistics.asset_count = (uint32_t)m_entries.size();
+		for (auto& entry : m_entries)
+			statistics.resident_count += is_resident(entry.second) ? 1 : 0;
+		statistics.memory_used = m_memory_used;
+		statistics.memory_budget = m_settings.memory_budget;
+		statistics.loads = m_loads;
+		statistics.reloads = m_reloads;
+		statistics.evictions = m_evictions;
+		return statistics;
+	}
+
+	std::vector<const AssetEntry*> AssetManager::get_entries() const {
+		std::vector<const AssetEntry*> entries;
+		for (auto& entry : m_entries)
+			entries.push_back(entry.second);
+		return entries;
+	}
+}
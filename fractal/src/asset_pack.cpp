@@ -0,0 +1,372 @@
+/**
+ * @file asset_pack.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the binary asset pack. A pack is a header, aligned asset
+ * blobs, a name table and a table of contents sorted by name hash. Packs are
+ * memory mapped so uncompressed blobs are used in place without a copy.
+ */
+
+#include "asset_pack.h"
+#include "compression.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+
+namespace Fractal {
+	static_assert(sizeof(AssetPackHeader) == 40, "Asset pack header layout changed");
+	static_assert(sizeof(AssetPackEntry) == 80, "Asset pack entry layout changed");
+
+	std::string normalize_asset_name(const std::string& path) {
+		std::string name = path;
+		std::replace(name.begin(), name.end(), '\\', '/');
+		std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+		while (name.compare(0, 2, "./") == 0)
+			name.erase(0, 2);
+		return name;
+	}
+
+	uint64_t hash_asset_name(const std::string& name) {
+		uint64_t hash = 14695981039346656037ull;
+		for (char c : name) {
+			hash ^= (uint8_t)c;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	bool AssetPack::open(const std::string& path) {
+		close();
+		if (!m_file.open(path))
+			return false;
+
+		const uint8_t* data = m_file.data();
+		uint64_t size = m_file.size();
+
+		AssetPackHeader header;
+		if (size < sizeof(header)) {
+			FRACTAL_LOG_ERROR("'%s' is not an asset pack", path.c_str());
+			close();
+			return false;
+		}
+		memcpy(&header, data, sizeof(header));
+
+		if (header.magic != ASSET_PACK_MAGIC || header.version != ASSET_PACK_VERSION) {
+			FRACTAL_LOG_ERROR("'%s' is not a version %d asset pack", path.c_str(), ASSET_PACK_VERSION);
+			close();
+			return false;
+		}
+
+		if (header.toc_offset % alignof(AssetPackEntry) != 0 || header.toc_offset + (uint64_t)header.entry_count * sizeof(AssetPackEntry) > size ||
+			header.names_offset + header.names_size > size) {
+			FRACTAL_LOG_ERROR("Asset pack '%s' is truncated", path.c_str());
+			close();
+			return false;
+		}
+
+		m_entries = (const AssetPackEntry*)(data + header.toc_offset);
+		m_names = (const char*)(data + header.names_offset);
+		m_entry_count = header.entry_count;
+
+		for (uint32_t i = 0; i < m_entry_count; i++) {
+			const AssetPackEntry& entry = m_entries[i];
+			if (entry.offset + entry.size > size || (uint64_t)entry.name_offset + entry.name_length > header.names_size) {
+				FRACTAL_LOG_ERROR("Asset pack '%s' has a corrupt table of contents", path.c_str());
+				close();
+				return false;
+			}
+		}
+
+		FRACTAL_LOG_GOOD("Opened asset pack '%s' with %d assets", path.c_str(), m_entry_count);
+		return true;
+	}
+
+	void AssetPack::close() {
+		m_file.close();
+		m_entries = nullptr;
+		m_names = nullptr;
+		m_entry_count = 0;
+	}
+
+	std::string AssetPack::get_name(const AssetPackEntry& entry) const {
+		return std::string(m_names + entry.name_offset, entry.name_length);
+	}
+
+	const AssetPackEntry* AssetPack::find(const std::string& name) const {
+		std::string normalized = normalize_asset_name(name);
+		uint64_t hash = hash_asset_name(normalized);
+
+		const AssetPackEntry* end = m_entries + m_entry_count;
+		const AssetPackEntry* it = std::lower_bound(m_entries, end, hash, [](const AssetPackEntry& entry, uint64_t hash) {
+			return entry.name_hash < hash;
+		});
+
+		for (; it != end && it->name_hash == hash; it++) {
+			if (it->name_length == normalized.size() && memcmp(m_names + it->name_offset, normalized.data(), normalized.size()) == 0)
+				return it;
+		}
+		return nullptr;
+	}
+
+	bool AssetPack::read(const AssetPackEntry& entry, std::vector<uint8_t>& scratch, const uint8_t*& data) const {
+		const uint8_t* blob = m_file.data() + entry.offset;
+		if (!(entry.flags & ASSET_PACK_COMPRESSED)) {
+			//Readers trust original_size, only size was checked against the file when the pack was mounted.
+			if (entry.size != entry.original_size) {
+				FRACTAL_LOG_ERROR("Corrupt entry '%s' in asset pack '%s'", get_name(entry).c_str(), get_path().c_str());
+				return false;
+			}
+			data = blob;
+			return true;
+		}
+
+		scratch.resize((size_t)entry.original_size);
+		if (!decompress_block(blob, (uint32_t)entry.size, scratch.data(), (uint32_t)entry.original_size)) {
+			FRACTAL_LOG_ERROR("Failed to decompress '%s' from asset pack '%s'", get_name(entry).c_str(), get_path().c_str());
+			return false;
+		}
+
+		data = scratch.data();
+		return true;
+	}
+
+	bool AssetPack::read_texture(const AssetPackEntry& entry, TextureImage& image) const {
+		if (entry.type != AssetPackType::Texture)
+			return false;
+
+		image = TextureImage();
+		image.width = entry.width;
+		image.height = entry.height;
+		image.internal_format = entry.internal_format;
+		image.data_format = entry.data_format;
+		image.data_type = entry.data_type;
+		image.row_alignment = entry.row_alignment;
+		image.compressed = (entry.flags & ASSET_PACK_BLOCK_COMPRESSED) != 0;
+
+		uint32_t offset = 0;
+		for (uint32_t i = 0, w = entry.width, h = entry.height; i < entry.level_count; i++, w = std::max(w / 2, 1u), h = std::max(h / 2, 1u)) {
+			TextureLevel level;
+			level.width = w;
+			level.height = h;
+			level.offset = offset;
+			level.size = get_row_size(image, level) * get_row_count(image, level);
+			image.levels.push_back(level);
+			offset += level.size;
+		}
+
+		if (offset != entry.original_size) {
+			FRACTAL_LOG_ERROR("Texture '%s' in asset pack '%s' has a bad size", get_name(entry).c_str(), get_path().c_str());
+			return false;
+		}
+
+		const uint8_t* data;
+		if (!read(entry, image.data, data))
+			return false;
+
+		//Uncompressed blobs are uploaded straight from the mapped pages.
+		if (data != image.data.data())
+			image.external_data = data;
+		return true;
+	}
+
+	bool AssetPack::read_text(const AssetPackEntry& entry, std::string& text) const {
+		std::vector<uint8_t> scratch;
+		const uint8_t* data;
+		if (!read(entry, scratch, data))
+			return false;
+
+		text.assign((const char*)data, (size_t)entry.original_size);
+		return true;
+	}
+
+	bool AssetPack::read_mesh(const AssetPackEntry& entry, Model& model) const {
+		std::vector<uint8_t> scratch;
+		const uint8_t* data;
+		if (!read(entry, scratch, data))
+			return false;
+
+		if (!deserialize_model(data, entry.original_size, model)) {
+			FRACTAL_LOG_ERROR("Mesh '%s' in asset pack '%s' is corrupt", get_name(entry).c_str(), get_path().c_str());
+			return false;
+		}
+		return true;
+	}
+
+	AssetPackWriter::AssetPackWriter(bool compress) : m_compress(compress) { }
+
+	AssetPackWriter::PendingEntry& AssetPackWriter::create_entry(const std::string& name, AssetPackType type, const void* data, uint64_t size) {
+		m_entries.emplace_back();
+		PendingEntry& pending = m_entries.back();
+		memset(&pending.entry, 0, sizeof(pending.entry));
+
+		pending.name = normalize_asset_name(name);
+		pending.entry.name_hash = hash_asset_name(pending.name);
+		pending.entry.type = type;
+		pending.entry.original_size = size;
+
+		//Only keep the compressed blob when it saves at least an eighth, otherwise map it raw.
+		if (m_compress && size >= ASSET_PACK_ALIGNMENT && size < UINT32_MAX / 2) {
+			pending.data.resize(get_compress_bound((uint32_t)size));
+			uint32_t compressed = compress_block((const uint8_t*)data, (uint32_t)size, pending.data.data(), (uint32_t)pending.data.size());
+			if (compressed && compressed < size - size / 8) {
+				pending.data.resize(compressed);
+				pending.entry.flags |= ASSET_PACK_COMPRESSED;
+			}
+		}
+
+		if (!(pending.entry.flags & ASSET_PACK_COMPRESSED))
+			pending.data.assign((const uint8_t*)data, (const uint8_t*)data + size);
+
+		pending.entry.size = pending.data.size();
+		m_original_size += size;
+		m_stored_size += pending.entry.size;
+		return pending;
+	}
+
+	void AssetPackWriter::add(const std::string& name, AssetPackType type, const void* data, uint64_t size) {
+		create_entry(name, type, data, size);
+	}
+
+	void AssetPackWriter::add_texture(const std::string& name, const TextureImage& image) {
+		std::vector<uint8_t> data;
+		for (const TextureLevel& level : image.levels) {
+			const uint8_t* source = image.get_data() + level.offset;
+			data.insert(data.end(), source, source + get_row_size(image, level) * get_row_count(image, level));
+		}
+
+		AssetPackEntry& entry = create_entry(name, AssetPackType::Texture, data.data(), data.size()).entry;
+		entry.width = image.width;
+		entry.height = image.height;
+		entry.level_count = (uint32_t)image.levels.size();
+		entry.internal_format = image.internal_format;
+		entry.data_format = image.data_format;
+		entry.data_type = image.data_type;
+		entry.row_alignment = image.row_alignment;
+		if (image.compressed)
+			entry.flags |= ASSET_PACK_BLOCK_COMPRESSED;
+	}
+
+	void AssetPackWriter::add_shader(const std::string& name, const std::string& source) {
+		create_entry(name, AssetPackType::Shader, source.data(), source.size());
+	}
+
+	void AssetPackWriter::add_mesh(const std::string& name, const Model& model) {
+		std::vector<uint8_t> data;
+		serialize_model(model, data);
+		create_entry(name, AssetPackType::Mesh, data.data(), data.size());
+	}
+
+	static void pad_stream(std::ofstream& stream, uint64_t alignment) {
+		static const char zeros[ASSET_PACK_ALIGNMENT] = { 0 };
+		uint64_t position = (uint64_t)stream.tellp();
+		uint64_t padding = (alignment - position % alignment) % alignment;
+		stream.write(zeros, (std::streamsize)padding);
+	}
+
+	bool AssetPackWriter::write(const std::string& path) {
+		std::sort(m_entries.begin(), m_entries.end(), [](const PendingEntry& a, const PendingEntry& b) {
+			return a.entry.name_hash < b.entry.name_hash;
+		});
+
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		if (!stream.is_open()) {
+			FRACTAL_LOG_ERROR("Failed to create asset pack '%s'", path.c_str());
+			return false;
+		}
+
+		AssetPackHeader header;
+		memset(&header, 0, sizeof(header));
+		stream.write((const char*)&header, sizeof(header));
+
+		std::string names;
+		for (PendingEntry& pending : m_entries) {
+			pad_stream(stream, ASSET_PACK_ALIGNMENT);
+			pending.entry.offset = (uint64_t)stream.tellp();
+			stream.write((const char*)pending.data.data(), (std::streamsize)pending.data.size());
+
+			pending.entry.name_offset = (uint32_t)names.size();
+			pending.entry.name_length = (uint32_t)pending.name.size();
+			names += pending.name;
+		}
+
+		header.names_offset = (uint64_t)stream.tellp();
+		header.names_size = names.size();
+		stream.write(names.data(), (std::streamsize)names.size());
+
+		pad_stream(stream, ASSET_PACK_ALIGNMENT);
+		header.toc_offset = (uint64_t)stream.tellp();
+		for (const PendingEntry& pending : m_entries)
+			stream.write((const char*)&pending.entry, sizeof(pending.entry));
+
+		header.magic = ASSET_PACK_MAGIC;
+		header.version = ASSET_PACK_VERSION;
+		header.entry_count = (uint32_t)m_entries.size();
+		stream.seekp(0);
+		stream.write((const char*)&header, sizeof(header));
+
+		if (!stream.good()) {
+			FRACTAL_LOG_ERROR("Failed to write asset pack '%s'", path.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	static std::mutex mounted_mutex;
+	static std::vector<AssetPack*> mounted_packs;
+
+	void mount_asset_pack(AssetPack* pack) {
+		std::lock_guard<std::mutex> lock(mounted_mutex);
+		mounted_packs.push_back(pack);
+	}
+
+	void unmount_asset_pack(AssetPack* pack) {
+		std::lock_guard<std::mutex> lock(mounted_mutex);
+		mounted_packs.erase(std::remove(mounted_packs.begin(), mounted_packs.end(), pack), mounted_packs.end());
+	}
+
+	bool find_packed_asset(const std::string& path, const AssetPack*& pack, const AssetPackEntry*& entry) {
+		std::lock_guard<std::mutex> lock(mounted_mutex);
+
+		//Packs mounted later override earlier ones.
+		for (auto it = mounted_packs.rbegin(); it != mounted_packs.rend(); it++) {
+			entry = (*it)->find(path);
+			if (entry) {
+				pack = *it;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool load_packed_texture(const std::string& path, TextureImage& image) {
+		const AssetPack* pack;
+		const AssetPackEntry* entry;
+		return find_packed_asset(path, pack, entry) && entry->type == AssetPackType::Texture && pack->read_texture(*entry, image);
+	}
+
+	bool load_packed_text(const std::string& path, std::string& text) {
+		const AssetPack* pack;
+		const AssetPackEntry* entry;
+		return find_packed_asset(path, pack, entry) && pack->read_text(*entry, text);
+	}
+
+	bool load_packed_model(const std::string& path, Model& model) {
+		const AssetPack* pack;
+		const AssetPackEntry* entry;
+		return find_packed_asset(path, pack, entry) && entry->type == AssetPackType::Mesh && pack->read_mesh(*entry, model);
+	}
+}
@@ -0,0 +1,134 @@
+/**
+ * @file bounds.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains axis aligned bounding boxes and bounding spheres.
+ */
+
+#include "bounds.h"
+
+#include <algorithm>
+
+namespace Fractal {
+	static inline glm::vec3 get_position(const void* positions, size_t index, uint32_t stride) {
+		const float* p = (const float*)((const uint8_t*)positions + index * stride);
+		return glm::vec3(p[0], p[1], p[2]);
+	}
+
+	void BoundingBox::expand(const glm::vec3& point) {
+		min = glm::min(min, point);
+		max = glm::max(max, point);
+	}
+
+	void BoundingBox::expand(const BoundingBox& box) {
+		min = glm::min(min, box.min);
+		max = glm::max(max, box.max);
+	}
+
+	BoundingBox BoundingBox::transform(const glm::mat4& matrix) const {
+		if (!valid())
+			return *this;
+
+		//Transforming the center and the absolute extent avoids touching all eight corners.
+		glm::vec3 center = glm::vec3(matrix * glm::vec4(get_center(), 1.0f));
+		glm::vec3 half = get_extent() * 0.5f;
+		glm::vec3 extent(0.0f);
+		for (int i = 0; i < 3; i++)
+			extent += glm::abs(glm::vec3(matrix[i])) * half[i];
+
+		BoundingBox result;
+		result.min = center - extent;
+		result.max = center + extent;
+		return result;
+	}
+
+	Frustum::Frustum(const glm::mat4& proj_view) {
+		//Gribb and Hartmann, each plane is a sum or difference of the fourth row with another.
+		glm::mat4 m = glm::transpose(proj_view);
+		planes[0] = m[3] + m[0];
+		planes[1] = m[3] - m[0];
+		planes[2] = m[3] + m[1];
+		planes[3] = m[3] - m[1];
+		planes[4] = m[3] + m[2];
+		planes[5] = m[3] - m[2];
+
+		for (glm::vec4& plane : planes)
+			plane /= glm::length(glm::vec3(plane));
+	}
+
+	FrustumTest Frustum::test(const BoundingBox& box) const {
+		glm::vec3 center = box.get_center();
+		glm::vec3 half = box.get_extent() * 0.5f;
+
+		FrustumTest result = FrustumTest::Inside;
+		for (const glm::vec4& plane : planes) {
+			glm::vec3 normal = glm::vec3(plane);
+			float distance = glm::dot(normal, center) + plane.w;
+			float radius = glm::dot(glm::abs(normal), half);
+			if (distance < -radius)
+				return FrustumTest::Outside;
+			if (distance < radius)
+				result = FrustumTest::Intersects;
+		}
+		return result;
+	}
+
+	BoundingBox compute_bounding_box(const void* positions, size_t count, uint32_t stride) {
+		BoundingBox box;
+		for (size_t i = 0; i < count; i++)
+			box.expand(get_position(positions, i, stride));
+		return box;
+	}
+
+	BoundingSphere compute_bounding_sphere(const void* positions, size_t count, uint32_t stride) {
+		BoundingSphere sphere;
+		if (count == 0)
+			return sphere;
+
+		//Ritter's sphere: start from the two most separated extreme points and grow to fit the rest.
+		size_t min_index[3] = { 0, 0, 0 }, max_index[3] = { 0, 0, 0 };
+		for (size_t i = 1; i < count; i++) {
+			glm::vec3 p = get_position(positions, i, stride);
+			for (int axis = 0; axis < 3; axis++) {
+				if (p[axis] < get_position(positions, min_index[axis], stride)[axis])
+					min_index[axis] = i;
+				if (p[axis] > get_position(positions, max_index[axis], stride)[axis])
+					max_index[axis] = i;
+			}
+		}
+
+		int widest = 0;
+		float widest_distance = -1.0f;
+		for (int axis = 0; axis < 3; axis++) {
+			float distance = glm::distance(get_position(positions, min_index[axis], stride), get_position(positions, max_index[axis], stride));
+			if (distance > widest_distance) {
+				widest_distance = distance;
+				widest = axis;
+			}
+		}
+
+		sphere.center = (get_position(positions, min_index[widest], stride) + get_position(positions, max_index[widest], stride)) * 0.5f;
+		sphere.radius = widest_distance * 0.5f;
+
+		for (size_t i = 0; i < count; i++) {
+			glm::vec3 p = get_position(positions, i, stride);
+			float distance = glm::distance(p, sphere.center);
+			if (distance > sphere.radius) {
+				float radius = (sphere.radius + distance) * 0.5f;
+				sphere.center += (p - sphere.center) * ((radius - sphere.radius) / distance);
+				sphere.radius = radius;
+			}
+		}
+		return sphere;
+	}
+}
@@ -16,6 +16,7 @@
  */
 
 #include "buffer.h"
+#include "gpu_resources.h"
 #include <glad/glad.h>
 
 namespace Fractal {
@@ -25,18 +26,23 @@ namespace Fractal {
 
 	VertexBuffer::VertexBuffer(float* vertices, uint32_t size) {
 		glGenBuffers(1, &m_vertex_buffer_id);
+		m_handle = register_gpu_resource(this);
 		bind();
 		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+		register_gpu_allocation(GpuResourceType::Buffer, m_vertex_buffer_id, GpuMemoryCategory::VertexBuffer, size, GL_STATIC_DRAW);
 	}
 
 	VertexBuffer::VertexBuffer(uint32_t size) {
 		glGenBuffers(1, &m_vertex_buffer_id);
+		m_handle = register_gpu_resource(this);
 		bind();
 		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		register_gpu_allocation(GpuResourceType::Buffer, m_vertex_buffer_id, GpuMemoryCategory::VertexBuffer, size, GL_DYNAMIC_DRAW);
 	}
 
 	VertexBuffer::~VertexBuffer() {
-		glDeleteBuffers(1, &m_vertex_buffer_id);
+		unregister_gpu_resource(m_handle);
+		destroy_gpu_resource(GpuResourceType::Buffer, m_vertex_buffer_id);
 	}
 
 	void VertexBuffer::bind() {
@@ -58,15 +64,19 @@ namespace Fractal {
 
 	IndexBuffer::IndexBuffer(uint32_t* indices, uint32_t size) {
 		glGenBuffers(1, &m_index_buffer_id);
+		m_handle = register_gpu_resource(this);
 		bind();
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
+		register_gpu_allocation(GpuResourceType::Buffer, m_index_buffer_id, GpuMemoryCategory::IndexBuffer, size, GL_STATIC_DRAW);
 		m_count = size / sizeof(*indices);
 	}
 
 	IndexBuffer::IndexBuffer(uint32_t size) {
 		glGenBuffers(1, &m_index_buffer_id);
+		m_handle = register_gpu_resource(this);
 		bind();
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		register_gpu_allocation(GpuResourceType::Buffer, m_index_buffer_id, GpuMemoryCategory::IndexBuffer, size, GL_DYNAMIC_DRAW);
 		m_count = 0;
 	}
 
@@ -77,7 +87,8 @@ namespace Fractal {
 	}
 
 	IndexBuffer::~IndexBuffer() {
-		glDeleteBuffers(1, &m_index_buffer_id);
+		unregister_gpu_resource(m_handle);
+		destroy_gpu_resource(GpuResourceType::Buffer, m_index_buffer_id);
 	}
 
 	void IndexBuffer::bind() {
@@ -94,6 +105,7 @@ namespace Fractal {
 
 	UniformBuffer::UniformBuffer(uint32_t size, uint32_t bindpoint) {
 		glGenBuffers(1, &m_uniform_buffer_id);
+		m_handle = register_gpu_resource(this);
 		m_uniform_buffer_point = bindpoint;
 		bind();
 		allocate_data(size);
@@ -101,7 +113,8 @@ namespace Fractal {
 	}
 
 	UniformBuffer::~UniformBuffer() {
-		glDeleteBuffers(1, &m_uniform_buffer_id);
+		unregister_gpu_resource(m_handle);
+		destroy_gpu_resource(GpuResourceType::Buffer, m_uniform_buffer_id);
 	}
 
 	void UniformBuffer::bind() {
@@ -139,18 +152,21 @@ namespace Fractal {
 
 	void UniformBuffer::allocate_data(uint32_t size) {
 		glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		register_gpu_allocation(GpuResourceType::Buffer, m_uniform_buffer_id, GpuMemoryCategory::UniformBuffer, size, GL_DYNAMIC_DRAW);
 	}
 
 	static uint32_t current_indirect_draw_buffer = 0;
 	IndirectDrawBuffer::IndirectDrawBuffer(uint32_t size) {
 		glGenBuffers(1, &m_indirect_buffer_id);
+		m_handle = register_gpu_resource(this);
 		bind();
 		allocate_data(size, nullptr);
 		m_size_of_buffer = size;
 	}
 
 	IndirectDrawBuffer::~IndirectDrawBuffer() {
-		glDeleteBuffers(1, &m_indirect_buffer_id);
+		unregister_gpu_resource(m_handle);
+		destroy_gpu_resource(GpuResourceType::Buffer, m_indirect_buffer_id);
 	}
 
 	void IndirectDrawBuffer::bind() {
@@ -175,11 +191,13 @@ namespace Fractal {
 
 	void IndirectDrawBuffer::allocate_data(uint32_t size, void* data) {
 		glBufferData(GL_DRAW_INDIRECT_BUFFER, size, data, GL_DYNAMIC_DRAW);
+		register_gpu_allocation(GpuResourceType::Buffer, m_indirect_buffer_id, GpuMemoryCategory::IndirectBuffer, size, GL_DYNAMIC_DRAW);
 	}
 
 	static uint32_t current_shader_storage_id = 0;
 	ShaderStorageBuffer::ShaderStorageBuffer(uint32_t size, uint32_t bindpoint) {
 		glGenBuffers(1, &m_shader_storage_id);
+		m_handle = register_gpu_resource(this);
 		bind();
 		allocate_data(size, nullptr);
 		m_size_of_buffer = size;
@@ -187,7 +205,8 @@ namespace Fractal {
 	}
 
 	ShaderStorageBuffer::~ShaderStorageBuffer() {
-		glDeleteBuffers(1, &m_shader_storage_id);
+		unregister_gpu_resource(m_handle);
+		destroy_gpu_resource(GpuResourceType::Buffer, m_shader_storage_id);
 	}
 
 	void ShaderStorageBuffer::bind() {
@@ -206,11 +225,13 @@ namespace Fractal {
 	}
 
 	void ShaderStorageBuffer::set_data(void* data, uint32_t size, uint32_t offset) {
-		glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, data);
+		//Binding to an indexed point also moves the generic binding, so write through the name.
+		glNamedBufferSubData(m_shader_storage_id, offset, size, data);
 	}
 
 	void ShaderStorageBuffer::allocate_data(uint32_t size, void* data) {
 		glBufferData(GL_SHADER_STORAGE_BUFFER, size, nullptr, GL_DYNAMIC_DRAW); 
+		register_gpu_allocation(GpuResourceType::Buffer, m_shader_storage_id, GpuMemoryCategory::StorageBuffer, size, GL_DYNAMIC_DRAW);
 	}
 
 	uint32_t ShaderStorageBuffer::get_uniform_block_id(uint32_t shader_id, const std::string& block_name) {
@@ -225,4 +246,88 @@ namespace Fractal {
 	void ShaderStorageBuffer::bind_to_bind_point() {
 		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, m_binding_point, m_shader_storage_id);
 	}
+
+	static uint32_t current_pixel_pack_id = 0;
+	PixelPackBuffer::PixelPackBuffer(uint32_t size) {
+		glGenBuffers(1, &m_pixel_pack_id);
+		m_handle = register_gpu_resource(this);
+		allocate_data(size);
+	}
+
+	PixelPackBuffer::~PixelPackBuffer() {
+		if (current_pixel_pack_id == m_pixel_pack_id)
+			current_pixel_pack_id = 0;
+		unregister_gpu_resource(m_handle);
+		destroy_gpu_resource(GpuResourceType::Buffer, m_pixel_pack_id);
+	}
+
+	void PixelPackBuffer::bind() {
+		if (current_pixel_pack_id != m_pixel_pack_id) {
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pixel_pack_id);
+			current_pixel_pack_id = m_pixel_pack_id;
+		}
+	}
+
+	void PixelPackBuffer::unbind() {
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		current_pixel_pack_id = 0;
+	}
+
+	void PixelPackBuffer::allocate_data(uint32_t size) {
+		bind();
+		glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+		register_gpu_allocation(GpuResourceType::Buffer, m_pixel_pack_id, GpuMemoryCategory::StagingBuffer, size, GL_STREAM_READ);
+		unbind();
+		m_size_of_buffer = size;
+	}
+
+	const void* PixelPackBuffer::map(uint32_t size) {
+		return glMapNamedBufferRange(m_pixel_pack_id, 0, size, GL_MAP_READ_BIT);
+	}
+
+	void PixelPackBuffer::unmap() {
+		glUnmapNamedBuffer(m_pixel_pack_id);
+	}
+
+	static uint32_t current_pixel_unpack_id = 0;
+	PixelUnpackBuffer::PixelUnpackBuffer(uint32_t size) {
+		glGenBuffers(1, &m_pixel_unpack_id);
+		m_handle = register_gpu_resource(this);
+		allocate_data(size);
+	}
+
+	PixelUnpackBuffer::~PixelUnpackBuffer() {
+		if (current_pixel_unpack_id == m_pixel_unpack_id)
+			current_pixel_unpack_id = 0;
+		unregister_gpu_resource(m_handle);
+		destroy_gpu_resource(GpuResourceType::Buffer, m_pixel_unpack_id);
+	}
+
+	void PixelUnpackBuffer::bind() {
+		if (current_pixel_unpack_id != m_pixel_unpack_id) {
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixel_unpack_id);
+			current_pixel_unpack_id = m_pixel_unpack_id;
+		}
+	}
+
+	void PixelUnpackBuffer::unbind() {
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		current_pixel_unpack_id = 0;
+	}
+
+	void PixelUnpackBuffer::allocate_data(uint32_t size) {
+		bind();
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+		register_gpu_allocation(GpuResourceType::Buffer, m_pixel_unpack_id, GpuMemoryCategory::StagingBuffer, size, GL_STREAM_DRAW);
+		unbind();
+		m_size_of_buffer = size;
+	}
+
+	void* PixelUnpackBuffer::map(uint32_t size) {
+		return glMapNamedBufferRange(m_pixel_unpack_id, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	}
+
+	void PixelUnpackBuffer::unmap() {
+		glUnmapNamedBuffer(m_pixel_unpack_id);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,517 @@
+/**
+ * @file bvh.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains a bounding volume hierarchy for culling, ray casts
+ * and overlap queries.
+ */
+
+#include "bvh.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+
+namespace Fractal {
+	using Clock = std::chrono::high_resolution_clock;
+
+	static float elapsed_ms(const Clock::time_point& start) {
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	struct Bvh::BuildTasks {
+		std::mutex mutex;
+		std::condition_variable done;
+		uint32_t pending = 0;
+	};
+
+	static inline float surface_area(const BoundingBox& box) {
+		glm::vec3 extent = box.get_extent();
+		return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+	}
+
+	static inline BoundingBox combine(const BoundingBox& a, const BoundingBox& b) {
+		BoundingBox box = a;
+		box.expand(b);
+		return box;
+	}
+
+	static inline bool overlaps(const BoundingBox& a, const BoundingBox& b) {
+		return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y && a.min.z <= b.max.z && a.max.z >= b.min.z;
+	}
+
+	//Slab test, returns the entry distance or FLT_MAX on a miss.
+	static inline float intersect_box(const BoundingBox& box, const glm::vec3& origin, const glm::vec3& inverse_direction, float max_distance) {
+		glm::vec3 t0 = (box.min - origin) * inverse_direction;
+		glm::vec3 t1 = (box.max - origin) * inverse_direction;
+		glm::vec3 near = glm::min(t0, t1);
+		glm::vec3 far = glm::max(t0, t1);
+		float enter = std::max(std::max(near.x, near.y), std::max(near.z, 0.0f));
+		float exit = std::min(std::min(far.x, far.y), std::min(far.z, max_distance));
+		return (enter <= exit) ? enter : FLT_MAX;
+	}
+
+	//Traversal stacks are reused per thread so queries do not allocate once warmed up.
+	static std::vector<uint32_t>& get_traversal_stack() {
+		static thread_local std::vector<uint32_t> stack;
+		stack.clear();
+		return stack;
+	}
+
+	uint32_t Bvh::allocate_node() {
+		if (!m_free_nodes.empty()) {
+			uint32_t node = m_free_nodes.back();
+			m_free_nodes.pop_back();
+			m_nodes[node] = BvhNode();
+			return node;
+		}
+
+		m_nodes.push_back(BvhNode());
+		return (uint32_t)m_nodes.size() - 1;
+	}
+
+	void Bvh::free_node(uint32_t node) {
+		m_nodes[node] = BvhNode();
+		m_free_nodes.push_back(node);
+	}
+
+	uint32_t Bvh::insert(const BoundingBox& bounds) {
+		uint32_t object;
+		if (!m_free_objects.empty()) {
+			object = m_free_objects.back();
+			m_free_objects.pop_back();
+		}
+		else {
+			object = (uint32_t)m_objects.size();
+			m_objects.push_back(BvhObject());
+		}
+
+		uint32_t leaf = allocate_node();
+		m_nodes[leaf].bounds = bounds;
+		m_nodes[leaf].object = object;
+		m_objects[object].bounds = bounds;
+		m_objects[object].node = leaf;
+		insert_leaf(leaf);
+
+		m_statistics.object_count++;
+		m_statistics.node_count = (uint32_t)(m_nodes.size() - m_free_nodes.size());
+		return object;
+	}
+
+	void Bvh::remove(uint32_t object) {
+		if (!contains(object))
+			return;
+
+		uint32_t leaf = m_objects[object].node;
+		remove_leaf(leaf);
+		free_node(leaf);
+		m_objects[object] = BvhObject();
+		m_free_objects.push_back(object);
+
+		m_statistics.object_count--;
+		m_statistics.node_count = (uint32_t)(m_nodes.size() - m_free_nodes.size());
+	}
+
+	void Bvh::update(uint32_t object, const BoundingBox& bounds) {
+		if (!contains(object))
+			return;
+
+		m_objects[object].bounds = bounds;
+		m_nodes[m_objects[object].node].bounds = bounds;
+		m_dirty.push_back(m_objects[object].node);
+	}
+
+	void Bvh::refit() {
+		auto start = Clock::now();
+		for (uint32_t leaf : m_dirty)
+			if (m_nodes[leaf].is_leaf())
+				refit_from(m_nodes[leaf].parent);
+		m_dirty.clear();
+		m_statistics.refit_ms = elapsed_ms(start);
+	}
+
+	void Bvh::refit_from(uint32_t node) {
+		while (node != BVH_NULL) {
+			BvhNode& current = m_nodes[node];
+			BoundingBox bounds = combine(m_nodes[current.left].bounds, m_nodes[current.right].bounds);
+			//Ancestors already contain this box if nothing changed here.
+			if (bounds.min == current.bounds.min && bounds.max == current.bounds.max)
+				return;
+			current.bounds = bounds;
+			node = current.parent;
+		}
+	}
+
+	void Bvh::insert_leaf(uint32_t leaf) {
+		if (m_root == BVH_NULL) {
+			m_root = leaf;
+			m_nodes[leaf].parent = BVH_NULL;
+			return;
+		}
+
+		//Walk down to the sibling that grows the surface area the least.
+		const BoundingBox box = m_nodes[leaf].bounds;
+		uint32_t index = m_root;
+		while (!m_nodes[index].is_leaf()) {
+			const BvhNode& node = m_nodes[index];
+			float area = surface_area(node.bounds);
+			float combined_area = surface_area(combine(node.bounds, box));
+
+			float cost = 2.0f * combined_area;
+			float inheritance = 2.0f * (combined_area - area);
+
+			float child_cost[2];
+			uint32_t children[2] = { node.left, node.right };
+			for (int i = 0; i < 2; i++) {
+				const BvhNode& child = m_nodes[children[i]];
+				float enlarged = surface_area(combine(child.bounds, box));
+				child_cost[i] = (child.is_leaf() ? enlarged : enlarged - surface_area(child.bounds)) + inheritance;
+			}
+
+			if (cost < child_cost[0] && cost < child_cost[1])
+				break;
+			index = (child_cost[0] < child_cost[1]) ? children[0] : children[1];
+		}
+
+		uint32_t sibling = index;
+		uint32_t old_parent = m_nodes[sibling].parent;
+		uint32_t new_parent = allocate_node();
+		m_nodes[new_parent].parent = old_parent;
+		m_nodes[new_parent].bounds = combine(box, m_nodes[sibling].bounds);
+		m_nodes[new_parent].left = sibling;
+		m_nodes[new_parent].right = leaf;
+		m_nodes[sibling].parent = new_parent;
+		m_nodes[leaf].parent = new_parent;
+
+		if (old_parent == BVH_NULL)
+			m_root = new_parent;
+		else if (m_nodes[old_parent].left == sibling)
+			m_nodes[old_parent].left = new_parent;
+		else
+			m_nodes[old_parent].right = new_parent;
+
+		refit_from(old_parent);
+	}
+
+	void Bvh::remove_leaf(uint32_t leaf) {
+		if (leaf == m_root) {
+			m_root = BVH_NULL;
+			return;
+		}
+
+		uint32_t parent = m_nodes[leaf].parent;
+		uint32_t grandparent = m_nodes[parent].parent;
+		uint32_t sibling = (m_nodes[parent].left == leaf) ? m_nodes[parent].right : m_nodes[parent].left;
+
+		m_nodes[sibling].parent = grandparent;
+		if (grandparent == BVH_NULL)
+			m_root = sibling;
+		else {
+			if (m_nodes[grandparent].left == parent)
+				m_nodes[grandparent].left = sibling;
+			else
+				m_nodes[grandparent].right = sibling;
+		}
+		free_node(parent);
+
+		//Shrinking boxes never match their old bounds, so this walks to the root.
+		refit_from(grandparent);
+	}
+
+	void Bvh::build(ThreadPool* pool) {
+		auto start = Clock::now();
+
+		std::vector<uint32_t> objects;
+		objects.reserve(m_statistics.object_count);
+		for (uint32_t i = 0; i < (uint32_t)m_objects.size(); i++)
+			if (m_objects[i].node != BVH_NULL)
+				objects.push_back(i);
+
+		//A tree with one object per leaf always has 2n - 1 nodes, so every subtree knows its node range up front.
+		m_nodes.assign(objects.empty() ? 0 : objects.size() * 2 - 1, BvhNode());
+		m_free_nodes.clear();
+		m_dirty.clear();
+		m_root = objects.empty() ? BVH_NULL : 0;
+
+		if (!objects.empty()) {
+			BuildTasks tasks;
+			build_range(0, BVH_NULL, objects.data(), (uint32_t)objects.size(), pool, &tasks);
+
+			std::unique_lock<std::mutex> lock(tasks.mutex);
+			tasks.done.wait(lock, [&tasks] { return tasks.pending == 0; });
+		}
+
+		m_statistics.node_count = (uint32_t)m_nodes.size();
+		m_statistics.build_ms = elapsed_ms(start);
+	}
+
+	void Bvh::build_range(uint32_t node, uint32_t parent, uint32_t* objects, uint32_t count, ThreadPool* pool, BuildTasks* tasks) {
+		BvhNode& current = m_nodes[node];
+		current.parent = parent;
+
+		if (count == 1) {
+			current.object = objects[0];
+			current.bounds = m_objects[objects[0]].bounds;
+			m_objects[objects[0]].node = node;
+			return;
+		}
+
+		BoundingBox bounds, centroids;
+		for (uint32_t i = 0; i < count; i++) {
+			const BoundingBox& box = m_objects[objects[i]].bounds;
+			bounds.expand(box);
+			centroids.expand(box.get_center());
+		}
+		current.bounds = bounds;
+
+		glm::vec3 extent = centroids.get_extent();
+		int axis = (extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z) ? 1 : 2;
+
+		uint32_t left_count = count / 2;
+		if (extent[axis] > 0.0f) {
+			//Binned surface area heuristic along the widest centroid axis.
+			struct Bin {
+				BoundingBox bounds;
+				uint32_t count = 0;
+			} bins[BVH_BIN_COUNT];
+
+			float scale = (float)BVH_BIN_COUNT / extent[axis];
+			auto get_bin = [&](uint32_t object) {
+				uint32_t bin = (uint32_t)((m_objects[object].bounds.get_center()[axis] - centroids.min[axis]) * scale);
+				return std::min(bin, BVH_BIN_COUNT - 1);
+			};
+
+			for (uint32_t i = 0; i < count; i++) {
+				Bin& bin = bins[get_bin(objects[i])];
+				bin.bounds.expand(m_objects[objects[i]].bounds);
+				bin.count++;
+			}
+
+			float right_area[BVH_BIN_COUNT];
+			uint32_t right_count[BVH_BIN_COUNT];
+			BoundingBox accumulated;
+			uint32_t accumulated_count = 0;
+			for (uint32_t i = BVH_BIN_COUNT - 1; i > 0; i--) {
+				accumulated.expand(bins[i].bounds);
+				accumulated_count += bins[i].count;
+				right_area[i] = accumulated_count ? surface_area(accumulated) : 0.0f;
+				right_count[i] = accumulated_count;
+			}
+
+			float best_cost = FLT_MAX;
+			uint32_t best_split = 0;
+			accumulated = BoundingBox();
+			accumulated_count = 0;
+			for (uint32_t i = 0; i < BVH_BIN_COUNT - 1; i++) {
+				accumulated.expand(bins[i].bounds);
+				accumulated_count += bins[i].count;
+				if (accumulated_count == 0 || right_count[i + 1] == 0)
+					continue;
+
+				float cost = surface_area(accumulated) * accumulated_count + right_area[i + 1] * right_count[i + 1];
+				if (cost < best_cost) {
+					best_cost = cost;
+					best_split = i;
+				}
+			}
+
+			uint32_t* middle = std::partition(objects, objects + count, [&](uint32_t object) { return get_bin(object) <= best_split; });
+			left_count = (uint32_t)(middle - objects);
+		}
+
+		//Every centroid in one place or one bin, an even split is as good as any.
+		if (left_count == 0 || left_count == count) {
+			left_count = count / 2;
+			std::nth_element(objects, objects + left_count, objects + count, [&](uint32_t a, uint32_t b) {
+				return m_objects[a].bounds.get_center()[axis] < m_objects[b].bounds.get_center()[axis];
+			});
+		}
+
+		uint32_t left = node + 1;
+		uint32_t right = node + 2 * left_count;
+		current.left = left;
+		current.right = right;
+
+		uint32_t right_objects = count - left_count;
+		if (pool && right_objects > BVH_PARALLEL_THRESHOLD) {
+			{
+				std::lock_guard<std::mutex> lock(tasks->mutex);
+				tasks->pending++;
+			}
+			pool->submit([this, right, node, objects, left_count, right_objects, pool, tasks]() {
+				build_range(right, node, objects + left_count, right_objects, pool, tasks);
+
+				std::lock_guard<std::mutex> lock(tasks->mutex);
+				if (--tasks->pending == 0)
+					tasks->done.notify_all();
+			});
+		}
+		else
+			build_range(right, node, objects + left_count, right_objects, pool, tasks);
+
+		build_range(left, node, objects, left_count, pool, tasks);
+	}
+
+	void Bvh::clear() {
+		m_nodes.clear();
+		m_free_nodes.clear();
+		m_objects.clear();
+		m_free_objects.clear();
+		m_dirty.clear();
+		m_root = BVH_NULL;
+		m_statistics.object_count = 0;
+		m_statistics.node_count = 0;
+	}
+
+	void Bvh::collect_leaves(uint32_t node, std::vector<uint32_t>& objects, std::vector<uint32_t>& stack, uint64_t& visited) const {
+		size_t base = stack.size();
+		stack.push_back(node);
+		while (stack.size() > base) {
+			const BvhNode& current = m_nodes[stack.back()];
+			stack.pop_back();
+			visited++;
+
+			if (current.is_leaf())
+				objects.push_back(current.object);
+			else {
+				stack.push_back(current.left);
+				stack.push_back(current.right);
+			}
+		}
+	}
+
+	void Bvh::query_frustum(const Frustum& frustum, std::vector<uint32_t>& objects) const {
+		auto start = Clock::now();
+		uint64_t visited = 0;
+		std::vector<uint32_t>& stack = get_traversal_stack();
+		if (m_root != BVH_NULL)
+			stack.push_back(m_root);
+
+		while (!stack.empty()) {
+			uint32_t index = stack.back();
+			stack.pop_back();
+			visited++;
+
+			const BvhNode& node = m_nodes[index];
+			FrustumTest test = frustum.test(node.bounds);
+			if (test == FrustumTest::Outside)
+				continue;
+
+			if (node.is_leaf())
+				objects.push_back(node.object);
+			//Fully inside, everything below is visible without another plane test.
+			else if (test == FrustumTest::Inside) {
+				collect_leaves(node.left, objects, stack, visited);
+				collect_leaves(node.right, objects, stack, visited);
+			}
+			else {
+				stack.push_back(node.left);
+				stack.push_back(node.right);
+			}
+		}
+
+		record_query(start, visited);
+	}
+
+	void Bvh::query_overlap(const BoundingBox& box, std::vector<uint32_t>& objects) const {
+		auto start = Clock::now();
+		uint64_t visited = 0;
+		std::vector<uint32_t>& stack = get_traversal_stack();
+		if (m_root != BVH_NULL)
+			stack.push_back(m_root);
+
+		while (!stack.empty()) {
+			const BvhNode& node = m_nodes[stack.back()];
+			stack.pop_back();
+			visited++;
+
+			if (!overlaps(node.bounds, box))
+				continue;
+
+			if (node.is_leaf())
+				objects.push_back(node.object);
+			else {
+				stack.push_back(node.left);
+				stack.push_back(node.right);
+			}
+		}
+
+		record_query(start, visited);
+	}
+
+	bool Bvh::raycast(const Ray& ray, RayHit& hit, const RayIntersector& intersector) const {
+		auto start = Clock::now();
+		uint64_t visited = 0;
+		hit = RayHit();
+		hit.distance = ray.max_distance;
+
+		glm::vec3 inverse_direction = 1.0f / ray.direction;
+		std::vector<uint32_t>& stack = get_traversal_stack();
+		if (m_root != BVH_NULL && intersect_box(m_nodes[m_root].bounds, ray.origin, inverse_direction, hit.distance) != FLT_MAX)
+			stack.push_back(m_root);
+
+		while (!stack.empty()) {
+			const BvhNode& node = m_nodes[stack.back()];
+			stack.pop_back();
+			visited++;
+
+			if (node.is_leaf()) {
+				float distance = intersect_box(node.bounds, ray.origin, inverse_direction, hit.distance);
+				if (distance == FLT_MAX)
+					continue;
+				if (intersector && !intersector(node.object, ray, distance))
+					continue;
+				if (distance <= hit.distance) {
+					hit.distance = distance;
+					hit.object = node.object;
+				}
+				continue;
+			}
+
+			//Nearer child goes on top so it tightens the distance before the farther one is opened.
+			float left = intersect_box(m_nodes[node.left].bounds, ray.origin, inverse_direction, hit.distance);
+			float right = intersect_box(m_nodes[node.right].bounds, ray.origin, inverse_direction, hit.distance);
+			uint32_t near_child = (left <= right) ? node.left : node.right;
+			uint32_t far_child = (left <= right) ? node.right : node.left;
+			if (std::max(left, right) != FLT_MAX)
+				stack.push_back(far_child);
+			if (std::min(left, right) != FLT_MAX)
+				stack.push_back(near_child);
+		}
+
+		record_query(start, visited);
+		return hit.hit();
+	}
+
+	BvhStatistics Bvh::get_statistics() const {
+		BvhStatistics statistics = m_statistics;
+		statistics.query_ms = (float)m_query_ns.load(std::memory_order_relaxed) / 1000000.0f;
+		statistics.queries = m_queries.load(std::memory_order_relaxed);
+		statistics.nodes_visited = m_nodes_visited.load(std::memory_order_relaxed);
+		return statistics;
+	}
+
+	void Bvh::reset_query_statistics() const {
+		m_query_ns.store(0, std::memory_order_relaxed);
+		m_queries.store(0, std::memory_order_relaxed);
+		m_nodes_visited.store(0, std::memory_order_relaxed);
+	}
+
+	void Bvh::record_query(const std::chrono::high_resolution_clock::time_point& start, uint64_t visited) const {
+		uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+		m_query_ns.fetch_add(ns, std::memory_order_relaxed);
+		m_queries.fetch_add(1, std::memory_order_relaxed);
+		m_nodes_visited.fetch_add(visited, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,106 @@
+/**
+ * @file components.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the built in components and the systems that move
+ * them and feed them to the renderer.
+ */
+
+#include "components.h"
+#include "geometry.h"
+#include "allocation_tracker.h"
+
+namespace Fractal {
+	glm::mat4 Transform::get_matrix() const {
+		return Geometry::get_rotated_model_matrix(position, scale, orientation, degree);
+	}
+
+	Transform interpolate(const Transform& previous, const Transform& current, float alpha) {
+		Transform transform = current;
+		transform.position = glm::mix(previous.position, current.position, alpha);
+		transform.scale = glm::mix(previous.scale, current.scale, alpha);
+		if (previous.orientation == current.orientation)
+			transform.degree = glm::mix(previous.degree, current.degree, alpha);
+		return transform;
+	}
+
+	void update_motion(World& world, float delta) {
+		world.each<Velocity, Transform>([delta](Entity, Velocity& velocity, Transform& transform) {
+			velocity.linear += velocity.acceleration * delta;
+			transform.position += velocity.linear * delta;
+		});
+	}
+
+	SystemAccess get_motion_access() {
+		return SystemAccess().write<Velocity>().write<Transform>();
+	}
+
+	void store_previous_transforms(World& world, float) {
+		world.each<PreviousTransform, Transform>([](Entity, PreviousTransform& previous, Transform& transform) {
+			previous.transform = transform;
+		});
+	}
+
+	SystemAccess get_previous_transform_access() {
+		return SystemAccess().write<PreviousTransform>().read<Transform>();
+	}
+
+	void submit_renderable(RendererFrame* renderer, const Transform& transform, const Renderable& renderable) {
+		FRACTAL_ALLOCATION_SCOPE(Geometry);
+		float texture_id = renderable.texture ? renderer->get_graphics_device()->calculate_texture_index(renderable.texture) : -1.0f;
+		glm::mat4 model = transform.get_matrix();
+
+		switch (renderable.shape) {
+		case RenderableShape::Quad: {
+			Vertex vertices[QUAD_VERTEX_COUNT];
+			Geometry::create_geometry(vertices, model, renderable.color, texture_id, TEX_COORDS, QUAD_VERTEX_COUNT, QUAD_POSITIONS);
+			renderer->submit(vertices, QUAD_VERTEX_COUNT, quad_indices, QUAD_INDICES_COUNT);
+			break;
+		}
+		case RenderableShape::Cube: {
+			Vertex vertices[CUBE_VERTEX_COUNT];
+			Geometry::create_geometry(vertices, model, renderable.color, texture_id, CUBE_TEX_COORDS, CUBE_VERTEX_COUNT, CUBE_POSITIONS);
+			renderer->submit(vertices, CUBE_VERTEX_COUNT, cube_indices, CUBE_INDICES_COUNT);
+			break;
+		}
+		case RenderableShape::Mesh: {
+			if (!renderable.mesh || renderable.mesh->vertices.empty())
+				break;
+
+			//Reused between calls so only the largest mesh ever allocates.
+			static thread_local std::vector<Vertex> vertices;
+			vertices.assign(renderable.mesh->vertices.begin(), renderable.mesh->vertices.end());
+			//Vertex has no normal attribute, a direction added later needs the inverse transpose of model.
+			for (Vertex& vertex : vertices)
+				vertex.position = glm::vec3(model * glm::vec4(vertex.position, 1.0f));
+			renderer->submit(vertices.data(), (uint32_t)vertices.size(), renderable.mesh->indices.data(), (uint32_t)renderable.mesh->indices.size());
+			break;
+		}
+		}
+	}
+
+	void render_entities(World& world, RendererFrame* renderer, float alpha) {
+		ComponentStorage<PreviousTransform>& previous = world.storage<PreviousTransform>();
+		world.each<Renderable, Transform>([renderer, alpha, &previous](Entity entity, Renderable& renderable, Transform& transform) {
+			if (!renderable.visible)
+				return;
+
+			const PreviousTransform* last = previous.get(entity.index);
+			submit_renderable(renderer, last ? interpolate(last->transform, transform, alpha) : transform, renderable);
+		});
+	}
+
+	SystemAccess get_render_access() {
+		return SystemAccess().read<Renderable>().read<Transform>().read<PreviousTransform>().exclusive();
+	}
+}
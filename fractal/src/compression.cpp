@@ -0,0 +1,189 @@
+/**
+ * @file compression.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains a small LZ77 block compressor that writes the LZ4 block
+ * format. It favours decompression speed over ratio.
+ */
+
+#include "compression.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Fractal {
+	constexpr uint32_t MIN_MATCH = 4;
+	constexpr uint32_t LAST_LITERALS = 5;
+	constexpr uint32_t MATCH_FIND_LIMIT = 12;
+	constexpr uint32_t MAX_OFFSET = 65535;
+	constexpr uint32_t HASH_BITS = 12;
+
+	static uint32_t read32(const uint8_t* data) {
+		uint32_t value;
+		memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	static uint32_t hash(uint32_t sequence) {
+		return (sequence * 2654435761u) >> (32 - HASH_BITS);
+	}
+
+	static uint8_t* write_length(uint8_t* destination, uint32_t length) {
+		while (length >= 255) {
+			*destination++ = 255;
+			length -= 255;
+		}
+		*destination++ = (uint8_t)length;
+		return destination;
+	}
+
+	static uint8_t* write_sequence(uint8_t* destination, const uint8_t* destination_end, const uint8_t* literals, uint32_t literal_length, uint32_t offset, uint32_t match_length) {
+		//Worst case: token, literal length run, literals, offset and match length run.
+		uint32_t worst = 1 + literal_length / 255 + 1 + literal_length + 2 + match_length / 255 + 1;
+		if (destination + worst > destination_end)
+			return nullptr;
+
+		uint8_t* token = destination++;
+		*token = (uint8_t)(std::min(literal_length, 15u) << 4);
+		if (literal_length >= 15)
+			destination = write_length(destination, literal_length - 15);
+
+		if (literal_length > 0)
+			memcpy(destination, literals, literal_length);
+		destination += literal_length;
+
+		//The final sequence is literals only.
+		if (match_length == 0)
+			return destination;
+
+		*destination++ = (uint8_t)(offset & 0xFF);
+		*destination++ = (uint8_t)(offset >> 8);
+
+		match_length -= MIN_MATCH;
+		*token |= (uint8_t)std::min(match_length, 15u);
+		if (match_length >= 15)
+			destination = write_length(destination, match_length - 15);
+
+		return destination;
+	}
+
+	uint32_t get_compress_bound(uint32_t size) {
+		return size + size / 255 + 16;
+	}
+
+	uint32_t compress_block(const uint8_t* source, uint32_t size, uint8_t* destination, uint32_t capacity) {
+		int32_t table[1 << HASH_BITS];
+		std::fill(table, table + (1 << HASH_BITS), -1);
+
+		const uint8_t* position = source;
+		const uint8_t* anchor = source;
+		const uint8_t* end = source + size;
+		uint8_t* output = destination;
+		const uint8_t* output_end = destination + capacity;
+
+		while (size >= MATCH_FIND_LIMIT && position + MATCH_FIND_LIMIT <= end) {
+			uint32_t sequence = read32(position);
+			uint32_t h = hash(sequence);
+			int32_t candidate = table[h];
+			table[h] = (int32_t)(position - source);
+
+			//An empty slot must not form a pointer before the buffer.
+			if (candidate < 0 || (position - source) - candidate > MAX_OFFSET) {
+				position++;
+				continue;
+			}
+
+			const uint8_t* match = source + candidate;
+			if (read32(match) != sequence) {
+				position++;
+				continue;
+			}
+
+			uint32_t length = MIN_MATCH;
+			while (position + length < end - LAST_LITERALS && match[length] == position[length])
+				length++;
+
+			output = write_sequence(output, output_end, anchor, (uint32_t)(position - anchor), (uint32_t)(position - match), length);
+			if (!output)
+				return 0;
+
+			position += length;
+			anchor = position;
+		}
+
+		output = write_sequence(output, output_end, anchor, (uint32_t)(end - anchor), 0, 0);
+		return output ? (uint32_t)(output - destination) : 0;
+	}
+
+	bool decompress_block(const uint8_t* source, uint32_t size, uint8_t* destination, uint32_t decompressed_size) {
+		const uint8_t* input = source;
+		const uint8_t* input_end = source + size;
+		uint8_t* output = destination;
+		uint8_t* output_end = destination + decompressed_size;
+
+		while (input < input_end) {
+			uint8_t token = *input++;
+
+			uint32_t literal_length = token >> 4;
+			if (literal_length == 15) {
+				uint8_t byte;
+				do {
+					if (input >= input_end)
+						return false;
+					byte = *input++;
+					literal_length += byte;
+				} while (byte == 255);
+			}
+
+			if (literal_length > (uint32_t)(input_end - input) || literal_length > (uint32_t)(output_end - output))
+				return false;
+			if (literal_length > 0)
+				memcpy(output, input, literal_length);
+			input += literal_length;
+			output += literal_length;
+
+			if (input == input_end)
+				break;
+
+			if (input_end - input < 2)
+				return false;
+			uint32_t offset = input[0] | (input[1] << 8);
+			input += 2;
+			if (offset == 0 || offset > (uint32_t)(output - destination))
+				return false;
+
+			uint32_t match_length = token & 15;
+			if (match_length == 15) {
+				uint8_t byte;
+				do {
+					if (input >= input_end)
+						return false;
+					byte = *input++;
+					match_length += byte;
+				} while (byte == 255);
+			}
+			match_length += MIN_MATCH;
+
+			if (match_length > (uint32_t)(output_end - output))
+				return false;
+
+			//Matches may overlap their own output, so copy forward one byte at a time.
+			const uint8_t* match = output - offset;
+			for (uint32_t i = 0; i < match_length; i++)
+				output[i] = match[i];
+			output += match_length;
+		}
+
+		return output == output_end;
+	}
+}
@@ -0,0 +1,143 @@
+/**
+ * @file dynamic_resolution.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the dynamic resolution controller. The scene is drawn
+ * into a scaled region of an internal framebuffer and upscaled to the window.
+ */
+
+#include "dynamic_resolution.h"
+#include "renderer_commands.h"
+#include "log.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Fractal {
+	DynamicResolution::DynamicResolution(const DynamicResolutionSettings& settings) : m_settings(settings) {
+		m_upscale_shader.init("resources/shaders/upscale_shader.glsl");
+		m_vao = new VertexArray();
+		m_scale = m_settings.max_scale;
+
+		m_scale_history.resize(m_settings.history_size, m_scale);
+		m_gpu_time_history.resize(m_settings.history_size, 0.0f);
+	}
+
+	DynamicResolution::~DynamicResolution() {
+		delete m_vao;
+	}
+
+	void DynamicResolution::begin() {
+		if (!m_enabled)
+			return;
+
+		//Render relative to whatever target is bound, the window or an offline capture buffer.
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_target_id);
+		glGetIntegerv(GL_VIEWPORT, m_target_viewport);
+		uint32_t target_width = (uint32_t)m_target_viewport[2];
+		uint32_t target_height = (uint32_t)m_target_viewport[3];
+		if (target_width == 0 || target_height == 0)
+			return;
+
+		m_scale = std::min(std::max(m_scale, m_settings.min_scale), m_settings.max_scale);
+
+		uint32_t buffer_width = (uint32_t)std::ceil(target_width * m_settings.max_scale);
+		uint32_t buffer_height = (uint32_t)std::ceil(target_height * m_settings.max_scale);
+		m_frame_buffer.resize(buffer_width, buffer_height);
+
+		m_render_width = std::min(std::max((uint32_t)std::lround(target_width * m_scale), 1u), buffer_width);
+		m_render_height = std::min(std::max((uint32_t)std::lround(target_height * m_scale), 1u), buffer_height);
+
+		m_frame_buffer.bind();
+		RendererCommands::set_viewport(0, 0, m_render_width, m_render_height);
+		m_timer.begin();
+		m_in_frame = true;
+	}
+
+	void DynamicResolution::end() {
+		if (!m_in_frame)
+			return;
+
+		m_timer.end();
+		m_in_frame = false;
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_target_id);
+		RendererCommands::set_viewport(m_target_viewport[0], m_target_viewport[1], m_target_viewport[2], m_target_viewport[3]);
+		upscale();
+
+		update_scale();
+		record_history();
+	}
+
+	void DynamicResolution::update_scale() {
+		if (!m_timer.poll())
+			return;
+
+		float sample = m_timer.get_elapsed_ms();
+		m_smoothed_ms = (m_smoothed_ms == 0.0f) ? sample : m_smoothed_ms + (sample - m_smoothed_ms) * m_settings.smoothing;
+		if (m_smoothed_ms <= 0.0f)
+			return;
+
+		//Fragment cost scales with pixel count, which is the square of the scale.
+		float desired = m_scale * std::sqrt(m_settings.target_frame_ms / m_smoothed_ms);
+		float delta = desired - m_scale;
+		if (std::fabs(delta) < m_settings.dead_band)
+			return;
+
+		delta = std::min(std::max(delta, -m_settings.max_scale_down), m_settings.max_scale_up);
+		m_scale = std::min(std::max(m_scale + delta, m_settings.min_scale), m_settings.max_scale);
+	}
+
+	void DynamicResolution::record_history() {
+		if (m_scale_history.size() != m_settings.history_size) {
+			m_scale_history.assign(m_settings.history_size, m_scale);
+			m_gpu_time_history.assign(m_settings.history_size, m_smoothed_ms);
+			m_history_offset = 0;
+		}
+
+		if (m_scale_history.empty())
+			return;
+
+		m_scale_history[m_history_offset] = m_scale;
+		m_gpu_time_history[m_history_offset] = m_smoothed_ms;
+		m_history_offset = (m_history_offset + 1) % (uint32_t)m_scale_history.size();
+	}
+
+	void DynamicResolution::upscale() {
+		float buffer_width = (float)m_frame_buffer.get_width();
+		float buffer_height = (float)m_frame_buffer.get_height();
+
+		//Put back whatever the caller had instead of assuming both were on.
+		GLboolean depth_test = glIsEnabled(GL_DEPTH_TEST);
+		GLboolean blend = glIsEnabled(GL_BLEND);
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_BLEND);
+
+		m_upscale_shader.bind();
+		m_upscale_shader.set1i("u_filter", (int)m_settings.filter);
+		m_upscale_shader.set1f("u_sharpness", m_settings.sharpness);
+		m_upscale_shader.set_vec2f("u_uv_scale", { m_render_width / buffer_width, m_render_height / buffer_height });
+		m_upscale_shader.set_vec2f("u_uv_clamp", { (m_render_width - 0.5f) / buffer_width, (m_render_height - 0.5f) / buffer_height });
+		m_upscale_shader.set_vec2f("u_texel_size", { 1.0f / buffer_width, 1.0f / buffer_height });
+
+		glBindTextureUnit(0, m_frame_buffer.get_color_attachment());
+		m_vao->bind();
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+
+		if (blend)
+			glEnable(GL_BLEND);
+		if (depth_test)
+			glEnable(GL_DEPTH_TEST);
+	}
+}
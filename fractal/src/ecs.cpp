@@ -0,0 +1,194 @@
+/**
+ * @file ecs.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the entity bookkeeping of the world and the scheduler
+ * that runs systems without conflicting access in parallel.
+ */
+
+#include "ecs.h"
+#include "log.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cstdlib>
+
+namespace Fractal {
+	uint32_t next_component_id() {
+		static std::atomic<uint32_t> next_id(0);
+		uint32_t id = next_id++;
+		//Every access mask and storage lookup assumes the id fits, so stop here rather than throw somewhere later.
+		if (id >= MAX_COMPONENT_TYPES) {
+			FRACTAL_LOG_ERROR("More than %d component types, raise MAX_COMPONENT_TYPES.", MAX_COMPONENT_TYPES);
+			std::abort();
+		}
+		return id;
+	}
+
+	void report_dead_entity(Entity entity) {
+		FRACTAL_LOG_ERROR("Adding a component to destroyed entity %d (generation %d)", entity.index, entity.generation);
+	}
+
+	Entity World::create() {
+		uint32_t index;
+		if (!m_free.empty()) {
+			index = m_free.back();
+			m_free.pop_back();
+		}
+		else {
+			index = (uint32_t)m_slots.size();
+			m_slots.push_back(EntitySlot());
+		}
+
+		m_slots[index].alive = true;
+		m_alive++;
+		return get_entity(index);
+	}
+
+	void World::destroy(Entity entity) {
+		if (!alive(entity))
+			return;
+
+		for (auto& storage : m_storages)
+			if (storage)
+				storage->remove(entity.index);
+
+		EntitySlot& slot = m_slots[entity.index];
+		slot.alive = false;
+		if (++slot.generation == 0)
+			slot.generation = 1;
+		m_free.push_back(entity.index);
+		m_alive--;
+	}
+
+	void World::clear() {
+		for (auto& storage : m_storages)
+			if (storage)
+				storage->clear();
+
+		m_free.clear();
+		for (uint32_t i = 0; i < (uint32_t)m_slots.size(); i++) {
+			EntitySlot& slot = m_slots[i];
+			if (slot.alive && ++slot.generation == 0)
+				slot.generation = 1;
+			slot.alive = false;
+			m_free.push_back(i);
+		}
+		m_alive = 0;
+	}
+
+	bool SystemAccess::conflicts(const SystemAccess& other) const {
+		if (m_exclusive || other.m_exclusive)
+			return true;
+		return (m_writes & (other.m_writes | other.m_reads)).any() || (other.m_writes & m_reads).any();
+	}
+
+	void SystemScheduler::add(const std::string& name, const SystemAccess& access, const SystemFunction& update) {
+		System system;
+		system.name = name;
+		system.access = access;
+		system.update = update;
+		m_systems.push_back(system);
+		m_scheduled = false;
+	}
+
+	void SystemScheduler::schedule() {
+		m_batches.clear();
+		m_statistics.resize(m_systems.size());
+
+		//A system runs one batch after the latest earlier system it conflicts with.
+		std::vector<uint32_t> batch_of(m_systems.size(), 0);
+		for (uint32_t i = 0; i < (uint32_t)m_systems.size(); i++) {
+			uint32_t batch = 0;
+			for (uint32_t j = 0; j < i; j++)
+				if (m_systems[i].access.conflicts(m_systems[j].access))
+					batch = std::max(batch, batch_of[j] + 1);
+
+			batch_of[i] = batch;
+			if (batch >= m_batches.size())
+				m_batches.resize(batch + 1);
+			m_batches[batch].push_back(i);
+
+			m_statistics[i].name = m_systems[i].name;
+			m_statistics[i].batch = batch;
+		}
+
+		m_scheduled = true;
+	}
+
+	void SystemScheduler::run_system(uint32_t system, World& world, float delta) {
+		auto start = std::chrono::steady_clock::now();
+		m_systems[system].update(world, delta);
+		m_statistics[system].ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	void SystemScheduler::run(World& world, float delta, ThreadPool* pool) {
+		if (!m_scheduled)
+			schedule();
+
+		for (const std::vector<uint32_t>& batch : m_batches) {
+			if (!pool || batch.size() == 1) {
+				for (uint32_t system : batch)
+					run_system(system, world, delta);
+				continue;
+			}
+
+			std::mutex mutex;
+			std::condition_variable done;
+			uint32_t pending = (uint32_t)batch.size() - 1;
+
+			for (size_t i = 1; i < batch.size(); i++) {
+				uint32_t system = batch[i];
+				pool->submit([this, system, &world, delta, &mutex, &done, &pending]() {
+					run_system(system, world, delta);
+
+					std::lock_guard<std::mutex> lock(mutex);
+					if (--pending == 0)
+						done.notify_all();
+				});
+			}
+
+			//The calling thread takes a share instead of idling until the batch is done.
+			run_system(batch[0], world, delta);
+
+			std::unique_lock<std::mutex> lock(mutex);
+			done.wait(lock, [&pending] { return pending == 0; });
+		}
+	}
+
+	void SystemScheduler::run(World& world, float delta, JobSystem* jobs) {
+		if (!jobs) {
+			run(world, delta, (ThreadPool*)nullptr);
+			return;
+		}
+
+		if (!m_scheduled)
+			schedule();
+
+		for (const std::vector<uint32_t>& batch : m_batches) {
+			if (batch.size() == 1) {
+				run_system(batch[0], world, delta);
+				continue;
+			}
+
+			//The waiting thread runs jobs itself, so no worker sits idle on the batch.
+			JobCounter counter;
+			for (uint32_t system : batch)
+				jobs->run([this, system, &world, delta]() { run_system(system, world, delta); }, &counter);
+			jobs->wait(counter);
+		}
+	}
+}
@@ -0,0 +1,49 @@
+/**
+ * @file fence.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains a wrapper around OpenGL sync objects.
+ */
+
+#include "fence.h"
+#include <glad/glad.h>
+
+namespace Fractal {
+	Fence::~Fence() {
+		reset();
+	}
+
+	void Fence::insert() {
+		reset();
+		m_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	void Fence::reset() {
+		if (m_sync) {
+			glDeleteSync((GLsync)m_sync);
+			m_sync = nullptr;
+		}
+	}
+
+	bool Fence::signaled() {
+		return wait(0);
+	}
+
+	bool Fence::wait(uint64_t timeout_ns) {
+		if (!m_sync)
+			return true;
+
+		GLenum result = glClientWaitSync((GLsync)m_sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout_ns);
+		return (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED);
+	}
+}
@@ -19,8 +19,85 @@
 #include <vector>
 #include <iostream>
 #include "log.h"
+#include "allocation_tracker.h"
+#include "platform.h"
+
+#ifdef FRACTAL_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <cerrno>
+#endif
 
 namespace Fractal {
+    static void list_directory(const std::string& directory, bool recursive, std::vector<std::string>& files) {
+#ifdef FRACTAL_PLATFORM_WINDOWS
+        WIN32_FIND_DATAA data;
+        HANDLE find = FindFirstFileA((directory + "/*").c_str(), &data);
+        if (find == INVALID_HANDLE_VALUE)
+            return;
+
+        do {
+            std::string name = data.cFileName;
+            if (name == "." || name == "..")
+                continue;
+
+            std::string path = directory + "/" + name;
+            if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+                if (recursive)
+                    list_directory(path, recursive, files);
+            }
+            else
+                files.push_back(path);
+        } while (FindNextFileA(find, &data));
+        FindClose(find);
+#else
+        DIR* dir = opendir(directory.c_str());
+        if (!dir)
+            return;
+
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name == "." || name == "..")
+                continue;
+
+            std::string path = directory + "/" + name;
+            struct stat info;
+            if (stat(path.c_str(), &info) != 0)
+                continue;
+
+            if (S_ISDIR(info.st_mode)) {
+                if (recursive)
+                    list_directory(path, recursive, files);
+            }
+            else
+                files.push_back(path);
+        }
+        closedir(dir);
+#endif
+    }
+
+    std::vector<std::string> list_directory(const std::string& directory, bool recursive) {
+        FRACTAL_ALLOCATION_SCOPE(File);
+        std::vector<std::string> files;
+        list_directory(directory, recursive, files);
+        return files;
+    }
+
+    bool create_directory(const std::string& directory) {
+#ifdef FRACTAL_PLATFORM_WINDOWS
+        return CreateDirectoryA(directory.c_str(), nullptr) || GetLastError() == ERROR_ALREADY_EXISTS;
+#else
+        return mkdir(directory.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+    }
+
+    bool file_exists(const std::string& path) {
+        std::ifstream file(path);
+        return file.good();
+    }
+
     File::File(const std::string& filepath) : m_filepath(filepath) {
         open(m_filepath);
     }
@@ -52,6 +129,7 @@ namespace Fractal {
     }
 
     void File::open(const std::string& filepath) {
+        FRACTAL_ALLOCATION_SCOPE(File);
         m_file = std::fstream(filepath, std::fstream::in | std::fstream::out | std::fstream::app);
         m_filepath = filepath;
 
@@ -134,6 +212,7 @@ namespace Fractal {
     }
 
     std::string File::read() {
+        FRACTAL_ALLOCATION_SCOPE(File);
         reset();
 
         std::string buffer((std::istreambuf_iterator<char>(m_file)),
@@ -143,6 +222,7 @@ namespace Fractal {
     }
 
     std::string File::read_line(const uint32_t line_number) {
+        FRACTAL_ALLOCATION_SCOPE(File);
         reset();
 
         std::string line_search;
@@ -158,6 +238,7 @@ namespace Fractal {
     }
 
     std::string File::read_word(const uint32_t location) {
+        FRACTAL_ALLOCATION_SCOPE(File);
         reset();
 
         std::string word_search;
@@ -0,0 +1,59 @@
+/**
+ * @file fixed_timestep.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the accumulator that turns variable frame times
+ * into a fixed number of simulation ticks.
+ */
+
+#include "fixed_timestep.h"
+
+#include <algorithm>
+
+namespace Fractal {
+	FixedTimestep::FixedTimestep(const FixedTimestepSettings& settings) {
+		set_settings(settings);
+	}
+
+	uint32_t FixedTimestep::advance(float frame_time) {
+		m_accumulator += std::max(frame_time, 0.0f);
+
+		uint32_t steps = (uint32_t)(m_accumulator / m_step);
+		m_accumulator = std::min(std::max(m_accumulator - (float)steps * m_step, 0.0f), m_step * 0.999f);
+		m_statistics.dropped_ms = 0.0f;
+		if (steps > m_settings.max_steps) {
+			//Falling further behind every frame is worse than the simulation slowing down for a moment.
+			m_statistics.dropped_ms = (float)(steps - m_settings.max_steps) * m_step * 1000.0f;
+			m_statistics.dropped_frames++;
+			steps = m_settings.max_steps;
+		}
+
+		m_statistics.steps = steps;
+		m_statistics.alpha = get_alpha();
+		m_statistics.total_ticks += steps;
+		return steps;
+	}
+
+	void FixedTimestep::reset() {
+		m_accumulator = 0.0f;
+		m_statistics = FixedTimestepStatistics();
+	}
+
+	void FixedTimestep::set_settings(const FixedTimestepSettings& settings) {
+		m_settings = settings;
+		m_settings.tick_rate = std::max(m_settings.tick_rate, 1.0f);
+		m_settings.max_steps = std::max(m_settings.max_steps, 1u);
+		m_step = 1.0f / m_settings.tick_rate;
+		m_accumulator = std::min(m_accumulator, m_step * 0.999f);
+	}
+}
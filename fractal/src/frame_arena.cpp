@@ -0,0 +1,94 @@
+/**
+ * @file frame_arena.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains linear arenas for memory that only lives for a frame.
+ */
+
+#include "frame_arena.h"
+
+#include <algorithm>
+
+namespace Fractal {
+	static inline uint8_t* align_pointer(uint8_t* pointer, size_t alignment) {
+		return (uint8_t*)(((uintptr_t)pointer + alignment - 1) & ~(uintptr_t)(alignment - 1));
+	}
+
+	LinearArena::LinearArena(size_t capacity) : m_capacity(capacity) {
+		m_base = new uint8_t[m_capacity];
+		m_statistics.capacity = m_capacity;
+	}
+
+	LinearArena::~LinearArena() {
+		for (uint8_t* block : m_overflow)
+			delete[] block;
+		delete[] m_base;
+	}
+
+	void* LinearArena::allocate(size_t size, size_t alignment) {
+		m_statistics.allocations++;
+
+		uint8_t* pointer = align_pointer(m_base + m_offset, alignment);
+		size_t end = (size_t)(pointer - m_base) + size;
+		if (end <= m_capacity) {
+			m_statistics.used += end - m_offset;
+			m_offset = end;
+		}
+		else {
+			//Out of room, the heap covers the rest of the frame.
+			uint8_t* block = new uint8_t[size + alignment];
+			m_overflow.push_back(block);
+			pointer = align_pointer(block, alignment);
+			m_statistics.used += size + alignment;
+			m_statistics.overflows++;
+		}
+
+		m_statistics.peak = std::max(m_statistics.peak, m_statistics.used);
+		return pointer;
+	}
+
+	void LinearArena::reset() {
+		if (!m_overflow.empty()) {
+			for (uint8_t* block : m_overflow)
+				delete[] block;
+			m_overflow.clear();
+
+			//Grow so a frame like this one fits without touching the heap.
+			m_capacity = std::max(m_capacity * 2, m_statistics.used);
+			delete[] m_base;
+			m_base = new uint8_t[m_capacity];
+		}
+
+		m_last_statistics = m_statistics;
+		size_t peak = m_statistics.peak;
+		m_statistics = ArenaStatistics();
+		m_statistics.capacity = m_capacity;
+		m_statistics.peak = peak;
+		m_offset = 0;
+	}
+
+	DoubleBufferedArena::DoubleBufferedArena(size_t capacity) : m_first(capacity), m_second(capacity) {
+		m_arenas[0] = &m_first;
+		m_arenas[1] = &m_second;
+	}
+
+	void DoubleBufferedArena::swap() {
+		m_index ^= 1;
+		m_arenas[m_index]->reset();
+	}
+
+	DoubleBufferedArena& get_frame_arenas() {
+		static DoubleBufferedArena arenas;
+		return arenas;
+	}
+}
@@ -17,26 +17,43 @@
 
 #include "frame_buffer.h"
 #include "log.h"
+#include "gpu_resources.h"
 
 #include <iostream>
 #include <glad/glad.h>
 
 namespace Fractal {
-	FrameBuffer::FrameBuffer(uint32_t width, uint32_t height) {
+	FrameBuffer::FrameBuffer(uint32_t width, uint32_t height, FrameBufferFormat format) : m_format(format) {
+		m_handle = register_gpu_resource(this);
 		init(width, height);
 	}
 
+	FrameBuffer::FrameBuffer(FrameBufferFormat format) : m_format(format) {
+		m_handle = register_gpu_resource(this);
+	}
+
 	void FrameBuffer::init(uint32_t width, uint32_t height) {
+		m_width = width;
+		m_height = height;
+
 		glGenFramebuffers(1, &m_frame_buffer_id);
 		bind();
 
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_color_attachment);
 		glBindTexture(GL_TEXTURE_2D, m_color_attachment);
 
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		GLenum color_format = GL_RGBA8;
+		if (m_format == FrameBufferFormat::R32UI) {
+			color_format = GL_R32UI;
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, width, height, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		}
+		else {
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		}
 
 		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_color_attachment, 0);
 
@@ -53,6 +70,9 @@ namespace Fractal {
 
 		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, m_depth_stencil_attachment, 0);
 
+		register_gpu_allocation(GpuResourceType::Texture, m_color_attachment, GpuMemoryCategory::FrameBuffer, (uint64_t)width * height * 4, color_format, "Frame Buffer Color");
+		register_gpu_allocation(GpuResourceType::Texture, m_depth_stencil_attachment, GpuMemoryCategory::FrameBuffer, (uint64_t)width * height * 4, GL_DEPTH24_STENCIL8, "Frame Buffer Depth Stencil");
+
 		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 			FRACTAL_LOG_ERROR("Failed to load framebuffer.");
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -60,10 +80,29 @@ namespace Fractal {
 		unbind();
 	}
 
+	void FrameBuffer::resize(uint32_t width, uint32_t height) {
+		if (width == m_width && height == m_height)
+			return;
+
+		destroy();
+		init(width, height);
+	}
+
+	void FrameBuffer::destroy() {
+		destroy_gpu_resource(GpuResourceType::FrameBuffer, m_frame_buffer_id);
+		destroy_gpu_resource(GpuResourceType::Texture, m_color_attachment);
+		destroy_gpu_resource(GpuResourceType::Texture, m_depth_stencil_attachment);
+
+		m_frame_buffer_id = 0;
+		m_color_attachment = 0;
+		m_depth_stencil_attachment = 0;
+		m_width = 0;
+		m_height = 0;
+	}
+
 	FrameBuffer::~FrameBuffer() {
-		glDeleteFramebuffers(1, &m_frame_buffer_id);
-		glDeleteTextures(1, &m_color_attachment);
-		glDeleteTextures(1, &m_depth_stencil_attachment);
+		unregister_gpu_resource(m_handle);
+		destroy();
 	}
 
 	void FrameBuffer::bind() {
@@ -74,6 +113,10 @@ namespace Fractal {
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	}
 
+	void FrameBuffer::blit_to(FrameBuffer* target, uint32_t width, uint32_t height) {
+		glBlitNamedFramebuffer(m_frame_buffer_id, target ? target->get_id() : 0, 0, 0, m_width, m_height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+	}
+
 	RenderBuffer::RenderBuffer(uint32_t width, uint32_t height) {
 		init(width, height);
 	}
@@ -82,6 +125,7 @@ namespace Fractal {
 		glGenRenderbuffers(1, &m_rbo);
 		glBindRenderbuffer(GL_RENDERBUFFER, m_rbo);
 		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+		register_gpu_allocation(GpuResourceType::RenderBuffer, m_rbo, GpuMemoryCategory::FrameBuffer, (uint64_t)width * height * 4, GL_DEPTH24_STENCIL8, "Render Buffer Depth Stencil");
 		glBindRenderbuffer(GL_RENDERBUFFER, 0);
 
 		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_rbo);
@@ -0,0 +1,153 @@
+/**
+ * @file frame_pacer.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the frame limiter and the low latency wait that
+ * delays input sampling until just before the frame deadline.
+ */
+
+#include "frame_pacer.h"
+#include "platform.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <cmath>
+
+#ifdef FRACTAL_PLATFORM_WINDOWS
+#include <windows.h>
+#include <mmsystem.h>
+#endif
+
+namespace Fractal {
+	constexpr float FRAME_PACER_SMOOTHING = 0.1f;
+	constexpr float FRAME_PACER_MISSED_RATIO = 1.5f;
+
+	static double get_time_ms() {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	FramePacer::FramePacer(const FramePacerSettings& settings) : m_history(FRAME_PACER_HISTORY_SIZE, 0.0f) {
+#ifdef FRACTAL_PLATFORM_WINDOWS
+		//The default scheduler tick is around 15 ms, far too coarse to sleep through part of a frame.
+		timeBeginPeriod(1);
+#endif
+		set_settings(settings);
+	}
+
+	FramePacer::~FramePacer() {
+#ifdef FRACTAL_PLATFORM_WINDOWS
+		timeEndPeriod(1);
+#endif
+	}
+
+	void FramePacer::end_work() {
+		if (m_begin > 0.0)
+			m_statistics.work_ms += ((float)(get_time_ms() - m_begin) - m_statistics.work_ms) * FRAME_PACER_SMOOTHING;
+	}
+
+	void FramePacer::end_frame() {
+		double now = get_time_ms();
+
+		m_statistics.sleep_ms = 0.0f;
+		m_statistics.spin_ms = 0.0f;
+		if (m_settings.target_fps > 0.0f) {
+			double period = 1000.0 / m_settings.target_fps;
+			if (m_deadline > now)
+				wait_until(m_deadline, m_statistics.sleep_ms, m_statistics.spin_ms);
+			now = get_time_ms();
+
+			//Stepping from the last deadline keeps the average rate exact, a late frame starts over from now.
+			m_deadline = (now - m_deadline < period) ? m_deadline + period : now + period;
+		}
+
+		if (m_last_present > 0.0)
+			record_frame((float)(now - m_last_present));
+		m_last_present = now;
+	}
+
+	void FramePacer::begin_frame() {
+		m_statistics.latency_wait_ms = 0.0f;
+		float period = get_period();
+		if (m_settings.low_latency && period > 0.0f && m_last_present > 0.0) {
+			//Vsync presents at the next refresh after the last one, the limiter at its own deadline.
+			double deadline = (m_settings.target_fps > 0.0f) ? m_deadline : m_last_present + period * 1000.0;
+			double start = deadline - m_statistics.work_ms - m_settings.latency_margin_ms;
+			float spin_ms = 0.0f;
+			if (start > get_time_ms())
+				wait_until(start, m_statistics.latency_wait_ms, spin_ms);
+			m_statistics.latency_wait_ms += spin_ms;
+		}
+		m_begin = get_time_ms();
+	}
+
+	void FramePacer::set_settings(const FramePacerSettings& settings) {
+		m_settings = settings;
+		m_settings.target_fps = std::max(m_settings.target_fps, 0.0f);
+		m_settings.spin_ms = std::max(m_settings.spin_ms, 0.0f);
+		m_settings.latency_margin_ms = std::max(m_settings.latency_margin_ms, 0.0f);
+		m_deadline = 0.0;
+	}
+
+	float FramePacer::get_period() const {
+		if (m_settings.target_fps > 0.0f)
+			return 1.0f / m_settings.target_fps;
+		if (m_settings.vsync != VsyncMode::Off && m_refresh_rate > 0.0f)
+			return 1.0f / m_refresh_rate;
+		return 0.0f;
+	}
+
+	void FramePacer::wait_until(double target_ms, float& sleep_ms, float& spin_ms) {
+		double start = get_time_ms();
+		double remaining = target_ms - start;
+		if (remaining > m_settings.spin_ms)
+			std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(remaining - m_settings.spin_ms));
+
+		double slept = get_time_ms();
+		while (get_time_ms() < target_ms)
+			std::this_thread::yield();
+
+		sleep_ms = (float)(slept - start);
+		spin_ms = (float)(get_time_ms() - slept);
+	}
+
+	void FramePacer::record_frame(float frame_ms) {
+		m_history[m_history_offset] = frame_ms;
+		m_history_offset = (m_history_offset + 1) % FRAME_PACER_HISTORY_SIZE;
+		m_history_count = std::min(m_history_count + 1, FRAME_PACER_HISTORY_SIZE);
+
+		float period = get_period();
+		if (period > 0.0f && frame_ms > period * 1000.0f * FRAME_PACER_MISSED_RATIO)
+			m_statistics.missed_deadlines++;
+
+		float sum = 0.0f;
+		float min_ms = frame_ms;
+		float max_ms = frame_ms;
+		for (uint32_t i = 0; i < m_history_count; i++) {
+			sum += m_history[i];
+			min_ms = std::min(min_ms, m_history[i]);
+			max_ms = std::max(max_ms, m_history[i]);
+		}
+		float average = sum / (float)m_history_count;
+
+		float variance = 0.0f;
+		for (uint32_t i = 0; i < m_history_count; i++)
+			variance += (m_history[i] - average) * (m_history[i] - average);
+
+		m_statistics.frame_ms = frame_ms;
+		m_statistics.average_frame_ms = average;
+		m_statistics.jitter_ms = std::sqrt(variance / (float)m_history_count);
+		m_statistics.min_frame_ms = min_ms;
+		m_statistics.max_frame_ms = max_ms;
+	}
+}
@@ -0,0 +1,88 @@
+/**
+ * @file frame_sync.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the fences that limit how many frames the CPU
+ * records ahead of the GPU.
+ */
+
+#include "frame_sync.h"
+#include "log.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Fractal {
+	constexpr uint64_t FRAME_SYNC_TIMEOUT_NS = 1000000000;
+	constexpr float FRAME_SYNC_SMOOTHING = 0.1f;
+	//Waiting longer than this share of the frame means the GPU is the bottleneck.
+	constexpr float FRAME_SYNC_GPU_BOUND_RATIO = 0.1f;
+
+	static double get_time_ms() {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	FrameSync::FrameSync(uint32_t frames_in_flight) {
+		set_frames_in_flight(frames_in_flight);
+	}
+
+	void FrameSync::begin_frame() {
+		double start = get_time_ms();
+		if (m_last_begin > 0.0) {
+			float frame_ms = (float)(start - m_last_begin);
+			m_statistics.average_frame_ms += (frame_ms - m_statistics.average_frame_ms) * FRAME_SYNC_SMOOTHING;
+		}
+		m_last_begin = start;
+
+		Fence& fence = m_fences[m_frame_index];
+		m_statistics.wait_ms = 0.0f;
+		if (fence.is_active()) {
+			if (!fence.signaled()) {
+				if (!fence.wait(FRAME_SYNC_TIMEOUT_NS))
+					FRACTAL_LOG_WARNING("Timed out waiting on the GPU for frame slot %d", m_frame_index);
+				m_statistics.wait_ms = (float)(get_time_ms() - start);
+				m_statistics.waits++;
+			}
+			fence.reset();
+		}
+
+		m_statistics.average_wait_ms += (m_statistics.wait_ms - m_statistics.average_wait_ms) * FRAME_SYNC_SMOOTHING;
+		m_statistics.gpu_bound = (m_statistics.average_wait_ms > m_statistics.average_frame_ms * FRAME_SYNC_GPU_BOUND_RATIO);
+	}
+
+	void FrameSync::end_frame() {
+		m_fences[m_frame_index].insert();
+		m_frame_index = (m_frame_index + 1) % m_frames_in_flight;
+	}
+
+	void FrameSync::reset() {
+		for (Fence& fence : m_fences) {
+			fence.wait(FRAME_SYNC_TIMEOUT_NS);
+			fence.reset();
+		}
+		m_frame_index = 0;
+	}
+
+	void FrameSync::set_frames_in_flight(uint32_t frames_in_flight) {
+		frames_in_flight = std::max(1u, std::min(frames_in_flight, MAX_FRAMES_IN_FLIGHT));
+		if (frames_in_flight == m_frames_in_flight && m_statistics.frames_in_flight != 0)
+			return;
+
+		//Slots past the new count would never be waited on again.
+		if (m_frames_in_flight > frames_in_flight)
+			reset();
+		m_frames_in_flight = frames_in_flight;
+		m_frame_index %= m_frames_in_flight;
+		m_statistics.frames_in_flight = m_frames_in_flight;
+	}
+}
@@ -36,7 +36,7 @@ namespace Fractal {
 
         glfwMakeContextCurrent(m_window);
         gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
-        glfwSwapInterval(1);
+        set_vsync(VsyncMode::On);
 
         glfwSetWindowUserPointer(m_window, &m_event_callback);
 
@@ -102,10 +102,37 @@ namespace Fractal {
     }
 
     void GLFWWindow::update() {
+        swap_buffers();
+        poll_events();
+    }
+
+    void GLFWWindow::swap_buffers() {
         glfwSwapBuffers(m_window);
+    }
+
+    void GLFWWindow::poll_events() {
         glfwPollEvents();
     }
 
+    VsyncMode GLFWWindow::set_vsync(VsyncMode mode) {
+        if (mode == VsyncMode::Adaptive && !glfwExtensionSupported("WGL_EXT_swap_control_tear") && !glfwExtensionSupported("GLX_EXT_swap_control_tear")) {
+            FRACTAL_LOG_WARNING("Adaptive vsync is not supported, using vsync instead");
+            mode = VsyncMode::On;
+        }
+
+        //A negative interval is the swap control tear extension.
+        glfwSwapInterval((mode == VsyncMode::Adaptive) ? -1 : (mode == VsyncMode::On) ? 1 : 0);
+        return mode;
+    }
+
+    float GLFWWindow::get_refresh_rate() {
+        GLFWmonitor* monitor = glfwGetWindowMonitor(m_window);
+        if (!monitor)
+            monitor = glfwGetPrimaryMonitor();
+        const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+        return mode ? (float)mode->refreshRate : 0.0f;
+    }
+
     void error_callback(int error, const char* description) {
         fprintf(stderr, "glfw error: %s.\n", description);
     }
@@ -0,0 +1,695 @@
+/**
+ * @file gltf_importer.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the glTF 2.0 importer for both .gltf and .glb files.
+ * The scene graph is flattened into one model, every mesh primitive is
+ * decoded and transformed in parallel and then appended in scene order.
+ */
+
+#include "model.h"
+#include "mesh_optimizer.h"
+#include "mapped_file.h"
+#include "log.h"
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <memory>
+
+namespace Fractal {
+	constexpr uint32_t GLB_MAGIC = 0x46546C67;
+	constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+	constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;
+	constexpr uint32_t GLTF_MAX_DEPTH = 256;
+
+	struct JsonValue {
+		enum Type { Null, Bool, Number, String, Array, Object };
+
+		Type type = Null;
+		bool boolean = false;
+		double number = 0.0;
+		std::string string;
+		std::vector<std::string> keys;
+		std::vector<JsonValue> elements;
+
+		const JsonValue& operator[](const char* key) const {
+			static const JsonValue null_value;
+			for (size_t i = 0; i < keys.size(); i++) {
+				if (keys[i] == key)
+					return elements[i];
+			}
+			return null_value;
+		}
+
+		const JsonValue& operator[](size_t index) const {
+			static const JsonValue null_value;
+			return (type == Array && index < elements.size()) ? elements[index] : null_value;
+		}
+
+		inline const JsonValue& operator[](int index) const { return (*this)[(size_t)index]; }
+
+		inline bool is_null() const { return type == Null; }
+		inline size_t size() const { return (type == Array) ? elements.size() : 0; }
+		inline double get_number(double fallback) const { return (type == Number) ? number : fallback; }
+		inline int64_t get_index() const { return (type == Number) ? (int64_t)number : -1; }
+	};
+
+	class JsonParser {
+	public:
+		JsonParser(const char* begin, const char* end) : m_p(begin), m_end(end) { }
+
+		bool parse(JsonValue& value) {
+			return parse_value(value, 0) && (skip_spaces(), m_p == m_end);
+		}
+	private:
+		void skip_spaces() {
+			while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\n' || *m_p == '\r'))
+				m_p++;
+		}
+
+		bool match(const char* literal) {
+			size_t length = strlen(literal);
+			if ((size_t)(m_end - m_p) < length || memcmp(m_p, literal, length) != 0)
+				return false;
+			m_p += length;
+			return true;
+		}
+
+		bool parse_value(JsonValue& value, uint32_t depth) {
+			skip_spaces();
+			if (m_p >= m_end || depth > GLTF_MAX_DEPTH)
+				return false;
+
+			switch (*m_p) {
+			case '{': return parse_object(value, depth);
+			case '[': return parse_array(value, depth);
+			case '"': value.type = JsonValue::String; return parse_string(value.string);
+			case 't': value.type = JsonValue::Bool; value.boolean = true; return match("true");
+			case 'f': value.type = JsonValue::Bool; return match("false");
+			case 'n': return match("null");
+			default: return parse_number(value);
+			}
+		}
+
+		bool parse_object(JsonValue& value, uint32_t depth) {
+			value.type = JsonValue::Object;
+			m_p++;
+			skip_spaces();
+			if (m_p < m_end && *m_p == '}')
+				return ++m_p, true;
+
+			while (true) {
+				skip_spaces();
+				value.keys.emplace_back();
+				value.elements.emplace_back();
+				if (m_p >= m_end || *m_p != '"' || !parse_string(value.keys.back()))
+					return false;
+
+				skip_spaces();
+				if (m_p >= m_end || *m_p++ != ':' || !parse_value(value.elements.back(), depth + 1))
+					return false;
+
+				skip_spaces();
+				if (m_p < m_end && *m_p == ',')
+					m_p++;
+				else
+					return m_p < m_end && *m_p++ == '}';
+			}
+		}
+
+		bool parse_array(JsonValue& value, uint32_t depth) {
+			value.type = JsonValue::Array;
+			m_p++;
+			skip_spaces();
+			if (m_p < m_end && *m_p == ']')
+				return ++m_p, true;
+
+			while (true) {
+				value.elements.emplace_back();
+				if (!parse_value(value.elements.back(), depth + 1))
+					return false;
+
+				skip_spaces();
+				if (m_p < m_end && *m_p == ',')
+					m_p++;
+				else
+					return m_p < m_end && *m_p++ == ']';
+			}
+		}
+
+		bool parse_hex(uint32_t& code) {
+			if (m_end - m_p < 4)
+				return false;
+
+			code = 0;
+			for (int i = 0; i < 4; i++) {
+				char c = *m_p++;
+				code <<= 4;
+				if (c >= '0' && c <= '9') code |= c - '0';
+				else if (c >= 'a' && c <= 'f') code |= c - 'a' + 10;
+				else if (c >= 'A' && c <= 'F') code |= c - 'A' + 10;
+				else return false;
+			}
+			return true;
+		}
+
+		bool parse_string(std::string& string) {
+			m_p++;
+			while (m_p < m_end && *m_p != '"') {
+				if (*m_p != '\\') {
+					string += *m_p++;
+					continue;
+				}
+
+				if (++m_p >= m_end)
+					return false;
+
+				char escape = *m_p++;
+				switch (escape) {
+				case 'b': string += '\b'; break;
+				case 'f': string += '\f'; break;
+				case 'n': string += '\n'; break;
+				case 'r': string += '\r'; break;
+				case 't': string += '\t'; break;
+				case 'u': {
+					uint32_t code;
+					if (!parse_hex(code))
+						return false;
+
+					//Surrogate pairs encode code points outside the basic plane.
+					uint32_t low;
+					if (code >= 0xD800 && code <= 0xDBFF && match("\\u") && parse_hex(low))
+						code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+
+					if (code < 0x80)
+						string += (char)code;
+					else if (code < 0x800) {
+						string += (char)(0xC0 | (code >> 6));
+						string += (char)(0x80 | (code & 0x3F));
+					}
+					else if (code < 0x10000) {
+						string += (char)(0xE0 | (code >> 12));
+						string += (char)(0x80 | ((code >> 6) & 0x3F));
+						string += (char)(0x80 | (code & 0x3F));
+					}
+					else {
+						string += (char)(0xF0 | (code >> 18));
+						string += (char)(0x80 | ((code >> 12) & 0x3F));
+						string += (char)(0x80 | ((code >> 6) & 0x3F));
+						string += (char)(0x80 | (code & 0x3F));
+					}
+					break;
+				}
+				default: string += escape; break;
+				}
+			}
+			return m_p < m_end && *m_p++ == '"';
+		}
+
+		bool parse_number(JsonValue& value) {
+			char buffer[64];
+			size_t length = 0;
+			while (m_p < m_end && length < sizeof(buffer) - 1 && strchr("+-0123456789.eE", *m_p))
+				buffer[length++] = *m_p++;
+			buffer[length] = '\0';
+
+			char* end = nullptr;
+			value.type = JsonValue::Number;
+			value.number = strtod(buffer, &end);
+			return length > 0 && end == buffer + length;
+		}
+	private:
+		const char* m_p;
+		const char* m_end;
+	};
+
+	struct GltfBuffer {
+		const uint8_t* data = nullptr;
+		uint64_t size = 0;
+	};
+
+	struct GltfAccessor {
+		const uint8_t* data = nullptr;
+		uint32_t count = 0;
+		uint32_t components = 0;
+		uint32_t component_type = 0;
+		uint32_t stride = 0;
+		bool normalized = false;
+	};
+
+	struct GltfPrimitiveJob {
+		const JsonValue* primitive = nullptr;
+		glm::mat4 transform = glm::mat4(1.0f);
+		std::string name;
+		uint32_t material = 0;
+		Model part;
+		const char* error = nullptr;
+		bool skipped = false;
+	};
+
+	static uint32_t get_component_size(uint32_t component_type) {
+		switch (component_type) {
+		case 5120: case 5121: return 1;
+		case 5122: case 5123: return 2;
+		case 5125: case 5126: return 4;
+		default: return 0;
+		}
+	}
+
+	static uint32_t get_component_count(const std::string& type) {
+		if (type == "SCALAR") return 1;
+		if (type == "VEC2") return 2;
+		if (type == "VEC3") return 3;
+		if (type == "VEC4") return 4;
+		return 0;
+	}
+
+	static float read_component(const uint8_t* data, uint32_t component_type, bool normalized) {
+		switch (component_type) {
+		case 5120: { int8_t v; memcpy(&v, data, 1); return normalized ? std::max(v / 127.0f, -1.0f) : (float)v; }
+		case 5121: { uint8_t v = *data; return normalized ? v / 255.0f : (float)v; }
+		case 5122: { int16_t v; memcpy(&v, data, 2); return normalized ? std::max(v / 32767.0f, -1.0f) : (float)v; }
+		case 5123: { uint16_t v; memcpy(&v, data, 2); return normalized ? v / 65535.0f : (float)v; }
+		case 5125: { uint32_t v; memcpy(&v, data, 4); return (float)v; }
+		case 5126: { float v; memcpy(&v, data, 4); return v; }
+		default: return 0.0f;
+		}
+	}
+
+	static uint32_t read_index(const uint8_t* data, uint32_t component_type) {
+		switch (component_type) {
+		case 5121: return *data;
+		case 5123: { uint16_t v; memcpy(&v, data, 2); return v; }
+		case 5125: { uint32_t v; memcpy(&v, data, 4); return v; }
+		default: return 0;
+		}
+	}
+
+	static glm::vec4 read_vector(const GltfAccessor& accessor, uint32_t index, float w) {
+		glm::vec4 result(0.0f, 0.0f, 0.0f, w);
+		const uint8_t* element = accessor.data + (uint64_t)index * accessor.stride;
+		uint32_t size = get_component_size(accessor.component_type);
+		for (uint32_t i = 0; i < accessor.components && i < 4; i++)
+			result[i] = read_component(element + i * size, accessor.component_type, accessor.normalized);
+		return result;
+	}
+
+	static bool get_accessor(const JsonValue& gltf, const std::vector<GltfBuffer>& buffers, int64_t index, GltfAccessor& accessor) {
+		const JsonValue& json = gltf["accessors"][(size_t)index];
+		const JsonValue& view = gltf["bufferViews"][(size_t)json["bufferView"].get_index()];
+		if (index < 0 || json.is_null() || view.is_null())
+			return false;
+
+		int64_t buffer_index = view["buffer"].get_index();
+		if (buffer_index < 0 || buffer_index >= (int64_t)buffers.size())
+			return false;
+
+		const GltfBuffer& buffer = buffers[(size_t)buffer_index];
+		accessor.count = (uint32_t)json["count"].get_number(0);
+		accessor.components = get_component_count(json["type"].string);
+		accessor.component_type = (uint32_t)json["componentType"].get_number(0);
+		accessor.normalized = json["normalized"].boolean;
+
+		uint32_t element_size = accessor.components * get_component_size(accessor.component_type);
+		accessor.stride = (uint32_t)view["byteStride"].get_number(element_size);
+		if (element_size == 0 || accessor.stride < element_size)
+			return false;
+
+		uint64_t view_offset = (uint64_t)view["byteOffset"].get_number(0);
+		uint64_t view_length = (uint64_t)view["byteLength"].get_number(0);
+		uint64_t offset = (uint64_t)json["byteOffset"].get_number(0);
+		if (view_offset + view_length > buffer.size)
+			return false;
+		if (accessor.count > 0 && offset + (uint64_t)accessor.stride * (accessor.count - 1) + element_size > view_length)
+			return false;
+
+		accessor.data = buffer.data + view_offset + offset;
+		return true;
+	}
+
+	static bool decode_base64(const char* begin, const char* end, std::vector<uint8_t>& data) {
+		uint32_t bits = 0, count = 0;
+		for (const char* p = begin; p < end && *p != '='; p++) {
+			char c = *p;
+			uint32_t value;
+			if (c >= 'A' && c <= 'Z') value = c - 'A';
+			else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+			else if (c >= '0' && c <= '9') value = c - '0' + 52;
+			else if (c == '+') value = 62;
+			else if (c == '/') value = 63;
+			else return false;
+
+			bits = (bits << 6) | value;
+			if ((count += 6) >= 8) {
+				count -= 8;
+				data.push_back((uint8_t)(bits >> count));
+			}
+		}
+		return true;
+	}
+
+	static std::string decode_uri(const std::string& uri) {
+		std::string result;
+		for (size_t i = 0; i < uri.size(); i++) {
+			if (uri[i] == '%' && i + 2 < uri.size()) {
+				result += (char)strtol(uri.substr(i + 1, 2).c_str(), nullptr, 16);
+				i += 2;
+			}
+			else
+				result += uri[i];
+		}
+		return result;
+	}
+
+	static glm::mat4 get_node_transform(const JsonValue& node) {
+		const JsonValue& matrix = node["matrix"];
+		if (matrix.size() == 16) {
+			glm::mat4 result;
+			for (int i = 0; i < 16; i++)
+				result[i / 4][i % 4] = (float)matrix[i].number;
+			return result;
+		}
+
+		const JsonValue& t = node["translation"];
+		const JsonValue& r = node["rotation"];
+		const JsonValue& s = node["scale"];
+
+		glm::mat4 result(1.0f);
+		if (t.size() == 3)
+			result = glm::translate(result, glm::vec3(t[0].number, t[1].number, t[2].number));
+		if (r.size() == 4)
+			result *= glm::mat4_cast(glm::quat((float)r[3].number, (float)r[0].number, (float)r[1].number, (float)r[2].number));
+		if (s.size() == 3)
+			result = glm::scale(result, glm::vec3(s[0].number, s[1].number, s[2].number));
+		return result;
+	}
+
+	static void decode_primitive(const JsonValue& gltf, const std::vector<GltfBuffer>& buffers, GltfPrimitiveJob& job, bool generate) {
+		const JsonValue& primitive = *job.primitive;
+		const JsonValue& attributes = primitive["attributes"];
+		uint32_t mode = (uint32_t)primitive["mode"].get_number(4);
+
+		//Points and lines have no use in a triangle mesh.
+		if (mode < 4 || mode > 6) {
+			job.skipped = true;
+			return;
+		}
+
+		GltfAccessor positions, normals, uvs, colors, indices;
+		if (!get_accessor(gltf, buffers, attributes["POSITION"].get_index(), positions) || positions.components != 3) {
+			job.error = "primitive has no valid POSITION accessor";
+			return;
+		}
+
+		bool has_normals = get_accessor(gltf, buffers, attributes["NORMAL"].get_index(), normals) && normals.count == positions.count;
+		bool has_uvs = get_accessor(gltf, buffers, attributes["TEXCOORD_0"].get_index(), uvs) && uvs.count == positions.count;
+		bool has_colors = get_accessor(gltf, buffers, attributes["COLOR_0"].get_index(), colors) && colors.count == positions.count;
+
+		glm::mat3 normal_matrix = glm::transpose(glm::inverse(glm::mat3(job.transform)));
+		Model& part = job.part;
+		part.vertices.resize(positions.count);
+		for (uint32_t i = 0; i < positions.count; i++) {
+			ModelVertex& vertex = part.vertices[i];
+			vertex.position = glm::vec3(job.transform * read_vector(positions, i, 1.0f));
+			vertex.color = has_colors ? read_vector(colors, i, 1.0f) : glm::vec4(1.0f);
+
+			//glTF puts the texture origin at the top left, textures are flipped on load.
+			glm::vec4 uv = has_uvs ? read_vector(uvs, i, 0.0f) : glm::vec4(0.0f, 1.0f, 0.0f, 0.0f);
+			vertex.texture_coordinates = glm::vec2(uv.x, 1.0f - uv.y);
+			vertex.texture_id = 0.0f;
+			vertex.material_id = (float)job.material;
+
+			//Zero length normals show up in real files, normalizing them would write NaN.
+			glm::vec3 normal = has_normals ? normal_matrix * glm::vec3(read_vector(normals, i, 0.0f)) : glm::vec3(0.0f);
+			float length = glm::length(normal);
+			vertex.normals = (length > 0.0f) ? normal / length : glm::vec3(0.0f);
+		}
+
+		std::vector<uint32_t> elements;
+		if (primitive["indices"].is_null()) {
+			elements.resize(positions.count);
+			for (uint32_t i = 0; i < positions.count; i++)
+				elements[i] = i;
+		}
+		else {
+			if (!get_accessor(gltf, buffers, primitive["indices"].get_index(), indices) || indices.components != 1 || indices.component_type == 5126) {
+				job.error = "primitive has an invalid index accessor";
+				return;
+			}
+
+			elements.resize(indices.count);
+			for (uint32_t i = 0; i < indices.count; i++) {
+				elements[i] = read_index(indices.data + (uint64_t)i * indices.stride, indices.component_type);
+				if (elements[i] >= positions.count) {
+					job.error = "index out of range";
+					return;
+				}
+			}
+		}
+
+		//Mirrored transforms turn front faces into back faces.
+		bool flip = glm::determinant(glm::mat3(job.transform)) < 0.0f;
+		auto add_triangle = [&](uint32_t a, uint32_t b, uint32_t c) {
+			part.indices.push_back(a);
+			part.indices.push_back(flip ? c : b);
+			part.indices.push_back(flip ? b : c);
+		};
+
+		if (mode == 4) {
+			part.indices.reserve(elements.size());
+			for (size_t i = 0; i + 2 < elements.size(); i += 3)
+				add_triangle(elements[i], elements[i + 1], elements[i + 2]);
+		}
+		else if (mode == 5) {
+			for (size_t i = 0; i + 2 < elements.size(); i++) {
+				if (i % 2 == 0)
+					add_triangle(elements[i], elements[i + 1], elements[i + 2]);
+				else
+					add_triangle(elements[i + 1], elements[i], elements[i + 2]);
+			}
+		}
+		else {
+			for (size_t i = 1; i + 1 < elements.size(); i++)
+				add_triangle(elements[0], elements[i], elements[i + 1]);
+		}
+
+		if (!has_normals && generate)
+			generate_normals(part);
+	}
+
+	bool load_gltf(const std::string& path, Model& model, const ModelImportSettings& settings) {
+		model.clear();
+
+		MappedFile file;
+		if (!file.open(path))
+			return false;
+
+		const char* json_begin = (const char*)file.data();
+		const char* json_end = json_begin + file.size();
+		GltfBuffer binary_chunk;
+
+		uint32_t magic = 0;
+		if (file.size() >= 12)
+			memcpy(&magic, file.data(), 4);
+
+		if (magic == GLB_MAGIC) {
+			json_begin = json_end = nullptr;
+			for (uint64_t offset = 12; offset + 8 <= file.size();) {
+				uint32_t chunk[2];
+				memcpy(chunk, file.data() + offset, 8);
+				if (offset + 8 + chunk[0] > file.size())
+					break;
+
+				if (chunk[1] == GLB_CHUNK_JSON && !json_begin) {
+					json_begin = (const char*)file.data() + offset + 8;
+					json_end = json_begin + chunk[0];
+				}
+				else if (chunk[1] == GLB_CHUNK_BIN && !binary_chunk.data) {
+					binary_chunk.data = file.data() + offset + 8;
+					binary_chunk.size = chunk[0];
+				}
+				offset += 8 + ((chunk[0] + 3) & ~3u);
+			}
+
+			if (!json_begin) {
+				FRACTAL_LOG_ERROR("Model '%s' has no JSON chunk", path.c_str());
+				return false;
+			}
+		}
+
+		JsonValue gltf;
+		if (!JsonParser(json_begin, json_end).parse(gltf) || gltf.type != JsonValue::Object) {
+			FRACTAL_LOG_ERROR("Model '%s' is not valid glTF JSON", path.c_str());
+			return false;
+		}
+
+		if (gltf["asset"]["version"].string.compare(0, 1, "2") != 0) {
+			FRACTAL_LOG_ERROR("Model '%s' is not glTF 2.0", path.c_str());
+			return false;
+		}
+
+		std::string directory = path.substr(0, path.find_last_of("/\\") + 1);
+		std::vector<GltfBuffer> buffers;
+		std::vector<std::unique_ptr<MappedFile>> external_files;
+		std::vector<std::vector<uint8_t>> decoded_buffers;
+		decoded_buffers.reserve(gltf["buffers"].size());
+
+		for (size_t i = 0; i < gltf["buffers"].size(); i++) {
+			const JsonValue& json = gltf["buffers"][i];
+			const std::string& uri = json["uri"].string;
+			GltfBuffer buffer;
+
+			if (uri.empty())
+				buffer = binary_chunk;
+			else if (uri.compare(0, 5, "data:") == 0) {
+				size_t comma = uri.find(',');
+				decoded_buffers.emplace_back();
+				if (comma == std::string::npos || uri.rfind(";base64", comma) == std::string::npos || !decode_base64(uri.data() + comma + 1, uri.data() + uri.size(), decoded_buffers.back())) {
+					FRACTAL_LOG_ERROR("Model '%s' has an unsupported data uri in buffer %d", path.c_str(), (uint32_t)i);
+					return false;
+				}
+				buffer.data = decoded_buffers.back().data();
+				buffer.size = decoded_buffers.back().size();
+			}
+			else {
+				external_files.emplace_back(new MappedFile());
+				if (!external_files.back()->open(directory + decode_uri(uri)))
+					return false;
+				buffer.data = external_files.back()->data();
+				buffer.size = external_files.back()->size();
+			}
+
+			if (!buffer.data || buffer.size < (uint64_t)json["byteLength"].get_number(0)) {
+				FRACTAL_LOG_ERROR("Model '%s' buffer %d is missing or too small", path.c_str(), (uint32_t)i);
+				return false;
+			}
+			buffers.push_back(buffer);
+		}
+
+		const JsonValue& materials = gltf["materials"];
+		for (size_t i = 0; i < materials.size(); i++) {
+			const std::string& name = materials[i]["name"].string;
+			model.materials.push_back(name.empty() ? "material_" + std::to_string(i) : name);
+		}
+
+		//Flatten the scene graph into a list of mesh instances with world transforms.
+		std::vector<std::pair<int64_t, glm::mat4>> instances;
+		const JsonValue& nodes = gltf["nodes"];
+		const JsonValue& scene = gltf["scenes"][(size_t)std::max<int64_t>(gltf["scene"].get_index(), 0)];
+
+		if (scene.is_null()) {
+			for (size_t i = 0; i < gltf["meshes"].size(); i++)
+				instances.push_back({ (int64_t)i, glm::mat4(1.0f) });
+		}
+		else {
+			struct NodeVisit { int64_t node; glm::mat4 parent; uint32_t depth; };
+			std::vector<NodeVisit> stack;
+			for (size_t i = 0; i < scene["nodes"].size(); i++)
+				stack.push_back({ scene["nodes"][i].get_index(), glm::mat4(1.0f), 0 });
+
+			//Nodes form disjoint trees, a node reached twice would let shared children multiply the work.
+			std::vector<bool> visited(nodes.size(), false);
+			while (!stack.empty()) {
+				NodeVisit visit = stack.back();
+				stack.pop_back();
+
+				const JsonValue& node = nodes[(size_t)visit.node];
+				if (visit.node < 0 || node.is_null() || visit.depth > GLTF_MAX_DEPTH || visited[(size_t)visit.node])
+					continue;
+				visited[(size_t)visit.node] = true;
+
+				glm::mat4 world = visit.parent * get_node_transform(node);
+				if (node["mesh"].get_index() >= 0)
+					instances.push_back({ node["mesh"].get_index(), world });
+
+				for (size_t i = 0; i < node["children"].size(); i++)
+					stack.push_back({ node["children"][i].get_index(), world, visit.depth + 1 });
+			}
+		}
+
+		uint32_t default_material = (uint32_t)model.materials.size();
+		std::vector<GltfPrimitiveJob> jobs;
+		for (auto& instance : instances) {
+			const JsonValue& mesh = gltf["meshes"][(size_t)instance.first];
+			for (size_t i = 0; i < mesh["primitives"].size(); i++) {
+				GltfPrimitiveJob job;
+				job.primitive = &mesh["primitives"][i];
+				job.transform = instance.second;
+				job.name = mesh["name"].string.empty() ? "mesh_" + std::to_string(instance.first) : mesh["name"].string;
+
+				int64_t material = (*job.primitive)["material"].get_index();
+				job.material = (material >= 0 && material < (int64_t)model.materials.size()) ? (uint32_t)material : default_material;
+				jobs.push_back(job);
+			}
+		}
+
+		std::unique_ptr<ThreadPool> local_pool;
+		ThreadPool* pool = settings.thread_pool;
+		if (!pool) {
+			local_pool.reset(new ThreadPool());
+			pool = local_pool.get();
+		}
+
+		bool generate = settings.generate_normals;
+		for (GltfPrimitiveJob& job : jobs)
+			pool->submit([&gltf, &buffers, &job, generate] { decode_primitive(gltf, buffers, job, generate); });
+		pool->wait_idle();
+
+		uint32_t skipped = 0;
+		for (GltfPrimitiveJob& job : jobs) {
+			if (job.error) {
+				FRACTAL_LOG_ERROR("Failed to load model '%s': %s in mesh '%s'", path.c_str(), job.error, job.name.c_str());
+				model.clear();
+				return false;
+			}
+			if (job.skipped) {
+				skipped++;
+				continue;
+			}
+
+			ModelPrimitive primitive;
+			primitive.name = job.name;
+			primitive.material = job.material;
+			primitive.index_offset = (uint32_t)model.indices.size();
+			primitive.index_count = (uint32_t)job.part.indices.size();
+
+			uint32_t base = (uint32_t)model.vertices.size();
+			model.vertices.insert(model.vertices.end(), job.part.vertices.begin(), job.part.vertices.end());
+			for (uint32_t index : job.part.indices)
+				model.indices.push_back(base + index);
+			model.primitives.push_back(primitive);
+
+			if (job.material == default_material && model.materials.size() == default_material)
+				model.materials.push_back("default");
+		}
+
+		if (skipped)
+			FRACTAL_LOG_WARNING("Skipped %d point or line primitives in model '%s'", skipped, path.c_str());
+
+		if (model.indices.empty()) {
+			FRACTAL_LOG_ERROR("Model '%s' has no triangles", path.c_str());
+			return false;
+		}
+
+		if (settings.optimize) {
+			MeshOptimizerStatistics statistics = optimize_mesh(model);
+			FRACTAL_LOG("Optimized model '%s': ACMR %.3f -> %.3f, ATVR %.3f -> %.3f", path.c_str(), statistics.before.acmr, statistics.after.acmr, statistics.before.atvr, statistics.after.atvr);
+		}
+
+		FRACTAL_LOG_GOOD("Loaded model '%s' with %d vertices and %d triangles", path.c_str(), (uint32_t)model.vertices.size(), model.get_triangle_count());
+		return true;
+	}
+}
@@ -0,0 +1,263 @@
+/**
+ * @file gpu_memory.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the registry of GPU memory allocations.
+ */
+
+#include "gpu_memory.h"
+#include "log.h"
+
+#include <glad/glad.h>
+#include <unordered_map>
+#include <mutex>
+#include <cstring>
+#include <algorithm>
+
+#define GL_GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX 0x9048
+#define GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_MEMORY_NVX 0x9049
+#define GL_TEXTURE_FREE_MEMORY_ATI 0x87FC
+
+namespace Fractal {
+	constexpr uint32_t GPU_MEMORY_QUERY_INTERVAL = 120;
+	//Driver usage may drift from the tracked total by this much before it is reported.
+	constexpr uint64_t GPU_MEMORY_UNTRACKED_THRESHOLD = 64 * 1024 * 1024;
+
+	static const char* CATEGORY_NAMES[(size_t)GpuMemoryCategory::Count] = {
+		"Vertex Buffers",
+		"Index Buffers",
+		"Uniform Buffers",
+		"Indirect Buffers",
+		"Storage Buffers",
+		"Staging Buffers",
+		"Textures",
+		"Frame Buffers"
+	};
+
+	enum class DriverMemoryInfo {
+		Unknown,
+		None,
+		NVX,
+		ATI
+	};
+
+	struct GpuMemoryRegistry {
+		std::mutex mutex;
+		std::unordered_map<uint64_t, GpuAllocation> allocations;
+		GpuMemoryStatistics statistics;
+
+		DriverMemoryInfo driver = DriverMemoryInfo::Unknown;
+		uint32_t frames_until_query = 0;
+		bool has_baseline = false;
+		uint64_t baseline_driver_used = 0;
+		uint64_t baseline_tracked = 0;
+
+		bool over_budget = false;
+		bool untracked_warned = false;
+	};
+
+	static GpuMemoryRegistry& get_registry() {
+		static GpuMemoryRegistry registry;
+		return registry;
+	}
+
+	static inline uint64_t get_key(GpuResourceType type, uint32_t id) {
+		return ((uint64_t)type << 32) | id;
+	}
+
+	static void label_object(GpuResourceType type, uint32_t id, const std::string& name) {
+		if (name.empty() || !glObjectLabel)
+			return;
+
+		GLenum identifier = GL_BUFFER;
+		switch (type) {
+		case GpuResourceType::Buffer: identifier = GL_BUFFER; break;
+		case GpuResourceType::Texture: identifier = GL_TEXTURE; break;
+		case GpuResourceType::RenderBuffer: identifier = GL_RENDERBUFFER; break;
+		case GpuResourceType::Program: identifier = GL_PROGRAM; break;
+		case GpuResourceType::FrameBuffer: identifier = GL_FRAMEBUFFER; break;
+		case GpuResourceType::VertexArray: identifier = GL_VERTEX_ARRAY; break;
+		}
+		glObjectLabel(identifier, id, (GLsizei)name.size(), name.c_str());
+	}
+
+	void register_gpu_allocation(GpuResourceType type, uint32_t id, GpuMemoryCategory category, uint64_t size, uint32_t usage, const std::string& name) {
+		if (id == 0)
+			return;
+
+		GpuMemoryRegistry& registry = get_registry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		GpuMemoryStatistics& statistics = registry.statistics;
+
+		auto it = registry.allocations.find(get_key(type, id));
+		if (it != registry.allocations.end()) {
+			GpuAllocation& previous = it->second;
+			statistics.category_bytes[(size_t)previous.category] -= previous.size;
+			statistics.category_counts[(size_t)previous.category]--;
+			statistics.total -= previous.size;
+		}
+
+		GpuAllocation& allocation = registry.allocations[get_key(type, id)];
+		allocation.type = type;
+		allocation.id = id;
+		allocation.category = category;
+		allocation.size = size;
+		allocation.usage = usage;
+		if (!name.empty() && allocation.name != name) {
+			allocation.name = name;
+			label_object(type, id, name);
+		}
+
+		statistics.category_bytes[(size_t)category] += size;
+		statistics.category_counts[(size_t)category]++;
+		statistics.total += size;
+		statistics.peak = std::max(statistics.peak, statistics.total);
+	}
+
+	void release_gpu_allocation(GpuResourceType type, uint32_t id) {
+		GpuMemoryRegistry& registry = get_registry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+
+		auto it = registry.allocations.find(get_key(type, id));
+		if (it == registry.allocations.end())
+			return;
+
+		GpuMemoryStatistics& statistics = registry.statistics;
+		statistics.category_bytes[(size_t)it->second.category] -= it->second.size;
+		statistics.category_counts[(size_t)it->second.category]--;
+		statistics.total -= it->second.size;
+		registry.allocations.erase(it);
+	}
+
+	void set_gpu_allocation_name(GpuResourceType type, uint32_t id, const std::string& name) {
+		GpuMemoryRegistry& registry = get_registry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+
+		auto it = registry.allocations.find(get_key(type, id));
+		if (it != registry.allocations.end())
+			it->second.name = name;
+		label_object(type, id, name);
+	}
+
+	void set_gpu_memory_budget(uint64_t budget) {
+		GpuMemoryRegistry& registry = get_registry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		registry.statistics.budget = budget;
+		registry.over_budget = false;
+	}
+
+	static DriverMemoryInfo find_driver_memory_info() {
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (GLint i = 0; i < count; i++) {
+			const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+			if (!extension)
+				continue;
+			if (strcmp(extension, "GL_NVX_gpu_memory_info") == 0)
+				return DriverMemoryInfo::NVX;
+			if (strcmp(extension, "GL_ATI_meminfo") == 0)
+				return DriverMemoryInfo::ATI;
+		}
+		return DriverMemoryInfo::None;
+	}
+
+	//Returns how much memory the driver reports as used, both extensions report in KB.
+	static bool query_driver_memory(GpuMemoryRegistry& registry, uint64_t& used) {
+		GpuMemoryStatistics& statistics = registry.statistics;
+		if (registry.driver == DriverMemoryInfo::NVX) {
+			GLint total = 0, available = 0;
+			glGetIntegerv(GL_GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX, &total);
+			glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_MEMORY_NVX, &available);
+			statistics.driver_total = (uint64_t)total * 1024;
+			statistics.driver_available = (uint64_t)available * 1024;
+			used = statistics.driver_total - std::min(statistics.driver_available, statistics.driver_total);
+			return true;
+		}
+		if (registry.driver == DriverMemoryInfo::ATI) {
+			//Only the free pool is known, usage is measured against the pool at the first query.
+			GLint info[4] = { 0 };
+			glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, info);
+			statistics.driver_available = (uint64_t)info[0] * 1024;
+			if (!registry.has_baseline)
+				statistics.driver_total = statistics.driver_available;
+			used = statistics.driver_total - std::min(statistics.driver_available, statistics.driver_total);
+			return true;
+		}
+		return false;
+	}
+
+	void update_gpu_memory() {
+		GpuMemoryRegistry& registry = get_registry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		GpuMemoryStatistics& statistics = registry.statistics;
+
+		if (statistics.budget > 0) {
+			bool over_budget = (statistics.total > statistics.budget);
+			if (over_budget && !registry.over_budget)
+				FRACTAL_LOG_WARNING("GPU memory exceeds the budget (%llu / %llu MB)", (unsigned long long)(statistics.total >> 20), (unsigned long long)(statistics.budget >> 20));
+			registry.over_budget = over_budget;
+		}
+
+		if (registry.frames_until_query > 0) {
+			registry.frames_until_query--;
+			return;
+		}
+		registry.frames_until_query = GPU_MEMORY_QUERY_INTERVAL;
+
+		if (registry.driver == DriverMemoryInfo::Unknown)
+			registry.driver = find_driver_memory_info();
+
+		uint64_t used = 0;
+		statistics.driver_info = query_driver_memory(registry, used);
+		if (!statistics.driver_info)
+			return;
+
+		if (!registry.has_baseline) {
+			registry.has_baseline = true;
+			registry.baseline_driver_used = used;
+			registry.baseline_tracked = statistics.total;
+			return;
+		}
+
+		statistics.untracked = ((int64_t)used - (int64_t)registry.baseline_driver_used) - ((int64_t)statistics.total - (int64_t)registry.baseline_tracked);
+		if (statistics.untracked > (int64_t)GPU_MEMORY_UNTRACKED_THRESHOLD && !registry.untracked_warned) {
+			FRACTAL_LOG_WARNING("The driver reports %lld MB more GPU memory in use than the tracked allocations", (long long)(statistics.untracked >> 20));
+			registry.untracked_warned = true;
+		}
+		else if (statistics.untracked < (int64_t)GPU_MEMORY_UNTRACKED_THRESHOLD / 2)
+			registry.untracked_warned = false;
+	}
+
+	GpuMemoryStatistics get_gpu_memory_statistics() {
+		GpuMemoryRegistry& registry = get_registry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		return registry.statistics;
+	}
+
+	std::vector<GpuAllocation> get_gpu_allocations() {
+		GpuMemoryRegistry& registry = get_registry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+
+		std::vector<GpuAllocation> allocations;
+		allocations.reserve(registry.allocations.size());
+		for (auto& allocation : registry.allocations)
+			allocations.push_back(allocation.second);
+
+		std::sort(allocations.begin(), allocations.end(), [](const GpuAllocation& a, const GpuAllocation& b) { return a.size > b.size; });
+		return allocations;
+	}
+
+	const char* get_gpu_memory_category_name(GpuMemoryCategory category) {
+		return ((size_t)category < (size_t)GpuMemoryCategory::Count) ? CATEGORY_NAMES[(size_t)category] : "Unknown";
+	}
+}
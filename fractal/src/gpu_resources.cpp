@@ -0,0 +1,100 @@
+/**
+ * @file gpu_resources.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the queue that holds GPU objects back from deletion
+ * until the GPU is done with them.
+ */
+
+#include "gpu_resources.h"
+#include "fence.h"
+
+#include <glad/glad.h>
+#include <deque>
+
+namespace Fractal {
+	struct PendingDestruction {
+		GpuResourceType type;
+		uint32_t id;
+	};
+
+	struct PendingFrame {
+		Fence fence;
+		std::vector<PendingDestruction> destructions;
+	};
+
+	static std::vector<PendingDestruction> current_destructions;
+	static std::deque<PendingFrame> pending_frames;
+	static uint32_t pending_count = 0;
+	static bool flushed = false;
+
+	static void delete_gpu_resource(const PendingDestruction& destruction) {
+		release_gpu_allocation(destruction.type, destruction.id);
+		switch (destruction.type) {
+		case GpuResourceType::Buffer: glDeleteBuffers(1, &destruction.id); break;
+		case GpuResourceType::Texture: glDeleteTextures(1, &destruction.id); break;
+		case GpuResourceType::RenderBuffer: glDeleteRenderbuffers(1, &destruction.id); break;
+		case GpuResourceType::Program: glDeleteProgram(destruction.id); break;
+		case GpuResourceType::FrameBuffer: glDeleteFramebuffers(1, &destruction.id); break;
+		case GpuResourceType::VertexArray: glDeleteVertexArrays(1, &destruction.id); break;
+		}
+	}
+
+	void destroy_gpu_resource(GpuResourceType type, uint32_t id) {
+		if (id == 0)
+			return;
+
+		if (flushed) {
+			release_gpu_allocation(type, id);
+			return;
+		}
+
+		PendingDestruction destruction;
+		destruction.type = type;
+		destruction.id = id;
+		current_destructions.push_back(destruction);
+		pending_count++;
+	}
+
+	void end_gpu_frame() {
+		if (!current_destructions.empty()) {
+			pending_frames.emplace_back();
+			pending_frames.back().fence.insert();
+			pending_frames.back().destructions.swap(current_destructions);
+		}
+
+		while (!pending_frames.empty() && pending_frames.front().fence.signaled()) {
+			for (const PendingDestruction& destruction : pending_frames.front().destructions)
+				delete_gpu_resource(destruction);
+			pending_count -= (uint32_t)pending_frames.front().destructions.size();
+			pending_frames.pop_front();
+		}
+	}
+
+	void flush_gpu_resources() {
+		for (PendingFrame& frame : pending_frames)
+			for (const PendingDestruction& destruction : frame.destructions)
+				delete_gpu_resource(destruction);
+		for (const PendingDestruction& destruction : current_destructions)
+			delete_gpu_resource(destruction);
+
+		pending_frames.clear();
+		current_destructions.clear();
+		pending_count = 0;
+		flushed = true;
+	}
+
+	uint32_t get_pending_gpu_destructions() {
+		return pending_count;
+	}
+}
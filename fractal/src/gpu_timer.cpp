@@ -0,0 +1,70 @@
+/**
+ * @file gpu_timer.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains a GPU timer built on a ring of time elapsed queries
+ * so results can be read a few frames later without stalling.
+ */
+
+#include "gpu_timer.h"
+#include <glad/glad.h>
+
+namespace Fractal {
+	GpuTimer::GpuTimer() {
+		glCreateQueries(GL_TIME_ELAPSED, GPU_TIMER_QUERY_COUNT, m_queries);
+	}
+
+	GpuTimer::~GpuTimer() {
+		glDeleteQueries(GPU_TIMER_QUERY_COUNT, m_queries);
+	}
+
+	void GpuTimer::begin() {
+		//Every query is still in flight, skip this frame instead of waiting on the GPU.
+		if (m_pending == GPU_TIMER_QUERY_COUNT)
+			return;
+
+		glBeginQuery(GL_TIME_ELAPSED, m_queries[m_write_index]);
+		m_active = true;
+	}
+
+	void GpuTimer::end() {
+		if (!m_active)
+			return;
+
+		glEndQuery(GL_TIME_ELAPSED);
+		m_write_index = (m_write_index + 1) % GPU_TIMER_QUERY_COUNT;
+		m_pending++;
+		m_active = false;
+	}
+
+	bool GpuTimer::poll() {
+		bool updated = false;
+
+		while (m_pending > 0) {
+			int available = 0;
+			glGetQueryObjectiv(m_queries[m_read_index], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				break;
+
+			GLuint64 elapsed = 0;
+			glGetQueryObjectui64v(m_queries[m_read_index], GL_QUERY_RESULT, &elapsed);
+			m_elapsed_ms = (float)((double)elapsed / 1000000.0);
+
+			m_read_index = (m_read_index + 1) % GPU_TIMER_QUERY_COUNT;
+			m_pending--;
+			updated = true;
+		}
+
+		return updated;
+	}
+}
@@ -24,6 +24,7 @@
 #include "application.h"
 #include "glfw_window.h"
 #include "log.h"
+#include "allocation_tracker.h"
 
 namespace Fractal {
 	ImGuiLayer::ImGuiLayer() : Layer("ImGuiLayer") { }
@@ -89,12 +90,14 @@ namespace Fractal {
 	}
 	
 	void ImGuiLayer::begin() {
+		FRACTAL_ALLOCATION_SCOPE(ImGui);
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
 	}
 
 	void ImGuiLayer::end( ) {
+		FRACTAL_ALLOCATION_SCOPE(ImGui);
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
@@ -0,0 +1,367 @@
+/**
+ * @file job_system.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the work stealing job system. Every worker owns a
+ * Chase-Lev deque and steals from the others once its own runs dry.
+ */
+
+#include "job_system.h"
+#include "platform.h"
+#include "log.h"
+
+#include <algorithm>
+#include <chrono>
+
+#ifdef FRACTAL_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Fractal {
+	constexpr uint32_t JOB_NO_WORKER = 0xFFFFFFFF;
+	constexpr uint32_t JOB_SPIN_COUNT = 64;
+
+	struct Job {
+		JobFunction function;
+		JobCounter* counter = nullptr;
+	};
+
+	static thread_local JobSystem* current_system = nullptr;
+	static thread_local uint32_t current_worker = JOB_NO_WORKER;
+	//Nested jobs run inside a wait are already inside a timed job.
+	static thread_local uint32_t job_depth = 0;
+
+	static uint64_t get_time_ns() {
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	JobDeque::JobDeque() {
+		for (auto& job : m_jobs)
+			job.store(nullptr, std::memory_order_relaxed);
+	}
+
+	bool JobDeque::push(Job* job) {
+		int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+		int64_t top = m_top.load(std::memory_order_acquire);
+		if (bottom - top >= (int64_t)JOB_DEQUE_CAPACITY)
+			return false;
+
+		m_jobs[bottom & (JOB_DEQUE_CAPACITY - 1)].store(job, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	Job* JobDeque::pop() {
+		int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = m_top.load(std::memory_order_relaxed);
+
+		if (top > bottom) {
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		Job* job = m_jobs[bottom & (JOB_DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+		if (top == bottom) {
+			//Last job, race the thieves for it.
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				job = nullptr;
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+		return job;
+	}
+
+	Job* JobDeque::steal() {
+		int64_t top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t bottom = m_bottom.load(std::memory_order_acquire);
+		if (top >= bottom)
+			return nullptr;
+
+		Job* job = m_jobs[top & (JOB_DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+		return job;
+	}
+
+	JobSystem::JobSystem(const JobSystemSettings& settings) : m_settings(settings) {
+		uint32_t worker_count = m_settings.worker_count;
+		if (worker_count == 0)
+			worker_count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+		worker_count = std::min(worker_count, MAX_JOB_WORKERS - 1);
+
+		m_main_thread = std::this_thread::get_id();
+		current_system = this;
+		current_worker = 0;
+
+		for (uint32_t i = 0; i <= worker_count; i++)
+			m_workers.push_back(new Worker());
+		m_statistics.resize(worker_count + 1);
+		m_frame_start_ns = get_time_ns();
+
+		for (uint32_t i = 0; i < worker_count; i++) {
+			m_threads.emplace_back(&JobSystem::worker_loop, this, i + 1);
+			if (m_settings.pin_threads)
+				set_affinity(m_threads.back(), m_settings.affinity_offset + i);
+		}
+		FRACTAL_LOG("Started job system with %d workers", worker_count);
+	}
+
+	JobSystem::~JobSystem() {
+		m_stop = true;
+		{
+			std::lock_guard<std::mutex> lock(m_sleep_mutex);
+		}
+		m_wake.notify_all();
+
+		for (auto& thread : m_threads)
+			thread.join();
+
+		//Anything still queued never ran, only its memory is left to free.
+		for (Worker* worker : m_workers) {
+			while (Job* job = worker->deque.steal())
+				delete job;
+			delete worker;
+		}
+		for (Job* job : m_shared)
+			delete job;
+		for (Job* job : m_main_jobs)
+			delete job;
+
+		if (current_system == this) {
+			current_system = nullptr;
+			current_worker = JOB_NO_WORKER;
+		}
+	}
+
+	void JobSystem::run(const JobFunction& function, JobCounter* counter, JobCounter* dependency) {
+		Job* job = new Job();
+		job->function = function;
+		job->counter = counter;
+		if (counter)
+			counter->m_count.fetch_add(1);
+
+		if (dependency) {
+			std::lock_guard<std::mutex> lock(dependency->m_mutex);
+			if (!dependency->done()) {
+				dependency->m_waiting.push_back(job);
+				return;
+			}
+		}
+
+		submit(job);
+	}
+
+	void JobSystem::parallel_for(uint32_t count, uint32_t batch_size, const std::function<void(uint32_t begin, uint32_t end)>& function) {
+		if (count == 0)
+			return;
+
+		batch_size = std::max(batch_size, 1u);
+		JobCounter counter;
+		for (uint32_t begin = 0; begin < count; begin += batch_size) {
+			uint32_t end = std::min(begin + batch_size, count);
+			run([&function, begin, end]() { function(begin, end); }, &counter);
+		}
+		wait(counter);
+	}
+
+	void JobSystem::wait(JobCounter& counter) {
+		uint32_t index = (current_system == this) ? current_worker : JOB_NO_WORKER;
+		bool main_thread = is_main_thread();
+
+		while (!counter.done()) {
+			if (main_thread)
+				execute_main_thread_jobs();
+			if (!execute_one(index))
+				std::this_thread::yield();
+		}
+
+		//Waits out the thread that lowered the count to zero, it still holds the lock while it hands off dependents.
+		std::lock_guard<std::mutex> lock(counter.m_mutex);
+	}
+
+	void JobSystem::run_on_main_thread(const JobFunction& function, JobCounter* counter) {
+		Job* job = new Job();
+		job->function = function;
+		job->counter = counter;
+		if (counter)
+			counter->m_count.fetch_add(1);
+
+		std::lock_guard<std::mutex> lock(m_main_mutex);
+		m_main_jobs.push_back(job);
+	}
+
+	void JobSystem::execute_main_thread_jobs() {
+		if (!is_main_thread())
+			return;
+
+		std::vector<Job*> jobs;
+		{
+			std::lock_guard<std::mutex> lock(m_main_mutex);
+			jobs.swap(m_main_jobs);
+		}
+
+		for (Job* job : jobs)
+			execute(job, 0);
+	}
+
+	void JobSystem::end_frame() {
+		uint64_t now = get_time_ns();
+		float frame_ms = (float)(now - m_frame_start_ns) / 1000000.0f;
+		m_frame_start_ns = now;
+
+		for (uint32_t i = 0; i < (uint32_t)m_workers.size(); i++) {
+			Worker* worker = m_workers[i];
+			WorkerStatistics& statistics = m_statistics[i];
+			statistics.busy_ms = (float)worker->busy_ns.exchange(0) / 1000000.0f;
+			statistics.utilization = (frame_ms > 0.0f) ? std::min(statistics.busy_ms / frame_ms, 1.0f) : 0.0f;
+			statistics.jobs = worker->jobs.exchange(0);
+			statistics.steals = worker->steals.exchange(0);
+		}
+	}
+
+	bool JobSystem::is_main_thread() const {
+		return std::this_thread::get_id() == m_main_thread;
+	}
+
+	void JobSystem::worker_loop(uint32_t index) {
+		current_system = this;
+		current_worker = index;
+
+		while (!m_stop) {
+			if (execute_one(index))
+				continue;
+
+			bool found = false;
+			for (uint32_t i = 0; i < JOB_SPIN_COUNT && !found; i++) {
+				std::this_thread::yield();
+				found = (m_queued.load() > 0);
+			}
+			if (found)
+				continue;
+
+			//Submitters only take the lock when someone sleeps, so the count is raised before the queue is checked.
+			m_sleeping.fetch_add(1);
+			{
+				std::unique_lock<std::mutex> lock(m_sleep_mutex);
+				m_wake.wait(lock, [this] { return m_stop || m_queued.load() > 0; });
+			}
+			m_sleeping.fetch_sub(1);
+		}
+	}
+
+	void JobSystem::submit(Job* job) {
+		uint32_t index = (current_system == this) ? current_worker : JOB_NO_WORKER;
+		if (index == JOB_NO_WORKER || !m_workers[index]->deque.push(job)) {
+			std::lock_guard<std::mutex> lock(m_shared_mutex);
+			m_shared.push_back(job);
+		}
+
+		m_queued.fetch_add(1);
+		if (m_sleeping.load() > 0) {
+			std::lock_guard<std::mutex> lock(m_sleep_mutex);
+			m_wake.notify_one();
+		}
+	}
+
+	void JobSystem::release(JobCounter* counter) {
+		if (!counter)
+			return;
+
+		//The owner may free the counter once it reads zero, so nothing touches it after the lock is dropped.
+		std::vector<Job*> waiting;
+		{
+			std::lock_guard<std::mutex> lock(counter->m_mutex);
+			if (counter->m_count.fetch_sub(1) == 1)
+				waiting.swap(counter->m_waiting);
+		}
+		for (Job* job : waiting)
+			submit(job);
+	}
+
+	Job* JobSystem::find_job(uint32_t index) {
+		Job* job = (index != JOB_NO_WORKER) ? m_workers[index]->deque.pop() : nullptr;
+
+		if (!job) {
+			std::lock_guard<std::mutex> lock(m_shared_mutex);
+			if (!m_shared.empty()) {
+				job = m_shared.front();
+				m_shared.pop_front();
+			}
+		}
+
+		if (!job) {
+			uint32_t count = (uint32_t)m_workers.size();
+			uint32_t start = (index != JOB_NO_WORKER) ? index + 1 : 0;
+			for (uint32_t i = 0; i < count && !job; i++) {
+				uint32_t victim = (start + i) % count;
+				if (victim == index)
+					continue;
+				job = m_workers[victim]->deque.steal();
+				if (job && index != JOB_NO_WORKER)
+					m_workers[index]->steals.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		if (job)
+			m_queued.fetch_sub(1);
+		return job;
+	}
+
+	bool JobSystem::execute_one(uint32_t index) {
+		Job* job = find_job(index);
+		if (!job)
+			return false;
+
+		execute(job, index);
+		return true;
+	}
+
+	void JobSystem::execute(Job* job, uint32_t index) {
+		uint64_t start = (job_depth == 0) ? get_time_ns() : 0;
+		job_depth++;
+		job->function();
+		job_depth--;
+
+		if (index != JOB_NO_WORKER) {
+			Worker* worker = m_workers[index];
+			if (job_depth == 0)
+				worker->busy_ns.fetch_add(get_time_ns() - start, std::memory_order_relaxed);
+			worker->jobs.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		JobCounter* counter = job->counter;
+		delete job;
+		release(counter);
+	}
+
+	void JobSystem::set_affinity(std::thread& thread, uint32_t core) {
+		uint32_t cores = std::max(std::thread::hardware_concurrency(), 1u);
+		core %= cores;
+#ifdef FRACTAL_PLATFORM_WINDOWS
+		if (core < sizeof(DWORD_PTR) * 8 && SetThreadAffinityMask((HANDLE)thread.native_handle(), (DWORD_PTR)1 << core) == 0)
+			FRACTAL_LOG_WARNING("Failed to pin job worker to core %d", core);
+#else
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(core, &set);
+		if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &set) != 0)
+			FRACTAL_LOG_WARNING("Failed to pin job worker to core %d", core);
+#endif
+	}
+}
@@ -16,6 +16,7 @@
  */
 
 #include "log.h"
+#include "allocation_tracker.h"
 #include <ctime>
 
 #define MAX_INPUT_SIZE 512
@@ -148,11 +149,15 @@ namespace Fractal {
     }
 
     void Logger::log(const char* fmt, ...) {
+        FRACTAL_ALLOCATION_SCOPE(Log);
         if (m_formatter) {
             va_list args;
             va_start(args, fmt);
-            std::string output;
-            std::string log_output;
+            //Reused per thread so logging does not allocate once the buffers have grown.
+            static thread_local std::string output;
+            static thread_local std::string log_output;
+            output.clear();
+            log_output.clear();
 
             for (auto& command : m_formatter->get_commands()) {
                 command->run_command(args, fmt);
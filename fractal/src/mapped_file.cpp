@@ -0,0 +1,111 @@
+/**
+ * @file mapped_file.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains a read only memory mapped file.
+ */
+
+#include "mapped_file.h"
+#include "platform.h"
+#include "log.h"
+
+#ifdef FRACTAL_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Fractal {
+	MappedFile::~MappedFile() {
+		close();
+	}
+
+	bool MappedFile::open(const std::string& path) {
+		close();
+		m_path = path;
+
+#ifdef FRACTAL_PLATFORM_WINDOWS
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			FRACTAL_LOG_ERROR("Failed to open '%s' for mapping", path.c_str());
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+			CloseHandle(file);
+			FRACTAL_LOG_ERROR("Cannot map empty file '%s'", path.c_str());
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (!view) {
+			if (mapping)
+				CloseHandle(mapping);
+			CloseHandle(file);
+			FRACTAL_LOG_ERROR("Failed to map '%s'", path.c_str());
+			return false;
+		}
+
+		m_file = file;
+		m_mapping = mapping;
+		m_data = (const uint8_t*)view;
+		m_size = (uint64_t)size.QuadPart;
+#else
+		int file = ::open(path.c_str(), O_RDONLY);
+		if (file < 0) {
+			FRACTAL_LOG_ERROR("Failed to open '%s' for mapping", path.c_str());
+			return false;
+		}
+
+		struct stat info;
+		if (fstat(file, &info) != 0 || info.st_size == 0) {
+			::close(file);
+			FRACTAL_LOG_ERROR("Cannot map empty file '%s'", path.c_str());
+			return false;
+		}
+
+		void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		::close(file);
+		if (view == MAP_FAILED) {
+			FRACTAL_LOG_ERROR("Failed to map '%s'", path.c_str());
+			return false;
+		}
+
+		m_data = (const uint8_t*)view;
+		m_size = (uint64_t)info.st_size;
+#endif
+		return true;
+	}
+
+	void MappedFile::close() {
+		if (!m_data)
+			return;
+
+#ifdef FRACTAL_PLATFORM_WINDOWS
+		UnmapViewOfFile(m_data);
+		CloseHandle((HANDLE)m_mapping);
+		CloseHandle((HANDLE)m_file);
+#else
+		munmap((void*)m_data, (size_t)m_size);
+#endif
+		m_data = nullptr;
+		m_size = 0;
+		m_file = nullptr;
+		m_mapping = nullptr;
+	}
+}
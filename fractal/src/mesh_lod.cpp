@@ -0,0 +1,97 @@
+/**
+ * @file mesh_lod.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains level of detail chains for meshes and their screen size based selection.
+ */
+
+#include "mesh_lod.h"
+#include "mesh_simplifier.h"
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace Fractal {
+	//A level has to drop at least this fraction of the previous level's triangles to be worth keeping.
+	constexpr float MIN_LOD_REDUCTION = 0.05f;
+
+	LodMesh::LodMesh(const Mesh& mesh, const LodSettings& settings) {
+		build(mesh, settings);
+	}
+
+	void LodMesh::build(const Mesh& mesh, const LodSettings& settings) {
+		m_levels.clear();
+		m_screen_sizes.clear();
+		m_current_level = 0;
+		m_hysteresis = settings.hysteresis;
+
+		m_levels.push_back(mesh);
+		m_screen_sizes.push_back(FLT_MAX);
+		m_bounds = compute_bounding_sphere(mesh.vertices.data(), mesh.vertices.size(), sizeof(Vertex));
+
+		std::vector<LodLevelSettings> levels = settings.levels;
+		std::sort(levels.begin(), levels.end(), [](const LodLevelSettings& a, const LodLevelSettings& b) { return a.ratio > b.ratio; });
+
+		MeshOptimizerSettings optimizer;
+		//Every level indexes the original vertices, welding would only find what the source already had.
+		optimizer.weld = false;
+
+		std::vector<uint32_t> indices(mesh.indices.size());
+		for (const LodLevelSettings& level : levels) {
+			if (m_levels.size() >= MAX_LOD_LEVELS)
+				break;
+
+			size_t previous = m_levels.back().indices.size();
+			size_t target = (size_t)(mesh.indices.size() * level.ratio) / 3 * 3;
+			size_t count = simplify_mesh(indices.data(), mesh.indices.data(), mesh.indices.size(), mesh.vertices.data(), (uint32_t)mesh.vertices.size(), sizeof(Vertex), target, settings.target_error);
+			if (count == 0 || count > previous * (1.0f - MIN_LOD_REDUCTION))
+				break;
+
+			Mesh lod;
+			lod.vertices = mesh.vertices;
+			lod.indices.assign(indices.begin(), indices.begin() + count);
+			optimize_mesh(lod, optimizer);
+
+			m_levels.push_back(std::move(lod));
+			m_screen_sizes.push_back(level.screen_size);
+		}
+	}
+
+	uint32_t LodMesh::select_level(float screen_size) {
+		uint32_t count = get_level_count();
+		if (count == 0)
+			return 0;
+
+		//Crossing a threshold needs the hysteresis margin on top so objects near it do not flicker between levels.
+		while (m_current_level + 1 < count && screen_size < m_screen_sizes[m_current_level + 1] * (1.0f - m_hysteresis))
+			m_current_level++;
+		while (m_current_level > 0 && screen_size > m_screen_sizes[m_current_level] * (1.0f + m_hysteresis))
+			m_current_level--;
+		return m_current_level;
+	}
+
+	float get_screen_size(const BoundingSphere& sphere, const Camera& camera) {
+		glm::mat4 projection = camera.get_projection();
+
+		//Orthographic projections do not shrink with distance.
+		if (projection[3][3] == 1.0f)
+			return sphere.radius * projection[1][1];
+
+		//Distance rather than view depth keeps the level stable while the camera turns.
+		float distance = glm::distance(camera.get_position(), sphere.center);
+		if (distance <= sphere.radius)
+			return FLT_MAX;
+		return sphere.radius * projection[1][1] / distance;
+	}
+}
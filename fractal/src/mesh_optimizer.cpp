@@ -0,0 +1,315 @@
+/**
+ * @file mesh_optimizer.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the mesh optimization passes: vertex welding, Tipsify
+ * vertex cache ordering, cluster based overdraw ordering and vertex fetch
+ * reordering, along with a FIFO cache simulation to measure the results.
+ */
+
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <glm/glm.hpp>
+
+namespace Fractal {
+	constexpr uint32_t OPTIMIZER_UNUSED = 0xFFFFFFFF;
+
+	static uint64_t hash_vertex(const uint8_t* data, uint32_t size) {
+		uint64_t hash = 14695981039346656037ull;
+		for (uint32_t i = 0; i < size; i++) {
+			hash ^= data[i];
+			hash *= 1099511628211ull;
+		}
+		return hash ^ (hash >> 32);
+	}
+
+	uint32_t weld_vertices(void* vertices, uint32_t vertex_count, uint32_t vertex_size, uint32_t* indices, size_t index_count) {
+		uint8_t* data = (uint8_t*)vertices;
+		size_t capacity = 16;
+		while (capacity < (size_t)vertex_count * 2)
+			capacity <<= 1;
+
+		std::vector<uint32_t> slots(capacity, OPTIMIZER_UNUSED);
+		std::vector<uint32_t> remap(vertex_count);
+		uint32_t unique = 0;
+
+		//Unique vertices are compacted towards the front, which never overwrites an unvisited vertex.
+		for (uint32_t v = 0; v < vertex_count; v++) {
+			const uint8_t* vertex = data + (size_t)v * vertex_size;
+			for (size_t slot = hash_vertex(vertex, vertex_size) & (capacity - 1);; slot = (slot + 1) & (capacity - 1)) {
+				if (slots[slot] == OPTIMIZER_UNUSED) {
+					if (unique != v)
+						memcpy(data + (size_t)unique * vertex_size, vertex, vertex_size);
+					slots[slot] = unique;
+					remap[v] = unique++;
+					break;
+				}
+
+				if (memcmp(data + (size_t)slots[slot] * vertex_size, vertex, vertex_size) == 0) {
+					remap[v] = slots[slot];
+					break;
+				}
+			}
+		}
+
+		for (size_t i = 0; i < index_count; i++)
+			indices[i] = remap[indices[i]];
+		return unique;
+	}
+
+	void optimize_vertex_cache(uint32_t* indices, size_t index_count, uint32_t cache_size) {
+		size_t triangle_count = index_count / 3;
+		if (triangle_count == 0)
+			return;
+
+		//Work in the window of vertices this index range touches so submeshes stay cheap.
+		uint32_t base = *std::min_element(indices, indices + triangle_count * 3);
+		uint32_t range = *std::max_element(indices, indices + triangle_count * 3) - base + 1;
+
+		std::vector<uint32_t> live(range, 0), offsets(range + 1, 0), adjacency(triangle_count * 3);
+		for (size_t i = 0; i < triangle_count * 3; i++)
+			offsets[indices[i] - base + 1]++;
+		for (uint32_t v = 0; v < range; v++) {
+			live[v] = offsets[v + 1];
+			offsets[v + 1] += offsets[v];
+		}
+
+		std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < triangle_count * 3; i++)
+			adjacency[fill[indices[i] - base]++] = (uint32_t)(i / 3);
+
+		std::vector<uint32_t> cache_time(range, 0), dead_end, candidates, output;
+		std::vector<uint8_t> emitted(triangle_count, 0);
+		dead_end.reserve(triangle_count * 3);
+		output.reserve(triangle_count * 3);
+
+		uint32_t time = cache_size + 1, cursor = 0;
+		int64_t fanning = indices[0] - base;
+
+		while (fanning >= 0) {
+			candidates.clear();
+			for (uint32_t k = offsets[fanning]; k < offsets[fanning + 1]; k++) {
+				uint32_t triangle = adjacency[k];
+				if (emitted[triangle])
+					continue;
+
+				for (uint32_t j = 0; j < 3; j++) {
+					uint32_t v = indices[triangle * 3 + j] - base;
+					output.push_back(v + base);
+					dead_end.push_back(v);
+					candidates.push_back(v);
+					live[v]--;
+					if (time - cache_time[v] > cache_size)
+						cache_time[v] = time++;
+				}
+				emitted[triangle] = 1;
+			}
+
+			//Prefer the candidate that will still be in cache once all of its triangles are emitted.
+			fanning = -1;
+			int64_t best = -1;
+			for (uint32_t v : candidates) {
+				if (live[v] == 0)
+					continue;
+
+				int64_t priority = 0;
+				if (time - cache_time[v] + 2 * live[v] <= cache_size)
+					priority = time - cache_time[v];
+				if (priority > best) {
+					best = priority;
+					fanning = v;
+				}
+			}
+
+			while (fanning < 0 && !dead_end.empty()) {
+				uint32_t v = dead_end.back();
+				dead_end.pop_back();
+				if (live[v] > 0)
+					fanning = v;
+			}
+
+			while (fanning < 0 && cursor < range) {
+				if (live[cursor] > 0)
+					fanning = cursor;
+				else
+					cursor++;
+			}
+		}
+
+		std::copy(output.begin(), output.end(), indices);
+	}
+
+	static uint32_t count_cache_misses(const uint32_t* indices, size_t index_count, uint32_t cache_size, std::vector<uint32_t>* triangle_misses) {
+		//A FIFO cache is simulated with time stamps instead of a queue.
+		uint32_t base = index_count ? *std::min_element(indices, indices + index_count) : 0;
+		uint32_t range = index_count ? *std::max_element(indices, indices + index_count) - base + 1 : 0;
+		std::vector<uint32_t> cache_time(range, 0);
+
+		uint32_t time = cache_size + 1, misses = 0;
+		for (size_t i = 0; i + 2 < index_count; i += 3) {
+			uint32_t triangle = 0;
+			for (uint32_t j = 0; j < 3; j++) {
+				uint32_t v = indices[i + j] - base;
+				if (time - cache_time[v] > cache_size) {
+					cache_time[v] = time++;
+					triangle++;
+				}
+			}
+
+			misses += triangle;
+			if (triangle_misses)
+				triangle_misses->push_back(triangle);
+		}
+		return misses;
+	}
+
+	VertexCacheStatistics analyze_vertex_cache(const uint32_t* indices, size_t index_count, uint32_t vertex_count, uint32_t cache_size) {
+		VertexCacheStatistics statistics;
+		statistics.misses = count_cache_misses(indices, index_count, cache_size, nullptr);
+		statistics.acmr = (index_count >= 3) ? statistics.misses / (float)(index_count / 3) : 0.0f;
+		statistics.atvr = vertex_count ? statistics.misses / (float)vertex_count : 0.0f;
+		return statistics;
+	}
+
+	void optimize_overdraw(uint32_t* indices, size_t index_count, const void* positions, uint32_t vertex_stride, uint32_t cache_size, float threshold) {
+		size_t triangle_count = index_count / 3;
+		if (triangle_count < 2)
+			return;
+
+		auto get_position = [&](uint32_t v) {
+			const float* p = (const float*)((const uint8_t*)positions + (size_t)v * vertex_stride);
+			return glm::vec3(p[0], p[1], p[2]);
+		};
+
+		//A triangle that misses on all three vertices starts a new cluster, the cache order breaks there anyway.
+		std::vector<uint32_t> triangle_misses;
+		uint32_t original_misses = count_cache_misses(indices, index_count, cache_size, &triangle_misses);
+
+		std::vector<uint32_t> clusters;
+		for (uint32_t t = 0; t < (uint32_t)triangle_count; t++) {
+			if (t == 0 || triangle_misses[t] == 3)
+				clusters.push_back(t);
+		}
+		if (clusters.size() < 2)
+			return;
+		clusters.push_back((uint32_t)triangle_count);
+
+		glm::vec3 mesh_center(0.0f);
+		float mesh_area = 0.0f;
+		std::vector<std::pair<float, uint32_t>> order;
+		std::vector<glm::vec3> centers, normals;
+
+		for (size_t c = 0; c + 1 < clusters.size(); c++) {
+			glm::vec3 center(0.0f), normal(0.0f);
+			float area = 0.0f;
+			for (uint32_t t = clusters[c]; t < clusters[c + 1]; t++) {
+				glm::vec3 a = get_position(indices[t * 3]), b = get_position(indices[t * 3 + 1]), c2 = get_position(indices[t * 3 + 2]);
+				glm::vec3 face = glm::cross(b - a, c2 - a);
+				float face_area = glm::length(face);
+
+				center += (a + b + c2) * (face_area / 3.0f);
+				normal += face;
+				area += face_area;
+			}
+
+			mesh_center += center;
+			mesh_area += area;
+			centers.push_back(area > 0.0f ? center / area : get_position(indices[clusters[c] * 3]));
+			normals.push_back(glm::length(normal) > 0.0f ? glm::normalize(normal) : glm::vec3(0.0f));
+		}
+		mesh_center = (mesh_area > 0.0f) ? mesh_center / mesh_area : centers[0];
+
+		//Clusters facing away from the center are likely occluders, draw them first.
+		for (uint32_t c = 0; c < (uint32_t)centers.size(); c++)
+			order.push_back({ glm::dot(centers[c] - mesh_center, normals[c]), c });
+		std::stable_sort(order.begin(), order.end(), [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) { return a.first > b.first; });
+
+		std::vector<uint32_t> output;
+		output.reserve(triangle_count * 3);
+		for (auto& cluster : order)
+			output.insert(output.end(), indices + clusters[cluster.second] * 3, indices + clusters[cluster.second + 1] * 3);
+
+		uint32_t misses = count_cache_misses(output.data(), output.size(), cache_size, nullptr);
+		if (misses <= original_misses * threshold)
+			std::copy(output.begin(), output.end(), indices);
+	}
+
+	uint32_t optimize_vertex_fetch(void* vertices, uint32_t vertex_count, uint32_t vertex_size, uint32_t* indices, size_t index_count) {
+		std::vector<uint32_t> remap(vertex_count, OPTIMIZER_UNUSED);
+		uint32_t next = 0;
+		for (size_t i = 0; i < index_count; i++) {
+			uint32_t& target = remap[indices[i]];
+			if (target == OPTIMIZER_UNUSED)
+				target = next++;
+			indices[i] = target;
+		}
+
+		//Vertices nothing references are dropped.
+		uint8_t* data = (uint8_t*)vertices;
+		std::vector<uint8_t> copy(data, data + (size_t)vertex_count * vertex_size);
+		for (uint32_t v = 0; v < vertex_count; v++) {
+			if (remap[v] != OPTIMIZER_UNUSED)
+				memcpy(data + (size_t)remap[v] * vertex_size, copy.data() + (size_t)v * vertex_size, vertex_size);
+		}
+		return next;
+	}
+
+	static uint32_t optimize_ranges(void* vertices, uint32_t vertex_count, uint32_t vertex_size, uint32_t* indices, size_t index_count, const std::vector<std::pair<uint32_t, uint32_t>>& ranges, const MeshOptimizerSettings& settings, MeshOptimizerStatistics& statistics) {
+		statistics.vertices_before = vertex_count;
+		statistics.before = analyze_vertex_cache(indices, index_count, vertex_count, settings.cache_size);
+
+		if (settings.weld)
+			vertex_count = weld_vertices(vertices, vertex_count, vertex_size, indices, index_count);
+
+		//Triangles never move between ranges, every range is one draw.
+		for (auto& range : ranges) {
+			optimize_vertex_cache(indices + range.first, range.second, settings.cache_size);
+			if (settings.optimize_overdraw)
+				optimize_overdraw(indices + range.first, range.second, vertices, vertex_size, settings.cache_size, settings.overdraw_threshold);
+		}
+
+		vertex_count = optimize_vertex_fetch(vertices, vertex_count, vertex_size, indices, index_count);
+		statistics.vertices_after = vertex_count;
+		statistics.after = analyze_vertex_cache(indices, index_count, vertex_count, settings.cache_size);
+		return vertex_count;
+	}
+
+	MeshOptimizerStatistics optimize_mesh(Mesh& mesh, const MeshOptimizerSettings& settings) {
+		MeshOptimizerStatistics statistics;
+		if (mesh.indices.size() < 3)
+			return statistics;
+
+		uint32_t count = optimize_ranges(mesh.vertices.data(), (uint32_t)mesh.vertices.size(), sizeof(Vertex), mesh.indices.data(), mesh.indices.size(), { { 0, (uint32_t)mesh.indices.size() } }, settings, statistics);
+		mesh.vertices.resize(count);
+		return statistics;
+	}
+
+	MeshOptimizerStatistics optimize_mesh(Model& model, const MeshOptimizerSettings& settings) {
+		MeshOptimizerStatistics statistics;
+		if (model.indices.size() < 3)
+			return statistics;
+
+		std::vector<std::pair<uint32_t, uint32_t>> ranges;
+		for (const ModelPrimitive& primitive : model.primitives)
+			ranges.push_back({ primitive.index_offset, primitive.index_count });
+		if (ranges.empty())
+			ranges.push_back({ 0, (uint32_t)model.indices.size() });
+
+		uint32_t count = optimize_ranges(model.vertices.data(), (uint32_t)model.vertices.size(), sizeof(ModelVertex), model.indices.data(), model.indices.size(), ranges, settings, statistics);
+		model.vertices.resize(count);
+		return statistics;
+	}
+}
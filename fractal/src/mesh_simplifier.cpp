@@ -0,0 +1,344 @@
+/**
+ * @file mesh_simplifier.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains a quadric error metric mesh simplifier.
+ */
+
+#include "mesh_simplifier.h"
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cfloat>
+#include <glm/glm.hpp>
+
+namespace Fractal {
+	//Border edges get an extra perpendicular plane so the silhouette of open meshes holds its shape.
+	constexpr double BORDER_WEIGHT = 10.0;
+	constexpr uint32_t MAX_SIMPLIFY_PASSES = 100;
+
+	enum VertexKind : uint8_t {
+		Manifold = 0,
+		Border,
+		//Seams and non manifold vertices never move.
+		Locked
+	};
+
+	struct Quadric {
+		double a00 = 0.0, a11 = 0.0, a22 = 0.0;
+		double a10 = 0.0, a20 = 0.0, a21 = 0.0;
+		double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+		double c = 0.0;
+		double w = 0.0;
+
+		void add_plane(const glm::dvec3& n, double d, double weight) {
+			a00 += weight * n.x * n.x;
+			a11 += weight * n.y * n.y;
+			a22 += weight * n.z * n.z;
+			a10 += weight * n.y * n.x;
+			a20 += weight * n.z * n.x;
+			a21 += weight * n.z * n.y;
+			b0 += weight * n.x * d;
+			b1 += weight * n.y * d;
+			b2 += weight * n.z * d;
+			c += weight * d * d;
+			w += weight;
+		}
+
+		void add(const Quadric& q) {
+			a00 += q.a00; a11 += q.a11; a22 += q.a22;
+			a10 += q.a10; a20 += q.a20; a21 += q.a21;
+			b0 += q.b0; b1 += q.b1; b2 += q.b2;
+			c += q.c;
+			w += q.w;
+		}
+
+		//Weighted mean of the squared distances to every plane.
+		double error(const glm::vec3& p) const {
+			double x = p.x, y = p.y, z = p.z;
+			double e = a00 * x * x + a11 * y * y + a22 * z * z
+				+ 2.0 * (a10 * x * y + a20 * x * z + a21 * y * z)
+				+ 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+			return (w > 0.0) ? std::max(e / w, 0.0) : 0.0;
+		}
+	};
+
+	struct Collapse {
+		uint32_t v0;
+		uint32_t v1;
+		float cost;
+	};
+
+	static inline uint64_t edge_key(uint32_t a, uint32_t b) {
+		return (a < b) ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+	}
+
+	static double collapse_cost(const std::vector<Quadric>& quadrics, const std::vector<glm::vec3>& positions, uint32_t v0, uint32_t v1) {
+		Quadric q = quadrics[v0];
+		q.add(quadrics[v1]);
+		return q.error(positions[v1]);
+	}
+
+	static bool can_collapse(const std::vector<uint8_t>& kinds, uint32_t v0, uint32_t v1, bool border_edge) {
+		if (kinds[v0] == Locked)
+			return false;
+		//Border vertices may only slide along the border.
+		if (kinds[v0] == Border)
+			return border_edge && kinds[v1] != Manifold;
+		return true;
+	}
+
+	size_t simplify_mesh(uint32_t* destination, const uint32_t* indices, size_t index_count, const void* positions, uint32_t vertex_count, uint32_t vertex_stride,
+		size_t target_index_count, float target_error, float* result_error) {
+		size_t count = index_count - index_count % 3;
+		if (destination != indices)
+			memcpy(destination, indices, count * sizeof(uint32_t));
+		if (result_error)
+			*result_error = 0.0f;
+		if (count <= target_index_count || vertex_count == 0)
+			return count;
+
+		//Normalize positions so the error is relative to the mesh extent.
+		std::vector<glm::vec3> points(vertex_count);
+		glm::vec3 min(FLT_MAX), max(-FLT_MAX);
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			const float* p = (const float*)((const uint8_t*)positions + (size_t)i * vertex_stride);
+			points[i] = glm::vec3(p[0], p[1], p[2]);
+			min = glm::min(min, points[i]);
+			max = glm::max(max, points[i]);
+		}
+		glm::vec3 extent = max - min;
+		float scale = std::max(extent.x, std::max(extent.y, extent.z));
+		scale = (scale > 0.0f) ? 1.0f / scale : 1.0f;
+		for (glm::vec3& p : points)
+			p = (p - min) * scale;
+
+		std::vector<uint8_t> kinds(vertex_count, Manifold);
+
+		//Vertices that share a position with another vertex sit on an attribute seam.
+		{
+			std::vector<uint32_t> order(vertex_count);
+			for (uint32_t i = 0; i < vertex_count; i++)
+				order[i] = i;
+			auto less = [&](uint32_t a, uint32_t b) {
+				const glm::vec3& pa = points[a];
+				const glm::vec3& pb = points[b];
+				if (pa.x != pb.x) return pa.x < pb.x;
+				if (pa.y != pb.y) return pa.y < pb.y;
+				return pa.z < pb.z;
+			};
+			std::sort(order.begin(), order.end(), less);
+			for (uint32_t i = 0; i + 1 < vertex_count; i++) {
+				if (points[order[i]] == points[order[i + 1]])
+					kinds[order[i]] = kinds[order[i + 1]] = Locked;
+			}
+		}
+
+		std::vector<uint64_t> edges;
+		edges.reserve(count);
+		auto build_edges = [&]() {
+			edges.clear();
+			for (size_t i = 0; i < count; i += 3) {
+				edges.push_back(edge_key(destination[i + 0], destination[i + 1]));
+				edges.push_back(edge_key(destination[i + 1], destination[i + 2]));
+				edges.push_back(edge_key(destination[i + 2], destination[i + 0]));
+			}
+			std::sort(edges.begin(), edges.end());
+		};
+
+		//Triangle planes weighted by area, plus border planes.
+		std::vector<Quadric> quadrics(vertex_count);
+		for (size_t i = 0; i < count; i += 3) {
+			uint32_t v[3] = { destination[i + 0], destination[i + 1], destination[i + 2] };
+			glm::dvec3 p0 = points[v[0]], p1 = points[v[1]], p2 = points[v[2]];
+			glm::dvec3 n = glm::cross(p1 - p0, p2 - p0);
+			double length = glm::length(n);
+			if (length <= 0.0)
+				continue;
+			n /= length;
+			for (int k = 0; k < 3; k++)
+				quadrics[v[k]].add_plane(n, -glm::dot(n, p0), length * 0.5);
+		}
+
+		build_edges();
+		for (size_t i = 0; i < edges.size();) {
+			size_t run = 1;
+			while (i + run < edges.size() && edges[i + run] == edges[i])
+				run++;
+			uint32_t a = (uint32_t)(edges[i] >> 32), b = (uint32_t)(edges[i] & 0xffffffff);
+			if (run > 2) {
+				kinds[a] = kinds[b] = Locked;
+			}
+			else if (run == 1 && a != b) {
+				for (uint32_t v : { a, b }) {
+					if (kinds[v] == Manifold)
+						kinds[v] = Border;
+				}
+			}
+			i += run;
+		}
+
+		for (size_t i = 0; i < count; i += 3) {
+			for (int k = 0; k < 3; k++) {
+				uint32_t a = destination[i + k], b = destination[i + (k + 1) % 3];
+				uint64_t key = edge_key(a, b);
+				auto range = std::equal_range(edges.begin(), edges.end(), key);
+				if (range.second - range.first != 1)
+					continue;
+				uint32_t c = destination[i + (k + 2) % 3];
+				glm::dvec3 pa = points[a], pb = points[b], pc = points[c];
+				glm::dvec3 edge = pb - pa;
+				glm::dvec3 normal = glm::cross(edge, pc - pa);
+				glm::dvec3 n = glm::cross(edge, normal);
+				double length = glm::length(n);
+				if (length <= 0.0)
+					continue;
+				n /= length;
+				double weight = glm::dot(edge, edge) * BORDER_WEIGHT;
+				quadrics[a].add_plane(n, -glm::dot(n, pa), weight);
+				quadrics[b].add_plane(n, -glm::dot(n, pa), weight);
+			}
+		}
+
+		size_t triangle_count = count / 3;
+		size_t target_triangles = target_index_count / 3;
+		double error_limit = (double)target_error * target_error;
+		double max_error = 0.0;
+
+		std::vector<Collapse> collapses;
+		std::vector<uint32_t> adjacency_offsets(vertex_count + 1);
+		std::vector<uint32_t> adjacency;
+		std::vector<uint8_t> dirty(vertex_count);
+		std::vector<uint32_t> remap(vertex_count);
+
+		for (uint32_t pass = 0; pass < MAX_SIMPLIFY_PASSES && triangle_count > target_triangles; pass++) {
+			if (pass > 0)
+				build_edges();
+
+			collapses.clear();
+			for (size_t i = 0; i < edges.size();) {
+				size_t run = 1;
+				while (i + run < edges.size() && edges[i + run] == edges[i])
+					run++;
+				uint32_t a = (uint32_t)(edges[i] >> 32), b = (uint32_t)(edges[i] & 0xffffffff);
+				i += run;
+				if (run > 2) {
+					kinds[a] = kinds[b] = Locked;
+					continue;
+				}
+
+				bool border_edge = (run == 1);
+				bool ab = can_collapse(kinds, a, b, border_edge);
+				bool ba = can_collapse(kinds, b, a, border_edge);
+				double cost_ab = ab ? collapse_cost(quadrics, points, a, b) : DBL_MAX;
+				double cost_ba = ba ? collapse_cost(quadrics, points, b, a) : DBL_MAX;
+				if (ab && (!ba || cost_ab <= cost_ba))
+					collapses.push_back({ a, b, (float)cost_ab });
+				else if (ba)
+					collapses.push_back({ b, a, (float)cost_ba });
+			}
+			if (collapses.empty())
+				break;
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+			//Vertex to triangle adjacency.
+			std::fill(adjacency_offsets.begin(), adjacency_offsets.end(), 0);
+			for (size_t i = 0; i < count; i++)
+				adjacency_offsets[destination[i] + 1]++;
+			for (uint32_t i = 0; i < vertex_count; i++)
+				adjacency_offsets[i + 1] += adjacency_offsets[i];
+			adjacency.resize(count);
+			{
+				std::vector<uint32_t> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+				for (size_t i = 0; i < count; i++)
+					adjacency[fill[destination[i]]++] = (uint32_t)(i / 3);
+			}
+
+			std::fill(dirty.begin(), dirty.end(), 0);
+			for (uint32_t i = 0; i < vertex_count; i++)
+				remap[i] = i;
+
+			size_t applied = 0;
+			bool limit_reached = false;
+			for (const Collapse& collapse : collapses) {
+				if (triangle_count <= target_triangles)
+					break;
+				if (collapse.cost > error_limit) {
+					limit_reached = true;
+					break;
+				}
+
+				uint32_t v0 = collapse.v0, v1 = collapse.v1;
+				if (dirty[v0] || dirty[v1])
+					continue;
+
+				//Reject collapses that flip or squash the triangles around v0.
+				size_t removed = 0;
+				bool flipped = false;
+				for (uint32_t j = adjacency_offsets[v0]; j < adjacency_offsets[v0 + 1] && !flipped; j++) {
+					const uint32_t* t = &destination[adjacency[j] * 3];
+					if (t[0] == v1 || t[1] == v1 || t[2] == v1) {
+						removed++;
+						continue;
+					}
+					int k = (t[0] == v0) ? 0 : (t[1] == v0) ? 1 : 2;
+					const glm::vec3& pb = points[t[(k + 1) % 3]];
+					const glm::vec3& pc = points[t[(k + 2) % 3]];
+					glm::vec3 before = glm::cross(pb - points[v0], pc - points[v0]);
+					glm::vec3 after = glm::cross(pb - points[v1], pc - points[v1]);
+					float length = glm::length(before);
+					if (length > 0.0f && glm::dot(before, after) <= 0.25f * length * glm::length(after))
+						flipped = true;
+				}
+				if (flipped)
+					continue;
+
+				remap[v0] = v1;
+				quadrics[v1].add(quadrics[v0]);
+				for (uint32_t v : { v0, v1 }) {
+					for (uint32_t j = adjacency_offsets[v]; j < adjacency_offsets[v + 1]; j++) {
+						const uint32_t* t = &destination[adjacency[j] * 3];
+						dirty[t[0]] = dirty[t[1]] = dirty[t[2]] = 1;
+					}
+				}
+
+				triangle_count -= std::min(removed, triangle_count);
+				max_error = std::max(max_error, (double)collapse.cost);
+				applied++;
+			}
+
+			//Rewrite the index buffer without the collapsed triangles.
+			size_t write = 0;
+			for (size_t i = 0; i < count; i += 3) {
+				uint32_t a = remap[destination[i + 0]], b = remap[destination[i + 1]], c = remap[destination[i + 2]];
+				if (a == b || b == c || c == a)
+					continue;
+				destination[write + 0] = a;
+				destination[write + 1] = b;
+				destination[write + 2] = c;
+				write += 3;
+			}
+			count = write;
+			triangle_count = count / 3;
+
+			if (applied == 0 || limit_reached)
+				break;
+		}
+
+		if (result_error)
+			*result_error = (float)std::sqrt(max_error);
+		return count;
+	}
+}
@@ -0,0 +1,195 @@
+/**
+ * @file model.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the imported model container, normal generation and
+ * the binary model layout used by asset packs.
+ */
+
+#include "model.h"
+#include "asset_pack.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Fractal {
+	struct ModelHeader {
+		uint32_t vertex_count;
+		uint32_t index_count;
+		uint32_t primitive_count;
+		uint32_t material_count;
+	};
+
+	void Model::clear() {
+		vertices.clear();
+		indices.clear();
+		primitives.clear();
+		materials.clear();
+	}
+
+	bool load_model(const std::string& path, Model& model, const ModelImportSettings& settings) {
+		model.clear();
+
+		if (load_packed_model(path, model))
+			return true;
+#ifdef FRACTAL_COOKED_ASSETS
+		(void)settings;
+		FRACTAL_LOG_ERROR("Model '%s' is not in a mounted asset pack", path.c_str());
+		return false;
+#else
+		return import_model(path, model, settings);
+#endif
+	}
+
+	bool import_model(const std::string& path, Model& model, const ModelImportSettings& settings) {
+		model.clear();
+
+		std::string extension = path.substr(path.find_last_of('.') + 1);
+		std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+		if (extension == "obj")
+			return load_obj(path, model, settings);
+		else if (extension == "gltf" || extension == "glb")
+			return load_gltf(path, model, settings);
+
+		FRACTAL_LOG_ERROR("Unsupported model format '%s'", path.c_str());
+		return false;
+	}
+
+	void generate_normals(Model& model) {
+		for (ModelVertex& vertex : model.vertices)
+			vertex.normals = glm::vec3(0.0f);
+
+		//Unnormalized face normals weight each face by its area.
+		for (size_t i = 0; i + 2 < model.indices.size(); i += 3) {
+			ModelVertex& a = model.vertices[model.indices[i]];
+			ModelVertex& b = model.vertices[model.indices[i + 1]];
+			ModelVertex& c = model.vertices[model.indices[i + 2]];
+
+			glm::vec3 normal = glm::cross(b.position - a.position, c.position - a.position);
+			a.normals += normal;
+			b.normals += normal;
+			c.normals += normal;
+		}
+
+		for (ModelVertex& vertex : model.vertices) {
+			float length = glm::length(vertex.normals);
+			vertex.normals = (length > 0.0f) ? vertex.normals / length : glm::vec3(0.0f, 1.0f, 0.0f);
+		}
+	}
+
+	template <typename T>
+	static void write_data(std::vector<uint8_t>& data, const T* values, size_t count) {
+		size_t offset = data.size();
+		data.resize(offset + sizeof(T) * count);
+		if (count)
+			memcpy(data.data() + offset, values, sizeof(T) * count);
+	}
+
+	static void write_string(std::vector<uint8_t>& data, const std::string& string) {
+		uint32_t length = (uint32_t)string.size();
+		write_data(data, &length, 1);
+		write_data(data, string.data(), string.size());
+	}
+
+	void serialize_model(const Model& model, std::vector<uint8_t>& data) {
+		ModelHeader header = { (uint32_t)model.vertices.size(), (uint32_t)model.indices.size(), (uint32_t)model.primitives.size(), (uint32_t)model.materials.size() };
+
+		data.clear();
+		write_data(data, &header, 1);
+		write_data(data, model.vertices.data(), model.vertices.size());
+		write_data(data, model.indices.data(), model.indices.size());
+
+		for (const ModelPrimitive& primitive : model.primitives) {
+			uint32_t range[3] = { primitive.index_offset, primitive.index_count, primitive.material };
+			write_data(data, range, 3);
+			write_string(data, primitive.name);
+		}
+
+		for (const std::string& material : model.materials)
+			write_string(data, material);
+	}
+
+	class ModelReader {
+	public:
+		ModelReader(const uint8_t* data, uint64_t size) : m_data(data), m_size(size) { }
+
+		bool read(void* output, uint64_t size) {
+			if (size > m_size - m_offset)
+				return false;
+			memcpy(output, m_data + m_offset, (size_t)size);
+			m_offset += size;
+			return true;
+		}
+
+		bool read_string(std::string& string) {
+			uint32_t length = 0;
+			if (!read(&length, sizeof(length)) || length > m_size - m_offset)
+				return false;
+			string.assign((const char*)m_data + m_offset, length);
+			m_offset += length;
+			return true;
+		}
+
+		inline uint64_t remaining() const { return m_size - m_offset; }
+	private:
+		const uint8_t* m_data;
+		uint64_t m_size;
+		uint64_t m_offset = 0;
+	};
+
+	bool deserialize_model(const uint8_t* data, uint64_t size, Model& model) {
+		model.clear();
+
+		ModelReader reader(data, size);
+		ModelHeader header;
+		if (!reader.read(&header, sizeof(header)))
+			return false;
+
+		if ((uint64_t)header.vertex_count * sizeof(ModelVertex) + (uint64_t)header.index_count * sizeof(uint32_t) > reader.remaining())
+			return false;
+
+		model.vertices.resize(header.vertex_count);
+		model.indices.resize(header.index_count);
+		reader.read(model.vertices.data(), (uint64_t)header.vertex_count * sizeof(ModelVertex));
+		reader.read(model.indices.data(), (uint64_t)header.index_count * sizeof(uint32_t));
+
+		model.primitives.resize(header.primitive_count);
+		for (ModelPrimitive& primitive : model.primitives) {
+			uint32_t range[3];
+			if (!reader.read(range, sizeof(range)) || !reader.read_string(primitive.name))
+				return false;
+			primitive.index_offset = range[0];
+			primitive.index_count = range[1];
+			primitive.material = range[2];
+		}
+
+		model.materials.resize(header.material_count);
+		for (std::string& material : model.materials) {
+			if (!reader.read_string(material))
+				return false;
+		}
+
+		//A corrupt mesh would otherwise fetch and draw past the end of its buffers.
+		for (uint32_t index : model.indices) {
+			if (index >= header.vertex_count)
+				return false;
+		}
+		for (const ModelPrimitive& primitive : model.primitives) {
+			if ((uint64_t)primitive.index_offset + primitive.index_count > header.index_count)
+				return false;
+		}
+		return true;
+	}
+}
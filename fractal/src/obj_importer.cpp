@@ -0,0 +1,489 @@
+/**
+ * @file obj_importer.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the Wavefront OBJ importer. The mapped file is split
+ * into line aligned chunks that are counted and then parsed in parallel,
+ * after which face corners are welded into an indexed vertex buffer.
+ */
+
+#include "model.h"
+#include "mesh_optimizer.h"
+#include "mapped_file.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+
+namespace Fractal {
+	constexpr uint32_t OBJ_MISSING = 0xFFFFFFFF;
+
+	struct ObjCorner {
+		uint32_t position;
+		uint32_t uv;
+		uint32_t normal;
+	};
+
+	struct ObjGroup {
+		uint32_t triangle;
+		bool material;
+		std::string name;
+	};
+
+	struct ObjChunk {
+		const char* begin;
+		const char* end;
+
+		uint32_t position_count = 0;
+		uint32_t uv_count = 0;
+		uint32_t normal_count = 0;
+		uint32_t face_count = 0;
+
+		uint32_t position_base = 0;
+		uint32_t uv_base = 0;
+		uint32_t normal_base = 0;
+
+		std::vector<ObjCorner> corners;
+		std::vector<ObjGroup> groups;
+		bool has_colors = false;
+		bool has_missing_normals = false;
+		const char* error = nullptr;
+	};
+
+	struct ObjData {
+		std::vector<glm::vec3> positions;
+		std::vector<glm::vec3> colors;
+		std::vector<glm::vec2> uvs;
+		std::vector<glm::vec3> normals;
+	};
+
+	static inline bool is_space(char c) {
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	static inline const char* skip_spaces(const char* p, const char* end) {
+		while (p < end && is_space(*p))
+			p++;
+		return p;
+	}
+
+	static inline const char* next_line(const char* p, const char* end) {
+		const char* newline = (const char*)memchr(p, '\n', end - p);
+		return newline ? newline + 1 : end;
+	}
+
+	static const char* parse_float(const char* p, const char* end, float& value) {
+		static const double POWERS[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+		p = skip_spaces(p, end);
+		bool negative = false;
+		if (p < end && (*p == '-' || *p == '+'))
+			negative = (*p++ == '-');
+
+		//Digits past the 19th cannot change a float, they only shift the exponent.
+		uint64_t mantissa = 0;
+		int exponent = 0, digits = 0;
+		while (p < end && *p >= '0' && *p <= '9') {
+			if (digits++ < 19)
+				mantissa = mantissa * 10 + (*p - '0');
+			else
+				exponent++;
+			p++;
+		}
+
+		if (p < end && *p == '.') {
+			p++;
+			while (p < end && *p >= '0' && *p <= '9') {
+				if (digits++ < 19) {
+					mantissa = mantissa * 10 + (*p - '0');
+					exponent--;
+				}
+				p++;
+			}
+		}
+
+		if (p < end && (*p == 'e' || *p == 'E')) {
+			p++;
+			bool negative_exponent = false;
+			if (p < end && (*p == '-' || *p == '+'))
+				negative_exponent = (*p++ == '-');
+
+			int e = 0;
+			while (p < end && *p >= '0' && *p <= '9')
+				e = std::min(e * 10 + (*p++ - '0'), 1000);
+			exponent += negative_exponent ? -e : e;
+		}
+
+		double result = (double)mantissa;
+		if (exponent < 0)
+			result = (exponent >= -22) ? result / POWERS[-exponent] : result * pow(10.0, exponent);
+		else if (exponent > 0)
+			result = (exponent <= 22) ? result * POWERS[exponent] : result * pow(10.0, exponent);
+
+		value = (float)(negative ? -result : result);
+		return p;
+	}
+
+	static const char* parse_int(const char* p, const char* end, int64_t& value) {
+		bool negative = false;
+		if (p < end && (*p == '-' || *p == '+'))
+			negative = (*p++ == '-');
+
+		value = 0;
+		while (p < end && *p >= '0' && *p <= '9')
+			value = value * 10 + (*p++ - '0');
+		if (negative)
+			value = -value;
+		return p;
+	}
+
+	static inline bool is_keyword(const char* p, const char* end, const char* keyword, size_t length) {
+		return (size_t)(end - p) > length && memcmp(p, keyword, length) == 0 && is_space(p[length]);
+	}
+
+	static void count_chunk(ObjChunk& chunk) {
+		for (const char* p = chunk.begin; p < chunk.end; p = next_line(p, chunk.end)) {
+			p = skip_spaces(p, chunk.end);
+			if (chunk.end - p < 2)
+				continue;
+
+			if (p[0] == 'v') {
+				if (is_space(p[1]))
+					chunk.position_count++;
+				else if (p[1] == 't')
+					chunk.uv_count++;
+				else if (p[1] == 'n')
+					chunk.normal_count++;
+			}
+			else if (p[0] == 'f' && is_space(p[1]))
+				chunk.face_count++;
+		}
+	}
+
+	static uint32_t resolve_index(int64_t index, uint32_t base, uint32_t local, uint32_t total) {
+		//Negative indices count back from the last element read so far.
+		int64_t resolved = (index > 0) ? index - 1 : (int64_t)base + local + index;
+		return (index == 0 || resolved < 0 || resolved >= total) ? OBJ_MISSING - 1 : (uint32_t)resolved;
+	}
+
+	static void parse_chunk(ObjChunk& chunk, ObjData& data, uint32_t position_total, uint32_t uv_total, uint32_t normal_total) {
+		uint32_t positions = 0, uvs = 0, normals = 0;
+		chunk.corners.reserve(chunk.face_count * 3);
+
+		for (const char* p = chunk.begin; p < chunk.end && !chunk.error; p = next_line(p, chunk.end)) {
+			p = skip_spaces(p, chunk.end);
+			const char* end = (const char*)memchr(p, '\n', chunk.end - p);
+			if (!end)
+				end = chunk.end;
+			if (end - p < 2)
+				continue;
+
+			if (p[0] == 'v' && is_space(p[1])) {
+				glm::vec3& position = data.positions[chunk.position_base + positions];
+				p = parse_float(p + 1, end, position.x);
+				p = parse_float(p, end, position.y);
+				p = parse_float(p, end, position.z);
+
+				//Some exporters append a vertex color after the position, a single extra value is a w coordinate.
+				float extra[3];
+				uint32_t extra_count = 0;
+				for (p = skip_spaces(p, end); p < end && *p != '#' && extra_count < 3; p = skip_spaces(p, end))
+					p = parse_float(p, end, extra[extra_count++]);
+
+				if (extra_count == 3) {
+					data.colors[chunk.position_base + positions] = glm::vec3(extra[0], extra[1], extra[2]);
+					chunk.has_colors = true;
+				}
+				positions++;
+			}
+			else if (p[0] == 'v' && p[1] == 't') {
+				glm::vec2& uv = data.uvs[chunk.uv_base + uvs++];
+				p = parse_float(p + 2, end, uv.x);
+				p = parse_float(p, end, uv.y);
+			}
+			else if (p[0] == 'v' && p[1] == 'n') {
+				glm::vec3& normal = data.normals[chunk.normal_base + normals++];
+				p = parse_float(p + 2, end, normal.x);
+				p = parse_float(p, end, normal.y);
+				p = parse_float(p, end, normal.z);
+			}
+			else if (p[0] == 'f' && is_space(p[1])) {
+				ObjCorner first = { }, previous = { };
+				uint32_t corner_count = 0;
+
+				for (p = skip_spaces(p + 1, end); p < end && *p != '#'; p = skip_spaces(p, end)) {
+					int64_t index = 0;
+					ObjCorner corner = { OBJ_MISSING, OBJ_MISSING, OBJ_MISSING };
+
+					p = parse_int(p, end, index);
+					corner.position = resolve_index(index, chunk.position_base, positions, position_total);
+					if (p < end && *p == '/') {
+						p++;
+						if (p < end && *p != '/') {
+							p = parse_int(p, end, index);
+							corner.uv = resolve_index(index, chunk.uv_base, uvs, uv_total);
+						}
+						if (p < end && *p == '/') {
+							p = parse_int(p + 1, end, index);
+							corner.normal = resolve_index(index, chunk.normal_base, normals, normal_total);
+						}
+					}
+
+					if (corner.position == OBJ_MISSING - 1 || corner.uv == OBJ_MISSING - 1 || corner.normal == OBJ_MISSING - 1) {
+						chunk.error = "face references a vertex that does not exist";
+						break;
+					}
+
+					if (p < end && !is_space(*p)) {
+						chunk.error = "malformed face";
+						break;
+					}
+
+					chunk.has_missing_normals |= (corner.normal == OBJ_MISSING);
+					if (corner_count == 0)
+						first = corner;
+					else if (corner_count >= 2) {
+						chunk.corners.push_back(first);
+						chunk.corners.push_back(previous);
+						chunk.corners.push_back(corner);
+					}
+					previous = corner;
+					corner_count++;
+				}
+
+				if (!chunk.error && corner_count < 3)
+					chunk.error = "face has fewer than three corners";
+			}
+			else if (is_keyword(p, end, "usemtl", 6) || is_keyword(p, end, "o", 1) || is_keyword(p, end, "g", 1)) {
+				bool material = (p[0] == 'u');
+				const char* name = skip_spaces(p + (material ? 6 : 1), end);
+				const char* name_end = end;
+				while (name_end > name && is_space(name_end[-1]))
+					name_end--;
+
+				chunk.groups.push_back({ (uint32_t)(chunk.corners.size() / 3), material, std::string(name, name_end) });
+			}
+		}
+	}
+
+	struct ObjVertexKey {
+		ObjCorner corner;
+		uint32_t material;
+	};
+
+	class VertexWelder {
+	public:
+		VertexWelder(size_t expected) {
+			size_t capacity = 1024;
+			while (capacity < expected * 2)
+				capacity <<= 1;
+			m_slots.assign(capacity, OBJ_MISSING);
+			m_keys.reserve(expected);
+		}
+
+		//Returns the existing vertex for this corner and material or adds a new one.
+		uint32_t insert(const ObjVertexKey& key, bool& inserted) {
+			if ((m_keys.size() + 1) * 2 > m_slots.size())
+				grow();
+
+			size_t mask = m_slots.size() - 1;
+			for (size_t slot = hash(key) & mask;; slot = (slot + 1) & mask) {
+				uint32_t index = m_slots[slot];
+				if (index == OBJ_MISSING) {
+					m_slots[slot] = (uint32_t)m_keys.size();
+					m_keys.push_back(key);
+					inserted = true;
+					return m_slots[slot];
+				}
+
+				const ObjVertexKey& other = m_keys[index];
+				if (other.corner.position == key.corner.position && other.corner.uv == key.corner.uv && other.corner.normal == key.corner.normal && other.material == key.material) {
+					inserted = false;
+					return index;
+				}
+			}
+		}
+	private:
+		static inline size_t hash(const ObjVertexKey& key) {
+			uint64_t h = key.corner.position * 0x9E3779B97F4A7C15ull;
+			h ^= (key.corner.uv + 0x632BE59BD9B4E019ull) * 0xC2B2AE3D27D4EB4Full;
+			h ^= (key.corner.normal + 0x8CB92BA72F3D8DD7ull) * 0x165667B19E3779F9ull;
+			h ^= (key.material + 0x27D4EB2F165667C5ull) * 0x94D049BB133111EBull;
+			return (size_t)(h ^ (h >> 29));
+		}
+
+		void grow() {
+			m_slots.assign(m_slots.size() * 2, OBJ_MISSING);
+			size_t mask = m_slots.size() - 1;
+			for (uint32_t i = 0; i < (uint32_t)m_keys.size(); i++) {
+				size_t slot = hash(m_keys[i]) & mask;
+				while (m_slots[slot] != OBJ_MISSING)
+					slot = (slot + 1) & mask;
+				m_slots[slot] = i;
+			}
+		}
+	private:
+		std::vector<uint32_t> m_slots;
+		std::vector<ObjVertexKey> m_keys;
+	};
+
+	bool load_obj(const std::string& path, Model& model, const ModelImportSettings& settings) {
+		model.clear();
+
+		MappedFile file;
+		if (!file.open(path))
+			return false;
+
+		const char* begin = (const char*)file.data();
+		const char* end = begin + file.size();
+
+		std::vector<ObjChunk> chunks;
+		for (const char* p = begin; p < end;) {
+			ObjChunk chunk;
+			chunk.begin = p;
+			chunk.end = ((uint64_t)(end - p) > settings.chunk_size) ? next_line(p + settings.chunk_size, end) : end;
+			chunks.push_back(chunk);
+			p = chunk.end;
+		}
+
+		std::unique_ptr<ThreadPool> local_pool;
+		ThreadPool* pool = settings.thread_pool;
+		if (!pool) {
+			local_pool.reset(new ThreadPool());
+			pool = local_pool.get();
+		}
+
+		for (ObjChunk& chunk : chunks)
+			pool->submit([&chunk] { count_chunk(chunk); });
+		pool->wait_idle();
+
+		//Knowing every chunk's element counts up front lets chunks parse straight into the shared arrays.
+		uint32_t position_total = 0, uv_total = 0, normal_total = 0;
+		for (ObjChunk& chunk : chunks) {
+			chunk.position_base = position_total;
+			chunk.uv_base = uv_total;
+			chunk.normal_base = normal_total;
+			position_total += chunk.position_count;
+			uv_total += chunk.uv_count;
+			normal_total += chunk.normal_count;
+		}
+
+		ObjData data;
+		data.positions.resize(position_total);
+		data.colors.assign(position_total, glm::vec3(1.0f));
+		data.uvs.resize(uv_total);
+		data.normals.resize(normal_total);
+
+		for (ObjChunk& chunk : chunks)
+			pool->submit([&chunk, &data, position_total, uv_total, normal_total] { parse_chunk(chunk, data, position_total, uv_total, normal_total); });
+		pool->wait_idle();
+
+		size_t corner_count = 0;
+		bool has_colors = false, has_missing_normals = false;
+		for (ObjChunk& chunk : chunks) {
+			if (chunk.error) {
+				FRACTAL_LOG_ERROR("Failed to load model '%s': %s near byte %llu", path.c_str(), chunk.error, (unsigned long long)(chunk.begin - begin));
+				return false;
+			}
+			corner_count += chunk.corners.size();
+			has_colors |= chunk.has_colors;
+			has_missing_normals |= chunk.has_missing_normals;
+		}
+
+		if (corner_count == 0) {
+			FRACTAL_LOG_ERROR("Model '%s' has no faces", path.c_str());
+			return false;
+		}
+
+		std::unordered_map<std::string, uint32_t> materials;
+		auto get_material = [&](const std::string& name) {
+			auto it = materials.find(name);
+			if (it != materials.end())
+				return it->second;
+			materials[name] = (uint32_t)model.materials.size();
+			model.materials.push_back(name);
+			return (uint32_t)model.materials.size() - 1;
+		};
+
+		ModelPrimitive primitive;
+		primitive.name = "default";
+		std::string material_name = "default";
+		primitive.material = OBJ_MISSING;
+
+		auto close_primitive = [&]() {
+			primitive.index_count = (uint32_t)model.indices.size() - primitive.index_offset;
+			if (primitive.index_count > 0) {
+				if (primitive.material == OBJ_MISSING)
+					primitive.material = get_material(material_name);
+				model.primitives.push_back(primitive);
+			}
+			primitive.index_offset = (uint32_t)model.indices.size();
+			primitive.material = OBJ_MISSING;
+		};
+
+		//Welding stays serial, it is a single hash table pass over already parsed corners.
+		VertexWelder welder(corner_count / 4);
+		model.indices.reserve(corner_count);
+		model.vertices.reserve(corner_count / 4);
+
+		for (ObjChunk& chunk : chunks) {
+			size_t group = 0;
+			for (uint32_t corner = 0; corner <= chunk.corners.size(); corner++) {
+				while (corner % 3 == 0 && group < chunk.groups.size() && chunk.groups[group].triangle == corner / 3) {
+					const ObjGroup& next = chunk.groups[group++];
+					close_primitive();
+					if (next.material)
+						material_name = next.name;
+					else
+						primitive.name = next.name;
+				}
+
+				if (corner == chunk.corners.size())
+					break;
+
+				if (primitive.material == OBJ_MISSING)
+					primitive.material = get_material(material_name);
+
+				const ObjCorner& key = chunk.corners[corner];
+				bool inserted = false;
+				uint32_t index = welder.insert({ key, primitive.material }, inserted);
+				if (inserted) {
+					ModelVertex vertex;
+					vertex.position = data.positions[key.position];
+					vertex.color = has_colors ? glm::vec4(data.colors[key.position], 1.0f) : glm::vec4(1.0f);
+					vertex.texture_coordinates = (key.uv != OBJ_MISSING) ? data.uvs[key.uv] : glm::vec2(0.0f);
+					vertex.texture_id = 0.0f;
+					vertex.material_id = (float)primitive.material;
+					vertex.normals = (key.normal != OBJ_MISSING) ? data.normals[key.normal] : glm::vec3(0.0f);
+					model.vertices.push_back(vertex);
+				}
+				model.indices.push_back(index);
+			}
+		}
+		close_primitive();
+
+		if (has_missing_normals && settings.generate_normals)
+			generate_normals(model);
+
+		if (settings.optimize) {
+			MeshOptimizerStatistics statistics = optimize_mesh(model);
+			FRACTAL_LOG("Optimized model '%s': ACMR %.3f -> %.3f, ATVR %.3f -> %.3f", path.c_str(), statistics.before.acmr, statistics.after.acmr, statistics.before.atvr, statistics.after.atvr);
+		}
+
+		FRACTAL_LOG_GOOD("Loaded model '%s' with %d vertices and %d triangles", path.c_str(), (uint32_t)model.vertices.size(), model.get_triangle_count());
+		return true;
+	}
+}
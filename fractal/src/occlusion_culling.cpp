@@ -0,0 +1,208 @@
+/**
+ * @file occlusion_culling.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the hierarchical depth pyramid and the compute pass
+ * that culls indirect draw commands against it.
+ */
+
+#include "occlusion_culling.h"
+#include "gpu_resources.h"
+#include "log.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+
+namespace Fractal {
+	constexpr uint32_t OCCLUSION_PYRAMID_GROUP_SIZE = 8;
+	constexpr uint32_t OCCLUSION_CULL_GROUP_SIZE = 64;
+
+	//Storage buffer bindings used by cull_shader.glsl, zero is the camera.
+	constexpr uint32_t OCCLUSION_COMMAND_BINDING = 1;
+	constexpr uint32_t OCCLUSION_BOUNDS_BINDING = 2;
+	constexpr uint32_t OCCLUSION_VISIBILITY_BINDING = 3;
+	constexpr uint32_t OCCLUSION_COUNTER_BINDING = 4;
+
+	static uint32_t get_group_count(uint32_t size, uint32_t group_size) {
+		return (size + group_size - 1) / group_size;
+	}
+
+	static uint32_t get_level_count(uint32_t width, uint32_t height) {
+		uint32_t levels = 1;
+		while ((std::max(width, height) >> levels) > 0)
+			levels++;
+		return levels;
+	}
+
+	static void clear_buffer(uint32_t id) {
+		glClearNamedBufferData(id, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+	}
+
+	OcclusionCuller::OcclusionCuller(uint32_t max_commands) : m_max_commands(max_commands) {
+		m_pyramid_shader.init("resources/shaders/hiz_shader.glsl");
+		m_cull_shader.init("resources/shaders/cull_shader.glsl");
+
+		m_bounds = new ShaderStorageBuffer(sizeof(OcclusionBounds) * max_commands, OCCLUSION_BOUNDS_BINDING);
+		set_gpu_allocation_name(GpuResourceType::Buffer, m_bounds->get_id(), "Occlusion Bounds");
+		m_visibility = new ShaderStorageBuffer(sizeof(uint32_t) * max_commands, OCCLUSION_VISIBILITY_BINDING);
+		set_gpu_allocation_name(GpuResourceType::Buffer, m_visibility->get_id(), "Occlusion Visibility");
+		clear_buffer(m_visibility->get_id());
+
+		for (auto& counter : m_counters) {
+			counter = new ShaderStorageBuffer(sizeof(OcclusionStatistics), OCCLUSION_COUNTER_BINDING);
+			set_gpu_allocation_name(GpuResourceType::Buffer, counter->get_id(), "Occlusion Counters");
+			clear_buffer(counter->get_id());
+		}
+	}
+
+	OcclusionCuller::~OcclusionCuller() {
+		delete m_bounds;
+		delete m_visibility;
+		for (auto counter : m_counters)
+			delete counter;
+		destroy_gpu_resource(GpuResourceType::Texture, m_pyramid);
+	}
+
+	void OcclusionCuller::begin_frame() {
+		if (m_counter_used) {
+			m_counter_fences[m_counter_index].insert();
+			m_counter_pending[m_counter_index] = true;
+			m_counter_used = false;
+		}
+
+		//The oldest slot is reused, its counts are kept only if the GPU already wrote them.
+		m_counter_index = (m_counter_index + 1) % OCCLUSION_COUNTER_SLOTS;
+		if (m_counter_pending[m_counter_index]) {
+			Fence& fence = m_counter_fences[m_counter_index];
+			if (fence.signaled())
+				glGetNamedBufferSubData(m_counters[m_counter_index]->get_id(), 0, sizeof(OcclusionStatistics), &m_statistics);
+			fence.reset();
+			clear_buffer(m_counters[m_counter_index]->get_id());
+			m_counter_pending[m_counter_index] = false;
+		}
+	}
+
+	void OcclusionCuller::cull(IndirectDrawBuffer* commands, const OcclusionBounds* bounds, uint32_t count, OcclusionPhase phase) {
+		count = std::min(count, m_max_commands);
+		if (count == 0)
+			return;
+
+		if (phase == OcclusionPhase::Early)
+			m_bounds->set_data((void*)bounds, sizeof(OcclusionBounds) * count, 0);
+
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OCCLUSION_COMMAND_BINDING, commands->get_id());
+		m_bounds->bind_to_bind_point();
+		m_visibility->bind_to_bind_point();
+		m_counters[m_counter_index]->bind_to_bind_point();
+		m_counter_used = true;
+
+		if (m_valid)
+			glBindTextureUnit(OCCLUSION_TEXTURE_UNIT, m_pyramid);
+
+		m_cull_shader.bind();
+		m_cull_shader.set1i("u_phase", (int)phase);
+		m_cull_shader.set1i("u_count", (int)count);
+		m_cull_shader.set1i("u_pyramid_valid", m_valid ? 1 : 0);
+		m_cull_shader.set1i("u_pyramid_levels", (int)m_levels);
+		m_cull_shader.set_vec2f("u_pyramid_size", glm::vec2((float)m_width, (float)m_height));
+
+		glDispatchCompute(get_group_count(count, OCCLUSION_CULL_GROUP_SIZE), 1, 1);
+		glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+	}
+
+	bool OcclusionCuller::build() {
+		GLint frame_buffer = 0;
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &frame_buffer);
+
+		GLint type = GL_NONE, depth = 0;
+		if (frame_buffer) {
+			glGetNamedFramebufferAttachmentParameteriv(frame_buffer, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &type);
+			glGetNamedFramebufferAttachmentParameteriv(frame_buffer, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &depth);
+		}
+
+		//The default frame buffer and render buffers cannot be sampled.
+		if (type != GL_TEXTURE || depth == 0) {
+			m_valid = false;
+			return false;
+		}
+
+		GLint viewport[4] = { 0 };
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		if (viewport[2] <= 0 || viewport[3] <= 0) {
+			m_valid = false;
+			return false;
+		}
+
+		//Sized to the whole attachment so dynamic resolution only changes the part that is used.
+		GLint depth_width = 0, depth_height = 0;
+		glGetTextureLevelParameteriv((uint32_t)depth, 0, GL_TEXTURE_WIDTH, &depth_width);
+		glGetTextureLevelParameteriv((uint32_t)depth, 0, GL_TEXTURE_HEIGHT, &depth_height);
+		viewport[0] = std::max(viewport[0], 0);
+		viewport[1] = std::max(viewport[1], 0);
+		if (depth_width <= viewport[0] || depth_height <= viewport[1]) {
+			m_valid = false;
+			return false;
+		}
+		resize((uint32_t)depth_width, (uint32_t)depth_height);
+
+		m_width = (uint32_t)std::min(viewport[2], depth_width - viewport[0]);
+		m_height = (uint32_t)std::min(viewport[3], depth_height - viewport[1]);
+		m_levels = get_level_count(m_width, m_height);
+
+		m_pyramid_shader.bind();
+		m_pyramid_shader.set_vec2f("u_offset", glm::vec2((float)viewport[0], (float)viewport[1]));
+		glBindTextureUnit(OCCLUSION_TEXTURE_UNIT, (uint32_t)depth);
+
+		uint32_t width = m_width, height = m_height;
+		for (uint32_t level = 0; level < m_levels; level++) {
+			m_pyramid_shader.set1i("u_level", (int)level);
+			m_pyramid_shader.set_vec2f("u_source_size", glm::vec2((float)width, (float)height));
+			if (level > 0) {
+				glBindImageTexture(0, m_pyramid, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+				width = std::max(width >> 1, 1u);
+				height = std::max(height >> 1, 1u);
+			}
+			glBindImageTexture(1, m_pyramid, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+			m_pyramid_shader.set_vec2f("u_destination_size", glm::vec2((float)width, (float)height));
+
+			glDispatchCompute(get_group_count(width, OCCLUSION_PYRAMID_GROUP_SIZE), get_group_count(height, OCCLUSION_PYRAMID_GROUP_SIZE), 1);
+			glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+		}
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+		m_valid = true;
+		return true;
+	}
+
+	void OcclusionCuller::resize(uint32_t width, uint32_t height) {
+		if (m_pyramid && width == m_storage_width && height == m_storage_height)
+			return;
+
+		destroy_gpu_resource(GpuResourceType::Texture, m_pyramid);
+		m_storage_width = width;
+		m_storage_height = height;
+		uint32_t levels = get_level_count(width, height);
+
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_pyramid);
+		glTextureStorage2D(m_pyramid, levels, GL_R32F, width, height);
+		glTextureParameteri(m_pyramid, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+		glTextureParameteri(m_pyramid, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTextureParameteri(m_pyramid, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(m_pyramid, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		uint64_t size = 0;
+		for (uint32_t level = 0; level < levels; level++)
+			size += (uint64_t)std::max(width >> level, 1u) * std::max(height >> level, 1u) * sizeof(float);
+		register_gpu_allocation(GpuResourceType::Texture, m_pyramid, GpuMemoryCategory::Texture, size, GL_R32F, "Hi-Z Pyramid");
+	}
+}
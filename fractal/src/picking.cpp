@@ -0,0 +1,262 @@
+/**
+ * @file picking.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the object id pass used to pick objects under the
+ * mouse. Ids are rendered into an integer frame buffer and read back
+ * through pixel pack buffers a frame later.
+ */
+
+#include "picking.h"
+#include "renderer_commands.h"
+#include "gpu_resources.h"
+#include "log.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Fractal {
+	uint32_t PickingResult::get_id() const {
+		if (ids.empty())
+			return PICKING_NO_OBJECT;
+		return ids[(rows / 2) * columns + columns / 2];
+	}
+
+	void PickingResult::get_unique_ids(std::vector<uint32_t>& objects) const {
+		size_t start = objects.size();
+		for (uint32_t id : ids)
+			if (id != PICKING_NO_OBJECT)
+				objects.push_back(id);
+
+		std::sort(objects.begin() + start, objects.end());
+		objects.erase(std::unique(objects.begin() + start, objects.end()), objects.end());
+	}
+
+	PickingGraphicsDevice::PickingGraphicsDevice(uint32_t max_vertex_count, uint32_t max_index_count) : GraphicsDevice(max_vertex_count, max_index_count) {
+		set_gpu_allocation_name(GpuResourceType::Buffer, m_vbo->get_id(), "Picking Vertices");
+		set_gpu_allocation_name(GpuResourceType::Buffer, m_ibo->get_id(), "Picking Indices");
+
+		VertexBufferLayout layout;
+		layout.add_to_buffer(VertexBufferElement(3, false, VertexShaderType::Float));
+		layout.add_to_buffer(VertexBufferElement(1, false, VertexShaderType::Int));
+
+		m_vbo->set_layout(layout);
+		m_vao->add_vertex_buffer(m_vbo, VertexBufferFormat::VNCVNCVNC);
+	}
+
+	void PickingGraphicsDevice::init() {
+	}
+
+	void PickingGraphicsDevice::setup() {
+		m_ds.reset();
+		m_vert_ptr = m_vert_base;
+		m_indx_ptr = m_indx_base;
+	}
+
+	bool PickingGraphicsDevice::submit(Mesh& mesh) {
+		return submit(mesh.vertices.data(), (uint32_t)mesh.vertices.size(), mesh.indices.data(), (uint32_t)mesh.indices.size(), m_object_id);
+	}
+
+	bool PickingGraphicsDevice::submit(const Vertex* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count, uint32_t object_id) {
+		if (m_ds.num_of_vertices + vertex_count > m_ds.max_vertex_count || m_ds.num_of_indices + index_count > m_ds.max_index_count)
+			return false;
+
+		uint32_t base_vertex = m_ds.num_of_vertices;
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			m_vert_ptr->position = vertices[i].position;
+			m_vert_ptr->object_id = object_id;
+			m_vert_ptr++;
+		}
+
+		for (uint32_t i = 0; i < index_count; i++) {
+			*m_indx_ptr = base_vertex + indices[i];
+			m_indx_ptr++;
+		}
+
+		m_ds.num_of_vertices += vertex_count;
+		m_ds.num_of_indices += index_count;
+		return true;
+	}
+
+	void PickingGraphicsDevice::render() {
+		if (empty())
+			return;
+
+		Shader* shader = resolve(m_shader);
+		if (!shader) {
+			FRACTAL_LOG_ERROR("Picking shader was destroyed before the pass was rendered.");
+			return;
+		}
+
+		m_vao->bind();
+		m_ibo->bind();
+		m_vbo->bind();
+		shader->bind();
+
+		uint32_t vertex_buf_size = (uint32_t)((uint8_t*)m_vert_ptr - (uint8_t*)m_vert_base);
+		uint32_t index_buf_size = (uint32_t)((uint8_t*)m_indx_ptr - (uint8_t*)m_indx_base);
+		m_vbo->set_data(m_vert_base, vertex_buf_size);
+		m_ibo->set_data(m_indx_base, index_buf_size);
+
+		m_vao->set_index_buffer_size(m_ibo->get_count());
+		RendererCommands::draw_vertex_array(m_vao);
+		m_ds.draw_count++;
+	}
+
+	PickingPass::PickingPass(const PickingSettings& settings)
+		: m_settings(settings), m_frame_buffer(FrameBufferFormat::R32UI), m_readback(PICKING_READBACK_SLOTS) {
+		m_shader.init("resources/shaders/picking_shader.glsl");
+
+		m_gd = new PickingGraphicsDevice(MAX_PICKING_VERTEX_COUNT, MAX_PICKING_INDEX_COUNT);
+		m_gd->init();
+		m_gd->set_shader(m_shader.get_handle());
+	}
+
+	PickingPass::~PickingPass() {
+		for (auto& request : m_requests)
+			m_readback.release(request.ticket);
+		delete m_gd;
+	}
+
+	void PickingPass::begin(Camera* camera) {
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_target_id);
+		glGetIntegerv(GL_VIEWPORT, m_target_viewport);
+		if (m_target_viewport[2] <= 0 || m_target_viewport[3] <= 0)
+			return;
+
+		m_frame++;
+		float scale = std::min(std::max(m_settings.scale, 0.0f), 1.0f);
+		m_width = std::max((uint32_t)std::ceil(m_target_viewport[2] * scale), 1u);
+		m_height = std::max((uint32_t)std::ceil(m_target_viewport[3] * scale), 1u);
+		m_frame_buffer.resize(m_width, m_height);
+		m_proj_view = camera->get_projection() * camera->get_view();
+
+		const uint32_t no_object = PICKING_NO_OBJECT;
+		glClearNamedFramebufferuiv(m_frame_buffer.get_id(), GL_COLOR, 0, &no_object);
+		glClearNamedFramebufferfi(m_frame_buffer.get_id(), GL_DEPTH_STENCIL, 0, 1.0f, 0);
+
+		m_frame_buffer.bind();
+		RendererCommands::set_viewport(0, 0, m_width, m_height);
+		m_gd->setup();
+		m_in_pass = true;
+	}
+
+	void PickingPass::submit(Mesh& mesh, uint32_t object_id) {
+		submit(mesh.vertices.data(), (uint32_t)mesh.vertices.size(), mesh.indices.data(), (uint32_t)mesh.indices.size(), object_id);
+	}
+
+	void PickingPass::submit(const Vertex* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count, uint32_t object_id) {
+		if (!m_in_pass)
+			return;
+
+		if (!m_gd->submit(vertices, vertex_count, indices, index_count, object_id)) {
+			flush();
+			m_gd->setup();
+			if (!m_gd->submit(vertices, vertex_count, indices, index_count, object_id))
+				FRACTAL_LOG_ERROR("Singular mesh is too big for the picking pass. Split it up!");
+		}
+	}
+
+	void PickingPass::end() {
+		if (!m_in_pass)
+			return;
+
+		flush();
+		m_in_pass = false;
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_target_id);
+		RendererCommands::set_viewport(m_target_viewport[0], m_target_viewport[1], m_target_viewport[2], m_target_viewport[3]);
+	}
+
+	void PickingPass::flush() {
+		m_shader.bind();
+		m_shader.set_mat4f("u_proj_view", m_proj_view);
+		m_gd->render();
+	}
+
+	bool PickingPass::pick(const glm::vec2& position) {
+		if (position.x < 0.0f || position.y < 0.0f)
+			return false;
+		return pick((uint32_t)position.x, (uint32_t)position.y, 1, 1);
+	}
+
+	bool PickingPass::pick(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+		uint32_t target_width = (uint32_t)std::max(m_target_viewport[2], 0);
+		uint32_t target_height = (uint32_t)std::max(m_target_viewport[3], 0);
+		if (m_in_pass || target_width == 0 || target_height == 0 || width == 0 || height == 0 || x >= target_width || y >= target_height)
+			return false;
+
+		width = std::min(width, target_width - x);
+		height = std::min(height, target_height - y);
+
+		//Mouse rows start at the top, frame buffer rows at the bottom.
+		float scale_x = (float)m_width / target_width;
+		float scale_y = (float)m_height / target_height;
+		uint32_t left = (uint32_t)std::floor(x * scale_x);
+		uint32_t right = std::max((uint32_t)std::ceil((x + width) * scale_x), left + 1);
+		uint32_t bottom = (uint32_t)std::floor((target_height - (y + height)) * scale_y);
+		uint32_t top = std::max((uint32_t)std::ceil((target_height - y) * scale_y), bottom + 1);
+		right = std::min(right, m_width);
+		top = std::min(top, m_height);
+		if (left >= right || bottom >= top)
+			return false;
+
+		m_statistics.requested++;
+		PickingRequest request;
+		request.ticket = m_readback.request(&m_frame_buffer, left, bottom, right - left, top - bottom, ReadbackFormat::R32UI);
+		if (!request.ticket.valid()) {
+			m_statistics.rejected++;
+			return false;
+		}
+
+		request.result.x = x;
+		request.result.y = y;
+		request.result.width = width;
+		request.result.height = height;
+		request.result.columns = right - left;
+		request.result.rows = top - bottom;
+		request.frame = m_frame;
+		m_requests.push_back(request);
+		return true;
+	}
+
+	bool PickingPass::poll(PickingResult& result) {
+		while (!m_requests.empty()) {
+			PickingRequest& request = m_requests.front();
+			ReadbackStatus status = m_readback.poll(request.ticket);
+			if (status == ReadbackStatus::Pending)
+				return false;
+
+			ReadbackResult readback;
+			bool mapped = (status == ReadbackStatus::Ready) && m_readback.map(request.ticket, readback);
+			if (mapped) {
+				result = request.result;
+				result.ids.resize((size_t)readback.width * readback.height);
+				for (uint32_t row = 0; row < readback.height; row++)
+					memcpy(&result.ids[(size_t)row * readback.width], (const uint8_t*)readback.data + (size_t)row * readback.stride, readback.width * sizeof(uint32_t));
+
+				m_statistics.completed++;
+				m_statistics.latency_frames = (uint32_t)(m_frame - request.frame);
+			}
+
+			m_readback.release(request.ticket);
+			m_requests.erase(m_requests.begin());
+			if (mapped)
+				return true;
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,178 @@
+/**
+ * @file readback.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the asynchronous framebuffer readback. Pixels are read
+ * into a ring of pixel pack buffers and only mapped once their fence passed.
+ */
+
+#include "readback.h"
+#include "log.h"
+#include <glad/glad.h>
+
+namespace Fractal {
+	uint32_t get_readback_pixel_size(ReadbackFormat format) {
+		switch (format) {
+		case ReadbackFormat::RGBA8: return 4;
+		case ReadbackFormat::R32UI: return 4;
+		case ReadbackFormat::Depth32F: return 4;
+		}
+		return 4;
+	}
+
+	static void readback_format_to_gl(ReadbackFormat format, GLenum& gl_format, GLenum& gl_type) {
+		switch (format) {
+		case ReadbackFormat::RGBA8: gl_format = GL_RGBA; gl_type = GL_UNSIGNED_BYTE; break;
+		case ReadbackFormat::R32UI: gl_format = GL_RED_INTEGER; gl_type = GL_UNSIGNED_INT; break;
+		case ReadbackFormat::Depth32F: gl_format = GL_DEPTH_COMPONENT; gl_type = GL_FLOAT; break;
+		}
+	}
+
+	AsyncReadback::AsyncReadback(uint32_t slot_count) {
+		m_slots.resize(slot_count);
+		for (auto& slot : m_slots)
+			slot.buffer = new PixelPackBuffer(0);
+	}
+
+	AsyncReadback::~AsyncReadback() {
+		for (auto& slot : m_slots) {
+			if (slot.state == SlotState::Mapped)
+				slot.buffer->unmap();
+			delete slot.buffer;
+		}
+	}
+
+	ReadbackTicket AsyncReadback::request(FrameBuffer* frame_buffer, uint32_t x, uint32_t y, uint32_t width, uint32_t height, ReadbackFormat format, uint32_t attachment) {
+		ReadbackTicket ticket;
+		m_statistics.requested++;
+
+		uint32_t index = INVALID_READBACK_SLOT;
+		for (uint32_t i = 0; i < m_slots.size(); i++) {
+			if (m_slots[i].state == SlotState::Free) {
+				index = i;
+				break;
+			}
+		}
+
+		//Every slot is still waiting on the GPU, so reject instead of stalling.
+		if (index == INVALID_READBACK_SLOT) {
+			m_statistics.rejected++;
+			return ticket;
+		}
+
+		Slot& slot = m_slots[index];
+		uint32_t size = width * height * get_readback_pixel_size(format);
+		if (slot.buffer->get_size() < size)
+			slot.buffer->allocate_data(size);
+
+		GLenum gl_format = GL_RGBA, gl_type = GL_UNSIGNED_BYTE;
+		readback_format_to_gl(format, gl_format, gl_type);
+
+		GLint previous_read = 0;
+		glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous_read);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, frame_buffer ? frame_buffer->get_id() : 0);
+		if (format != ReadbackFormat::Depth32F)
+			glReadBuffer(frame_buffer ? GL_COLOR_ATTACHMENT0 + attachment : GL_BACK);
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+		slot.buffer->bind();
+		glReadPixels(x, y, width, height, gl_format, gl_type, nullptr);
+		slot.buffer->unbind();
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)previous_read);
+
+		slot.fence.insert();
+		slot.state = SlotState::Pending;
+		slot.generation++;
+		slot.width = width;
+		slot.height = height;
+		slot.format = format;
+
+		ticket.slot = index;
+		ticket.generation = slot.generation;
+		return ticket;
+	}
+
+	AsyncReadback::Slot* AsyncReadback::find_slot(const ReadbackTicket& ticket) {
+		if (!ticket.valid() || ticket.slot >= m_slots.size())
+			return nullptr;
+
+		Slot& slot = m_slots[ticket.slot];
+		if (slot.generation != ticket.generation || slot.state == SlotState::Free)
+			return nullptr;
+		return &slot;
+	}
+
+	ReadbackStatus AsyncReadback::poll(const ReadbackTicket& ticket) {
+		Slot* slot = find_slot(ticket);
+		if (!slot)
+			return ReadbackStatus::Invalid;
+
+		if (slot->state == SlotState::Pending) {
+			if (!slot->fence.signaled())
+				return ReadbackStatus::Pending;
+
+			slot->fence.reset();
+			slot->state = SlotState::Ready;
+			m_statistics.completed++;
+		}
+
+		return ReadbackStatus::Ready;
+	}
+
+	ReadbackStatus AsyncReadback::wait(const ReadbackTicket& ticket, uint64_t timeout_ns) {
+		Slot* slot = find_slot(ticket);
+		if (!slot)
+			return ReadbackStatus::Invalid;
+
+		if (slot->state == SlotState::Pending && !slot->fence.wait(timeout_ns))
+			return ReadbackStatus::Pending;
+		return poll(ticket);
+	}
+
+	bool AsyncReadback::map(const ReadbackTicket& ticket, ReadbackResult& result) {
+		if (poll(ticket) != ReadbackStatus::Ready)
+			return false;
+
+		Slot& slot = m_slots[ticket.slot];
+		uint32_t stride = slot.width * get_readback_pixel_size(slot.format);
+
+		if (slot.state != SlotState::Mapped) {
+			slot.mapped = slot.buffer->map(stride * slot.height);
+			if (!slot.mapped) {
+				FRACTAL_LOG_ERROR("Failed to map readback buffer #%d", slot.buffer->get_id());
+				return false;
+			}
+			slot.state = SlotState::Mapped;
+		}
+
+		result.data = slot.mapped;
+		result.width = slot.width;
+		result.height = slot.height;
+		result.stride = stride;
+		result.format = slot.format;
+		return true;
+	}
+
+	void AsyncReadback::release(ReadbackTicket& ticket) {
+		Slot* slot = find_slot(ticket);
+		if (slot) {
+			if (slot->state == SlotState::Mapped)
+				slot->buffer->unmap();
+			slot->mapped = nullptr;
+			slot->fence.reset();
+			slot->state = SlotState::Free;
+		}
+
+		ticket = ReadbackTicket();
+	}
+}
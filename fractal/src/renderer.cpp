@@ -17,7 +17,10 @@
 
 #include "renderer.h"
 #include "log.h"
+#include "allocation_tracker.h"
+#include "gpu_memory.h"
 #include "renderer_commands.h"
+#include "picking.h"
 #include <gtc/matrix_transform.hpp>
 #include <glad/glad.h>
 #include <cstring>
@@ -29,9 +32,15 @@ namespace Fractal {
 		draw_count = 0;
 	}
 
+	void DeviceStatistics::reset_lod() {
+		memset(lod_objects, 0, sizeof(lod_objects));
+		memset(lod_triangles, 0, sizeof(lod_triangles));
+	}
+
 	template <typename V>
 	GraphicsDevice<V>::GraphicsDevice(uint32_t max_vertex_count, uint32_t max_index_count) {
 		m_vbo = new VertexBuffer(sizeof(V) * max_vertex_count);
+		set_gpu_allocation_name(GpuResourceType::Buffer, m_vbo->get_id(), "Batch Vertices");
 		m_vao = new VertexArray();
 		m_ds.max_vertex_count = max_vertex_count;
 
@@ -39,6 +48,7 @@ namespace Fractal {
 		m_indx_base = new uint32_t[max_vertex_count];
 
 		m_ibo = new IndexBuffer(sizeof(uint32_t) * max_index_count);
+		set_gpu_allocation_name(GpuResourceType::Buffer, m_ibo->get_id(), "Batch Indices");
 		m_ds.max_index_count = max_index_count;
 
 		m_vao->set_index_buffer_size(m_ibo->get_count());
@@ -53,9 +63,11 @@ namespace Fractal {
 		delete[] m_vert_base;
 		delete[] m_indx_base;
 
-		m_shader = nullptr;
 	}
 
+	//Devices with their own vertex type are instantiated here next to the template.
+	template class GraphicsDevice<PickingVertex>;
+
 	BatchGraphicsDevice::BatchGraphicsDevice(uint32_t max_vertex_count, uint32_t max_index_count) : GraphicsDevice(max_vertex_count, max_index_count) {
 		VertexBufferLayout layout;
 		layout.add_to_buffer(VertexBufferElement(3, false, VertexShaderType::Float));
@@ -69,6 +81,7 @@ namespace Fractal {
 
 	void BatchGraphicsDevice::init() {
 		m_idb = new IndirectDrawBuffer(sizeof(m_commands));
+		set_gpu_allocation_name(GpuResourceType::Buffer, m_idb->get_id(), "Batch Draw Commands");
 	}
 
 	BatchGraphicsDevice::~BatchGraphicsDevice() {
@@ -88,7 +101,7 @@ namespace Fractal {
 		m_indx_ptr = m_indx_base;
 	}
 
-	void BatchGraphicsDevice::add_vertex(Vertex* v) {
+	void BatchGraphicsDevice::add_vertex(const Vertex* v) {
 		*m_vert_ptr = *v;
 		m_vert_ptr++;
 		m_ds.num_of_vertices++;
@@ -101,23 +114,48 @@ namespace Fractal {
 	}
 
 	bool BatchGraphicsDevice::submit(Mesh& mesh) {
-		if (m_ds.num_of_vertices + mesh.vertices.size() > m_ds.max_vertex_count || m_ds.num_of_indices + mesh.indices.size() > m_ds.max_index_count)
+		return submit(mesh, 0);
+	}
+
+	bool BatchGraphicsDevice::submit(const Mesh& mesh, uint32_t base_vertex) {
+		return submit(mesh.vertices.data(), (uint32_t)mesh.vertices.size(), mesh.indices.data(), (uint32_t)mesh.indices.size(), base_vertex);
+	}
+
+	bool BatchGraphicsDevice::submit(const Vertex* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count, uint32_t base_vertex) {
+		FRACTAL_NO_ALLOCATION_SCOPE();
+		if (m_ds.num_of_vertices + vertex_count > m_ds.max_vertex_count || m_ds.num_of_indices + index_count > m_ds.max_index_count)
+			return false;
+		//One slot stays free for the command end_scene closes the batch with.
+		if (m_occlusion_culling && m_ds.draw_count + 2 > MAX_DRAW_COMMANDS)
 			return false;
 
-		for (auto& vertex : mesh.vertices) {
-			if (m_ds.num_of_vertices >= m_ds.max_vertex_count)
-				break;
-			add_vertex(&vertex);
+		uint32_t first_index = m_ds.num_of_indices;
+		BoundingBox bounds;
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			add_vertex(&vertices[i]);
+			bounds.expand(vertices[i].position);
 			m_index_offset++;
 		}
 
-		for (auto& index : mesh.indices) {
-			if (m_ds.num_of_indices >= m_ds.max_index_count)
-				break;
-			add_index(index);
+		for (uint32_t i = 0; i < index_count; i++) {
+			add_index(base_vertex + indices[i]);
 			m_current_draw_command_vertex_size++;
 		}
 
+		if (m_occlusion_culling) {
+			DrawElementsCommand& command = m_commands[m_ds.draw_count];
+			command.vertex_count = index_count;
+			command.instance_count = 1;
+			command.first_index = first_index;
+			command.base_vertex = 0;
+			command.base_instance = m_ds.draw_count;
+
+			m_command_bounds[m_ds.draw_count].min = glm::vec4(bounds.min, 1.0f);
+			m_command_bounds[m_ds.draw_count].max = glm::vec4(bounds.max, 1.0f);
+			m_ds.draw_count++;
+			m_current_draw_command_vertex_size = 0;
+		}
+
 		return true;
 	}
 
@@ -125,7 +163,12 @@ namespace Fractal {
 		m_vao->bind();
 		m_ibo->bind();
 		m_vbo->bind();
-		(*m_shader)->bind();
+		Shader* shader = resolve(m_shader);
+		if (!shader) {
+			FRACTAL_LOG_ERROR("Batch shader was destroyed before the batch was rendered.");
+			return;
+		}
+		shader->bind();
 
 		m_idb->bind();
 		m_idb->set_data(m_commands, sizeof(m_commands), 0);
@@ -141,7 +184,51 @@ namespace Fractal {
 
 		m_vao->set_index_buffer_size(m_ibo->get_count());
 
-		RendererCommands::draw_multi_indirect(nullptr, m_ds.draw_count + 1, 0);
+		Shader* depth_shader = m_depth_prepass ? resolve(m_depth_shader) : nullptr;
+		if (!m_occlusion_culling || !m_culler) {
+			draw(shader, depth_shader);
+			return;
+		}
+
+		//Draw what was visible against the last pyramid, rebuild it from that depth and draw what the first test missed.
+		m_culler->cull(m_idb, m_command_bounds, m_ds.draw_count, OcclusionPhase::Early);
+		draw(shader, depth_shader);
+		m_culler->build();
+		m_culler->cull(m_idb, m_command_bounds, m_ds.draw_count, OcclusionPhase::Late);
+		draw(shader, depth_shader);
+	}
+
+	void BatchGraphicsDevice::draw(Shader* shader, Shader* depth_shader) {
+		//The pre-pass changes depth and color state, so the caller's is put back afterwards.
+		GLint previous_func = GL_LESS;
+		GLboolean previous_mask = GL_TRUE;
+		GLboolean previous_color[4] = { GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE };
+		if (depth_shader) {
+			glGetIntegerv(GL_DEPTH_FUNC, &previous_func);
+			glGetBooleanv(GL_DEPTH_WRITEMASK, &previous_mask);
+			glGetBooleanv(GL_COLOR_WRITEMASK, previous_color);
+
+			//Same vertices and commands as the main pass, only depth is written.
+			depth_shader->bind();
+			RendererCommands::color_mask(false);
+			RendererCommands::depth_mask(true);
+			RendererCommands::depth_func(GL_LESS);
+			RendererCommands::draw_multi_indirect(nullptr, m_ds.draw_count, 0);
+
+			shader->bind();
+			glColorMask(previous_color[0], previous_color[1], previous_color[2], previous_color[3]);
+			RendererCommands::depth_mask(false);
+			RendererCommands::depth_func(GL_LEQUAL);
+		}
+		else
+			shader->bind();
+
+		RendererCommands::draw_multi_indirect(nullptr, m_ds.draw_count, 0);
+
+		if (depth_shader) {
+			RendererCommands::depth_mask(previous_mask == GL_TRUE);
+			RendererCommands::depth_func((GLenum)previous_func);
+		}
 	}
 
 	void BatchGraphicsDevice::next_command() {
@@ -153,9 +240,10 @@ namespace Fractal {
 	void BatchGraphicsDevice::make_command() {
 		m_commands[m_ds.draw_count].vertex_count = m_current_draw_command_vertex_size;
 		m_commands[m_ds.draw_count].instance_count = 1;
-		m_commands[m_ds.draw_count].first_index = 0;
+		m_commands[m_ds.draw_count].first_index = m_ds.num_of_indices - m_current_draw_command_vertex_size;
 		m_commands[m_ds.draw_count].base_vertex = m_cmd_vertex_base;
 		m_commands[m_ds.draw_count].base_instance = m_ds.draw_count;
+		m_command_bounds[m_ds.draw_count] = OcclusionBounds();
 	}
 
 	float BatchGraphicsDevice::calculate_texture_index(uint32_t id) {
@@ -183,14 +271,18 @@ namespace Fractal {
 		m_camera = nullptr;
 	}
 
-	Renderer::Renderer() {
+	Renderer::Renderer() : m_culler(MAX_DRAW_COMMANDS) {
 		m_default_shader.init("resources/shaders/default_shader.glsl");
 		init_renderer_shader(&m_default_shader);
-		m_current_shader = &m_default_shader;
+		m_current_shader = m_default_shader.get_handle();
+		m_depth_shader.init("resources/shaders/depth_shader.glsl");
 
 		m_gd = new BatchGraphicsDevice(MAX_VERTEX_COUNT, MAX_INDEX_COUNT);
 		m_gd->init();
+		m_gd->set_depth_shader(m_depth_shader.get_handle());
+		m_gd->set_occlusion_culler(&m_culler);
 		m_ssbo = new ShaderStorageBuffer(sizeof(glm::mat4), 0);
+		set_gpu_allocation_name(GpuResourceType::Buffer, m_ssbo->get_id(), "Camera");
 	}
 
 	void Renderer::init_renderer_shader(Shader* shader) {
@@ -203,14 +295,18 @@ namespace Fractal {
 	}
 
 	void Renderer::begin_scene(Camera* camera) {
+		FRACTAL_ALLOCATION_SCOPE(Renderer);
 		m_camera = camera;
 		m_proj_view = camera->get_projection() * camera->get_view();
-		m_current_shader = &m_default_shader;
+		m_current_shader = m_default_shader.get_handle();
 		m_gd->setup();
+		m_gd->reset_lod_statistics();
+		m_culler.begin_frame();
 	}
 
 	void Renderer::end_scene() {
-		m_gd->set_shader(&m_current_shader);
+		FRACTAL_ALLOCATION_SCOPE(Renderer);
+		m_gd->set_shader(get_current_shader()->get_handle());
 
 		m_gd->make_command();
 		m_gd->next_command();
@@ -220,7 +316,12 @@ namespace Fractal {
 		m_gd->render();
 	}
 
+	void Renderer::cull(const Bvh& bvh, std::vector<uint32_t>& visible) const {
+		bvh.query_frustum(Frustum(m_proj_view), visible);
+	}
+
 	void Renderer::submit(Mesh& mesh) {
+		FRACTAL_ALLOCATION_SCOPE(Renderer);
 		if (!m_gd->submit(mesh)) {
 			end_scene();
 			m_gd->setup();
@@ -228,4 +329,25 @@ namespace Fractal {
 				FRACTAL_LOG_ERROR("Singular mesh is too big. Split it up!");
 		}
 	}
-}
\ No newline at end of file
+
+	void Renderer::submit(const Vertex* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count) {
+		FRACTAL_ALLOCATION_SCOPE(Renderer);
+		if (!m_gd->submit(vertices, vertex_count, indices, index_count, m_gd->index_offset())) {
+			end_scene();
+			m_gd->setup();
+			if (!m_gd->submit(vertices, vertex_count, indices, index_count, 0))
+				FRACTAL_LOG_ERROR("Singular mesh is too big. Split it up!");
+		}
+	}
+
+	void Renderer::submit(LodMesh& mesh) {
+		if (mesh.get_level_count() == 0)
+			return;
+
+		uint32_t level = (m_camera) ? mesh.select_level(get_screen_size(mesh.get_bounds(), *m_camera)) : 0;
+		const Mesh& lod = mesh.get_level(level);
+		m_gd->record_lod(level, mesh.get_triangle_count(level));
+
+		submit(lod.vertices.data(), (uint32_t)lod.vertices.size(), lod.indices.data(), (uint32_t)lod.indices.size());
+	}
+}
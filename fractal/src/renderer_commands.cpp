@@ -72,4 +72,17 @@ namespace Fractal {
 	void RendererCommands::line_width(float width) {
 		glLineWidth(width);
 	}
+
+	void RendererCommands::depth_func(uint32_t func) {
+		glDepthFunc(func);
+	}
+
+	void RendererCommands::depth_mask(bool write) {
+		glDepthMask(write ? GL_TRUE : GL_FALSE);
+	}
+
+	void RendererCommands::color_mask(bool write) {
+		GLboolean mask = write ? GL_TRUE : GL_FALSE;
+		glColorMask(mask, mask, mask, mask);
+	}
 } 
\ No newline at end of file
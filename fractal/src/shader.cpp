@@ -16,7 +16,9 @@
  */
 
 #include "shader.h"
+#include "asset_pack.h"
 #include "log.h"
+#include "gpu_resources.h"
 
 #include <glad/glad.h>
 #include <gtc/type_ptr.hpp>
@@ -28,11 +30,17 @@ namespace Fractal {
 	static uint32_t current_shader_binded = 0;
 
 	Shader::Shader(const std::string& file_path) {
+		m_handle = register_gpu_resource(this);
 		init(file_path);
 	}
 
+	Shader::Shader() {
+		m_handle = register_gpu_resource(this);
+	}
+
 	Shader::~Shader() {
-		glDeleteProgram(m_shader_id);
+		unregister_gpu_resource(m_handle);
+		destroy_gpu_resource(GpuResourceType::Program, m_shader_id);
 	}
 
 	void Shader::bind() {
@@ -48,8 +56,29 @@ namespace Fractal {
 	}
 
 	void Shader::init(const std::string& file_path) {
-		m_shader_id = create_shader(parse_shader(file_path));
+		std::string source;
+		if (load_packed_text(file_path, source)) {
+			init_from_source(file_path, source);
+			return;
+		}
+#ifdef FRACTAL_COOKED_ASSETS
+		FRACTAL_LOG_ERROR("Shader '%s' is not in a mounted asset pack.", file_path.c_str());
+#else
+		std::ifstream stream(file_path);
+		if (!stream.is_open()) {
+			FRACTAL_LOG_ERROR("Failed to load asset shader '%s'.", file_path.c_str());
+			return;
+		}
+
+		m_shader_id = create_shader(parse_shader(stream));
 		FRACTAL_LOG_GOOD("Asset shader '%s' loaded as shader #%d", file_path.c_str(), m_shader_id);
+#endif
+	}
+
+	void Shader::init_from_source(const std::string& name, const std::string& source) {
+		std::istringstream stream(source);
+		m_shader_id = create_shader(parse_shader(stream));
+		FRACTAL_LOG_GOOD("Asset shader '%s' loaded as shader #%d", name.c_str(), m_shader_id);
 	}
 
 	uint32_t Shader::compile_shader(const std::string& source, uint32_t type) {
@@ -75,21 +104,14 @@ namespace Fractal {
 		return id;
 	}
 
-	ShaderSources Shader::parse_shader(const std::string& file_path) {
-		std::ifstream stream(file_path);
-
+	ShaderSources Shader::parse_shader(std::istream& stream) {
 		enum class ShaderType {
-			NONE = -1, VERTEX = GL_VERTEX_SHADER, FRAGMENT = GL_FRAGMENT_SHADER, GEOMETRY = GL_GEOMETRY_SHADER, TESS_EVAL = GL_TESS_EVALUATION_SHADER, TESS_CONTROL = GL_TESS_CONTROL_SHADER
+			NONE = -1, VERTEX = GL_VERTEX_SHADER, FRAGMENT = GL_FRAGMENT_SHADER, GEOMETRY = GL_GEOMETRY_SHADER, TESS_EVAL = GL_TESS_EVALUATION_SHADER, TESS_CONTROL = GL_TESS_CONTROL_SHADER, COMPUTE = GL_COMPUTE_SHADER
 		};
 
 		ShaderType type = ShaderType::NONE;
 		std::string line;
 
-		if (!stream.is_open()) {
-			FRACTAL_LOG_ERROR("Failed to load asset shader '%s'.", file_path.c_str());
-			return ShaderSources();
-		}
-
 		ShaderSources ss;
 		while (getline(stream, line)) {
 			if (line.find("#shader") != std::string::npos) {
@@ -103,13 +125,14 @@ namespace Fractal {
 					type = ShaderType::TESS_CONTROL;
 				else if (line.find("tess-eval") != std::string::npos)
 					type = ShaderType::TESS_EVAL;
+				else if (line.find("compute") != std::string::npos)
+					type = ShaderType::COMPUTE;
 			}
 			else {
 				ss[(uint32_t)type] << line << '\n';
 			}
 		}
 
-		stream.close();
 		return ss;
 	}
 
@@ -136,6 +159,10 @@ namespace Fractal {
 		glProgramUniform1f(id, ProgramGetUniformLocation(id, name), value);
 	}
 
+	void ProgramSet1i(uint32_t id, const std::string& name, int value) {
+		glProgramUniform1i(id, ProgramGetUniformLocation(id, name), value);
+	}
+
 	void ProgramSetMat4f(uint32_t id, const std::string& name, const glm::mat4& mat4) {
 		glProgramUniformMatrix4fv(id, ProgramGetUniformLocation(id, name), 1, GL_FALSE, glm::value_ptr(mat4));
 	}
@@ -152,6 +179,10 @@ namespace Fractal {
 		ProgramSet1f(m_shader_id, name, value);
 	}
 
+	void Shader::set1i(const std::string& name, int value) {
+		ProgramSet1i(m_shader_id, name, value);
+	}
+
 	uint32_t Shader::get_uniform_location(const std::string& name) {
 		return (glGetUniformLocation(m_shader_id, name.c_str()));
 	}
@@ -16,73 +16,231 @@
  */
 
 #include "texture.h"
+#include "asset_pack.h"
 #include "log.h"
+#include "gpu_resources.h"
 
 #include <iostream>
+#include <algorithm>
+#include <cctype>
 #include <glad/glad.h>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 namespace Fractal {
-	void Texture::initialize(const char* file_path) {
-		m_path = file_path;
+	static uint32_t get_gl_wrap(TextureWrap wrap) {
+		switch (wrap) {
+		case TextureWrap::Repeat: return GL_REPEAT;
+		case TextureWrap::MirroredRepeat: return GL_MIRRORED_REPEAT;
+		case TextureWrap::ClampToEdge: return GL_CLAMP_TO_EDGE;
+		case TextureWrap::ClampToBorder: return GL_CLAMP_TO_BORDER;
+		}
+		return GL_REPEAT;
+	}
 
-		int w, h, channels;
-		stbi_set_flip_vertically_on_load(1);
-		stbi_uc* m_data = stbi_load(file_path, &w, &h, &channels, 0);
+	static uint32_t get_gl_min_filter(const TextureSpecification& specification, uint32_t mip_levels) {
+		bool nearest = (specification.min_filter == TextureFilter::Nearest);
+		if (mip_levels <= 1)
+			return nearest ? GL_NEAREST : GL_LINEAR;
 
-		m_width = w;
-		m_height = h;
+		if (specification.mip_filter == TextureFilter::Nearest)
+			return nearest ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_NEAREST;
+		return nearest ? GL_NEAREST_MIPMAP_LINEAR : GL_LINEAR_MIPMAP_LINEAR;
+	}
+
+	bool get_texture_format(int channels, uint32_t& internal_format, uint32_t& data_format) {
 		if (channels == 4) {
-			m_internal_format = GL_RGBA8;
-			m_data_format = GL_RGBA;
+			internal_format = GL_RGBA8;
+			data_format = GL_RGBA;
 		}
 		else if (channels == 3) {
-			m_internal_format = GL_RGB8;
-			m_data_format = GL_RGB;
+			internal_format = GL_RGB8;
+			data_format = GL_RGB;
 		}
+		else
+			return false;
+		return true;
+	}
+
+	uint32_t get_storage_level_count(const TextureImage& image, const TextureSpecification& specification) {
+		//Uncompressed images that only carry a base level get the rest of the chain generated on the GPU.
+		uint32_t levels = (uint32_t)image.levels.size();
+		if (!image.compressed && levels == 1 && specification.generate_mips)
+			levels = get_mip_level_count(image.width, image.height);
 
-		if (m_data) {
-			glCreateTextures(GL_TEXTURE_2D, 1, &m_texture_id);
-			glTextureStorage2D(m_texture_id, 1, m_internal_format, m_width, m_height);
+		if (specification.max_mip_levels)
+			levels = std::min(levels, specification.max_mip_levels);
+		return levels;
+	}
+
+	void apply_texture_specification(uint32_t texture_id, const TextureSpecification& specification, uint32_t mip_levels) {
+		static float max_anisotropy = 0.0f;
+		if (max_anisotropy == 0.0f)
+			glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &max_anisotropy);
+
+		glTextureParameteri(texture_id, GL_TEXTURE_MIN_FILTER, get_gl_min_filter(specification, mip_levels));
+		glTextureParameteri(texture_id, GL_TEXTURE_MAG_FILTER, (specification.mag_filter == TextureFilter::Nearest) ? GL_NEAREST : GL_LINEAR);
 
-			glTextureParameteri(m_texture_id, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTextureParameteri(m_texture_id, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTextureParameteri(texture_id, GL_TEXTURE_WRAP_S, get_gl_wrap(specification.wrap_s));
+		glTextureParameteri(texture_id, GL_TEXTURE_WRAP_T, get_gl_wrap(specification.wrap_t));
+
+		glTextureParameteri(texture_id, GL_TEXTURE_MAX_LEVEL, (int)mip_levels - 1);
+		glTextureParameterf(texture_id, GL_TEXTURE_MAX_ANISOTROPY, std::min(std::max(specification.anisotropy, 1.0f), std::max(max_anisotropy, 1.0f)));
+	}
 
-			glTextureParameteri(m_texture_id, GL_TEXTURE_WRAP_S, GL_REPEAT);
-			glTextureParameteri(m_texture_id, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	bool load_texture_image(const std::string& path, const TextureSpecification& specification, TextureImage& image) {
+		if (load_packed_texture(path, image))
+			return true;
+#ifdef FRACTAL_COOKED_ASSETS
+		(void)specification;
+		return false;
+#else
+		std::string extension = path.substr(path.find_last_of('.') + 1);
+		std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+		if (extension == "dds")
+			return load_dds(path, image);
+		else if (extension == "ktx")
+			return load_ktx(path, image);
+
+		//Only the header is read here, so the image is decoded once with the channels it needs.
+		int w, h, channels;
+		if (!stbi_info(path.c_str(), &w, &h, &channels))
+			return false;
+
+		//Only RGB and RGBA have a GL format, expand anything else to RGBA.
+		bool expand = specification.compress || (channels != 3 && channels != 4);
+		stbi_set_flip_vertically_on_load_thread(1);
+		stbi_uc* pixels = stbi_load(path.c_str(), &w, &h, &channels, expand ? 4 : 0);
+		if (!pixels)
+			return false;
+		if (expand && !specification.compress)
+			channels = 4;
+
+		bool loaded = true;
+		if (specification.compress)
+			loaded = compress_image(pixels, w, h, channels == 2 || channels == 4, specification.generate_mips, image);
+		else {
+			image = TextureImage();
+			image.width = w;
+			image.height = h;
+			get_texture_format(channels, image.internal_format, image.data_format);
+			image.data_type = GL_UNSIGNED_BYTE;
+			image.row_alignment = 1;
+
+			TextureLevel level;
+			level.width = w;
+			level.height = h;
+			level.size = w * h * channels;
+			image.levels.push_back(level);
+			image.data.assign(pixels, pixels + level.size);
+		}
+
+		stbi_image_free(pixels);
+		return loaded;
+#endif
+	}
 
-			glTextureSubImage2D(m_texture_id, 0, 0, 0, m_width, m_height, m_data_format, GL_UNSIGNED_BYTE, m_data);
+	Texture::Texture() {
+		m_handle = register_gpu_resource(this);
+	}
+
+	void Texture::initialize(const char* file_path, const TextureSpecification& specification) {
+		TextureImage image;
+		if (load_texture_image(file_path, specification, image)) {
+			initialize(image, specification);
+			set_gpu_allocation_name(GpuResourceType::Texture, m_texture_id, file_path);
 			FRACTAL_LOG_GOOD("Loaded texture '%s'", file_path);
 		}
 		else
 			FRACTAL_LOG_ERROR("Failed to load texture '%s'", file_path);
 
-		stbi_image_free(m_data);
+		m_path = file_path;
 	}
 
-	void Texture::initialize(uint32_t m_width, uint32_t m_height) {
+	void Texture::initialize(uint32_t width, uint32_t height, const TextureSpecification& specification) {
+		m_width = width;
+		m_height = height;
 		m_internal_format = GL_RGBA8;
 		m_data_format = GL_RGBA;
+		m_specification = specification;
+		m_mip_levels = specification.generate_mips ? get_mip_level_count(m_width, m_height) : 1;
+		if (specification.max_mip_levels)
+			m_mip_levels = std::min(m_mip_levels, specification.max_mip_levels);
 
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_texture_id);
-		glTextureStorage2D(m_texture_id, 1, m_internal_format, m_width, m_height);
+		glTextureStorage2D(m_texture_id, m_mip_levels, m_internal_format, m_width, m_height);
+		apply_texture_specification(m_texture_id, m_specification, m_mip_levels);
+		register_gpu_allocation(GpuResourceType::Texture, m_texture_id, GpuMemoryCategory::Texture, get_memory_size(), m_internal_format);
+	}
 
-		glTextureParameteri(m_texture_id, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTextureParameteri(m_texture_id, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	void Texture::initialize(const TextureImage& image, const TextureSpecification& specification) {
+		m_width = image.width;
+		m_height = image.height;
+		m_internal_format = image.internal_format;
+		m_data_format = image.data_format;
+		m_compressed = image.compressed;
+		m_specification = specification;
+		m_mip_levels = get_storage_level_count(image, specification);
 
-		glTextureParameteri(m_texture_id, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(m_texture_id, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_texture_id);
+		glTextureStorage2D(m_texture_id, m_mip_levels, m_internal_format, m_width, m_height);
+		apply_texture_specification(m_texture_id, m_specification, m_mip_levels);
+		register_gpu_allocation(GpuResourceType::Texture, m_texture_id, GpuMemoryCategory::Texture, get_memory_size(), m_internal_format);
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, image.row_alignment);
+		for (uint32_t i = 0; i < std::min((uint32_t)image.levels.size(), m_mip_levels); i++) {
+			const TextureLevel& level = image.levels[i];
+			const uint8_t* data = image.get_data() + level.offset;
+			if (m_compressed)
+				glCompressedTextureSubImage2D(m_texture_id, i, 0, 0, level.width, level.height, m_internal_format, level.size, data);
+			else
+				glTextureSubImage2D(m_texture_id, i, 0, 0, level.width, level.height, image.data_format, image.data_type, data);
+		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		if (m_mip_levels > image.levels.size())
+			glGenerateTextureMipmap(m_texture_id);
 	}
 
 	Texture::~Texture() {
-		glDeleteTextures(1, &m_texture_id);
+		unregister_gpu_resource(m_handle);
+		if (!m_placeholder)
+			destroy_gpu_resource(GpuResourceType::Texture, m_texture_id);
 	}
 
 	void Texture::set_data(void* m_data) {
-		uint32_t bpp = m_data_format == GL_RGBA ? 4 : 3;
+		if (m_compressed) {
+			FRACTAL_LOG_ERROR("Cannot set the data of compressed texture '%s'", m_path.c_str());
+			return;
+		}
+
 		glTextureSubImage2D(m_texture_id, 0, 0, 0, m_width, m_height, m_data_format, GL_UNSIGNED_BYTE, m_data);
+		if (m_mip_levels > 1)
+			glGenerateTextureMipmap(m_texture_id);
+	}
+
+	void Texture::set_specification(const TextureSpecification& specification) {
+		m_specification = specification;
+		apply_texture_specification(m_texture_id, m_specification, m_mip_levels);
+	}
+
+	uint64_t Texture::get_memory_size() const {
+		if (m_placeholder || m_texture_id == 0)
+			return 0;
+
+		BlockFormat format = BlockFormat::BC1;
+		if (m_compressed)
+			get_block_format(m_internal_format, format);
+
+		uint64_t size = 0;
+		for (uint32_t i = 0; i < m_mip_levels; i++) {
+			uint32_t w = std::max(m_width >> i, 1u), h = std::max(m_height >> i, 1u);
+
+			//Drivers pad RGB8 out to four bytes per texel.
+			size += m_compressed ? get_compressed_size(format, w, h) : (uint64_t)w * h * 4;
+		}
+		return size;
 	}
 
 	void Texture::bind(uint32_t slot) {
@@ -92,4 +250,4 @@ namespace Fractal {
 	void Texture::unbind() {
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,253 @@
+/**
+ * @file texture_atlas.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the runtime texture atlas. Small images are packed into
+ * large pages with a skyline packer so they share a texture and batch slot.
+ */
+
+#include "texture_atlas.h"
+#include "log.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Fractal {
+	SkylinePacker::SkylinePacker(uint32_t width, uint32_t height) : m_width(width), m_height(height) {
+		m_skyline.push_back({ 0, 0, width });
+	}
+
+	bool SkylinePacker::fits(uint32_t index, uint32_t width, uint32_t height, uint32_t& y) const {
+		uint32_t x = m_skyline[index].x;
+		if (x + width > m_width)
+			return false;
+
+		y = m_skyline[index].y;
+		uint32_t remaining = width;
+		for (uint32_t i = index; remaining > 0; i++) {
+			y = std::max(y, m_skyline[i].y);
+			if (y + height > m_height)
+				return false;
+			remaining -= std::min(remaining, m_skyline[i].width);
+		}
+		return true;
+	}
+
+	bool SkylinePacker::pack(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y) {
+		uint32_t best_index = UINT32_MAX;
+		uint32_t best_top = UINT32_MAX;
+		uint32_t best_width = UINT32_MAX;
+
+		//Bottom left: lowest resulting top edge, ties go to the narrowest segment.
+		for (uint32_t i = 0; i < m_skyline.size(); i++) {
+			uint32_t node_y;
+			if (!fits(i, width, height, node_y))
+				continue;
+
+			if (node_y + height < best_top || (node_y + height == best_top && m_skyline[i].width < best_width)) {
+				best_index = i;
+				best_top = node_y + height;
+				best_width = m_skyline[i].width;
+				y = node_y;
+			}
+		}
+
+		if (best_index == UINT32_MAX)
+			return false;
+
+		x = m_skyline[best_index].x;
+		m_skyline.insert(m_skyline.begin() + best_index, { x, y + height, width });
+
+		for (uint32_t i = best_index + 1; i < m_skyline.size();) {
+			Node& previous = m_skyline[i - 1];
+			Node& node = m_skyline[i];
+			uint32_t previous_end = previous.x + previous.width;
+			if (node.x >= previous_end)
+				break;
+
+			uint32_t shrink = previous_end - node.x;
+			if (node.width <= shrink) {
+				m_skyline.erase(m_skyline.begin() + i);
+				continue;
+			}
+
+			node.x += shrink;
+			node.width -= shrink;
+			break;
+		}
+
+		for (uint32_t i = 0; i + 1 < m_skyline.size();) {
+			if (m_skyline[i].y == m_skyline[i + 1].y) {
+				m_skyline[i].width += m_skyline[i + 1].width;
+				m_skyline.erase(m_skyline.begin() + i + 1);
+			}
+			else
+				i++;
+		}
+
+		m_used_area += (uint64_t)width * height;
+		return true;
+	}
+
+	float SkylinePacker::get_occupancy() const {
+		return (float)((double)m_used_area / ((double)m_width * m_height));
+	}
+
+	TextureAtlas::TextureAtlas(const TextureAtlasSettings& settings) : m_settings(settings) {
+		//Gutters are rounded to a power of two so sprite edges stay texel aligned in every sampled mip.
+		while (m_gutter < m_settings.padding)
+			m_gutter = m_gutter ? m_gutter * 2 : 1;
+		m_alignment = std::max(m_gutter, 1u);
+
+		uint32_t mip_levels = 1;
+		for (uint32_t gutter = m_gutter; gutter > 1; gutter /= 2)
+			mip_levels++;
+		if (m_settings.specification.max_mip_levels == 0 || m_settings.specification.max_mip_levels > mip_levels)
+			m_settings.specification.max_mip_levels = mip_levels;
+	}
+
+	TextureAtlas::~TextureAtlas() {
+		for (auto& page : m_pages)
+			delete page.texture;
+	}
+
+	bool TextureAtlas::add(const std::string& path) {
+		if (is_known(path))
+			return true;
+
+		int w, h, channels;
+		stbi_set_flip_vertically_on_load_thread(1);
+		stbi_uc* pixels = stbi_load(path.c_str(), &w, &h, &channels, 4);
+		if (!pixels) {
+			FRACTAL_LOG_ERROR("Failed to load atlas image '%s'", path.c_str());
+			return false;
+		}
+
+		bool queued = add(path, pixels, w, h);
+		stbi_image_free(pixels);
+		return queued;
+	}
+
+	bool TextureAtlas::add(const std::string& name, const uint8_t* rgba, uint32_t width, uint32_t height) {
+		if (is_known(name))
+			return true;
+
+		if (width + m_gutter * 2 > m_settings.page_width || height + m_gutter * 2 > m_settings.page_height) {
+			FRACTAL_LOG_ERROR("Atlas image '%s' (%d x %d) does not fit in a page", name.c_str(), width, height);
+			return false;
+		}
+
+		PendingImage image;
+		image.name = name;
+		image.pixels.assign(rgba, rgba + (size_t)width * height * 4);
+		image.width = width;
+		image.height = height;
+		m_pending.push_back(std::move(image));
+		return true;
+	}
+
+	bool TextureAtlas::is_known(const std::string& name) const {
+		if (m_sub_textures.find(name) != m_sub_textures.end())
+			return true;
+		return std::any_of(m_pending.begin(), m_pending.end(), [&](const PendingImage& image) { return image.name == name; });
+	}
+
+	void TextureAtlas::build() {
+		//Packing tallest first keeps the skyline flat.
+		std::sort(m_pending.begin(), m_pending.end(), [](const PendingImage& a, const PendingImage& b) {
+			return (a.height != b.height) ? a.height > b.height : a.width > b.width;
+		});
+
+		for (const PendingImage& image : m_pending) {
+			if (!place(image))
+				FRACTAL_LOG_ERROR("Texture atlas is full, could not place '%s'", image.name.c_str());
+		}
+		m_pending.clear();
+
+		for (auto& page : m_pages) {
+			if (page.dirty) {
+				page.texture->set_data(page.pixels.data());
+				page.dirty = false;
+			}
+		}
+	}
+
+	bool TextureAtlas::place(const PendingImage& image) {
+		uint32_t width = (image.width + m_gutter * 2 + m_alignment - 1) / m_alignment * m_alignment;
+		uint32_t height = (image.height + m_gutter * 2 + m_alignment - 1) / m_alignment * m_alignment;
+
+		uint32_t x, y;
+		uint32_t page_index = 0;
+		for (; page_index < m_pages.size(); page_index++) {
+			if (m_pages[page_index].packer.pack(width, height, x, y))
+				break;
+		}
+
+		if (page_index == m_pages.size()) {
+			if (m_pages.size() == m_settings.max_pages)
+				return false;
+
+			Page page = { new Texture(), SkylinePacker(m_settings.page_width, m_settings.page_height), {}, true };
+			page.texture->initialize(m_settings.page_width, m_settings.page_height, m_settings.specification);
+			page.pixels.resize((size_t)m_settings.page_width * m_settings.page_height * 4, 0);
+			m_pages.push_back(std::move(page));
+
+			if (!m_pages.back().packer.pack(width, height, x, y))
+				return false;
+		}
+
+		Page& page = m_pages[page_index];
+		blit(page, image, x, y);
+		page.dirty = true;
+
+		//The entry is only published once it has a place, so a full atlas never hands out empty UVs.
+		glm::vec2 page_size = { (float)m_settings.page_width, (float)m_settings.page_height };
+		SubTexture& sub_texture = m_sub_textures[image.name];
+		sub_texture.width = image.width;
+		sub_texture.height = image.height;
+		sub_texture.texture_id = page.texture->get_texture_id();
+		sub_texture.page = page_index;
+		sub_texture.uv_min = glm::vec2(x + m_gutter, y + m_gutter) / page_size;
+		sub_texture.uv_max = glm::vec2(x + m_gutter + image.width, y + m_gutter + image.height) / page_size;
+		sub_texture.tex_coords[0] = { sub_texture.uv_min.x, sub_texture.uv_min.y };
+		sub_texture.tex_coords[1] = { sub_texture.uv_max.x, sub_texture.uv_min.y };
+		sub_texture.tex_coords[2] = { sub_texture.uv_max.x, sub_texture.uv_max.y };
+		sub_texture.tex_coords[3] = { sub_texture.uv_min.x, sub_texture.uv_max.y };
+		return true;
+	}
+
+	void TextureAtlas::blit(Page& page, const PendingImage& image, uint32_t x, uint32_t y) {
+		//Extrude the edge texels into the gutter so filtering and mips never pull in a neighbour.
+		for (uint32_t row = 0; row < image.height + m_gutter * 2; row++) {
+			uint32_t source_y = (uint32_t)std::min(std::max((int)row - (int)m_gutter, 0), (int)image.height - 1);
+			uint8_t* destination = page.pixels.data() + ((size_t)(y + row) * m_settings.page_width + x) * 4;
+			const uint8_t* source = image.pixels.data() + (size_t)source_y * image.width * 4;
+
+			for (uint32_t column = 0; column < m_gutter; column++) {
+				memcpy(destination + column * 4, source, 4);
+				memcpy(destination + (m_gutter + image.width + column) * 4, source + (image.width - 1) * 4, 4);
+			}
+			memcpy(destination + m_gutter * 4, source, (size_t)image.width * 4);
+		}
+	}
+
+	const SubTexture* TextureAtlas::get(const std::string& name) const {
+		auto it = m_sub_textures.find(name);
+		return (it != m_sub_textures.end()) ? &it->second : nullptr;
+	}
+
+	float TextureAtlas::get_occupancy(uint32_t page) const {
+		return m_pages[page].packer.get_occupancy();
+	}
+}
@@ -0,0 +1,533 @@
+/**
+ * @file texture_compression.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the block compressed texture code: a CPU BC1/BC3 encoder,
+ * mip chain downsampling and loaders for DDS and KTX containers.
+ */
+
+#include "texture_compression.h"
+#include "log.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+namespace Fractal {
+	static uint32_t read32(const uint8_t* data) {
+		return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+	}
+
+	static bool read_file(const std::string& path, std::vector<uint8_t>& data) {
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file.is_open())
+			return false;
+
+		std::streamsize size = file.tellg();
+		file.seekg(0, std::ios::beg);
+		data.resize((size_t)size);
+		return size == 0 || (bool)file.read((char*)data.data(), size);
+	}
+
+	uint32_t get_mip_level_count(uint32_t width, uint32_t height) {
+		uint32_t size = std::max(width, height);
+		uint32_t levels = 1;
+		while (size > 1) {
+			size >>= 1;
+			levels++;
+		}
+		return levels;
+	}
+
+	uint32_t get_block_size(BlockFormat format) {
+		return (format == BlockFormat::BC1) ? 8 : 16;
+	}
+
+	uint32_t get_block_gl_format(BlockFormat format) {
+		switch (format) {
+		case BlockFormat::BC1: return FRACTAL_COMPRESSED_RGBA_S3TC_DXT1;
+		case BlockFormat::BC2: return FRACTAL_COMPRESSED_RGBA_S3TC_DXT3;
+		case BlockFormat::BC3: return FRACTAL_COMPRESSED_RGBA_S3TC_DXT5;
+		}
+		return 0;
+	}
+
+	bool get_block_format(uint32_t gl_format, BlockFormat& format) {
+		switch (gl_format) {
+		case FRACTAL_COMPRESSED_RGB_S3TC_DXT1:
+		case FRACTAL_COMPRESSED_RGBA_S3TC_DXT1: format = BlockFormat::BC1; return true;
+		case FRACTAL_COMPRESSED_RGBA_S3TC_DXT3: format = BlockFormat::BC2; return true;
+		case FRACTAL_COMPRESSED_RGBA_S3TC_DXT5: format = BlockFormat::BC3; return true;
+		}
+		return false;
+	}
+
+	uint32_t get_compressed_size(BlockFormat format, uint32_t width, uint32_t height) {
+		return ((width + 3) / 4) * ((height + 3) / 4) * get_block_size(format);
+	}
+
+	uint32_t get_row_size(const TextureImage& image, const TextureLevel& level) {
+		if (image.compressed) {
+			BlockFormat format = BlockFormat::BC1;
+			get_block_format(image.internal_format, format);
+			return ((level.width + 3) / 4) * get_block_size(format);
+		}
+
+		uint32_t pixel_size = (image.data_format == GL_RGBA) ? 4 : 3;
+		uint32_t alignment = std::max(image.row_alignment, 1u);
+		return (level.width * pixel_size + alignment - 1) / alignment * alignment;
+	}
+
+	uint32_t get_row_count(const TextureImage& image, const TextureLevel& level) {
+		return image.compressed ? (level.height + 3) / 4 : level.height;
+	}
+
+	void downsample_rgba(const uint8_t* source, uint32_t width, uint32_t height, uint8_t* destination) {
+		uint32_t next_width = std::max(width / 2, 1u);
+		uint32_t next_height = std::max(height / 2, 1u);
+
+		for (uint32_t y = 0; y < next_height; y++) {
+			uint32_t y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+			for (uint32_t x = 0; x < next_width; x++) {
+				uint32_t x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+				for (uint32_t c = 0; c < 4; c++) {
+					uint32_t sum = source[(y0 * width + x0) * 4 + c] + source[(y0 * width + x1) * 4 + c] +
+						source[(y1 * width + x0) * 4 + c] + source[(y1 * width + x1) * 4 + c];
+					destination[(y * next_width + x) * 4 + c] = (uint8_t)((sum + 2) / 4);
+				}
+			}
+		}
+	}
+
+	static void fetch_block(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t block_x, uint32_t block_y, uint8_t* block) {
+		for (uint32_t y = 0; y < 4; y++) {
+			uint32_t source_y = std::min(block_y * 4 + y, height - 1);
+			for (uint32_t x = 0; x < 4; x++) {
+				uint32_t source_x = std::min(block_x * 4 + x, width - 1);
+				memcpy(block + (y * 4 + x) * 4, rgba + (source_y * width + source_x) * 4, 4);
+			}
+		}
+	}
+
+	static uint16_t pack_565(const int* color) {
+		return (uint16_t)(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3));
+	}
+
+	static void unpack_565(uint16_t packed, int* color) {
+		int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+
+	static void encode_color_block(const uint8_t* block, uint8_t* destination) {
+		int min[3] = { 255, 255, 255 }, max[3] = { 0, 0, 0 };
+		for (uint32_t i = 0; i < 16; i++) {
+			for (uint32_t c = 0; c < 3; c++) {
+				min[c] = std::min(min[c], (int)block[i * 4 + c]);
+				max[c] = std::max(max[c], (int)block[i * 4 + c]);
+			}
+		}
+
+		//Pick the bounding box diagonal that follows the colors' correlation with red.
+		int center[3] = { (min[0] + max[0]) / 2, (min[1] + max[1]) / 2, (min[2] + max[2]) / 2 };
+		int covariance[2] = { 0, 0 };
+		for (uint32_t i = 0; i < 16; i++) {
+			int r = block[i * 4] - center[0];
+			covariance[0] += r * (block[i * 4 + 1] - center[1]);
+			covariance[1] += r * (block[i * 4 + 2] - center[2]);
+		}
+		for (uint32_t c = 1; c < 3; c++) {
+			if (covariance[c - 1] < 0)
+				std::swap(min[c], max[c]);
+		}
+
+		//Inset the endpoints so the interpolated colors cover the block better.
+		for (uint32_t c = 0; c < 3; c++) {
+			int inset = (max[c] - min[c]) / 16;
+			min[c] = std::min(std::max(min[c] + inset, 0), 255);
+			max[c] = std::min(std::max(max[c] - inset, 0), 255);
+		}
+
+		uint16_t color0 = pack_565(max), color1 = pack_565(min);
+		if (color0 < color1)
+			std::swap(color0, color1);
+
+		uint32_t indices = 0;
+		if (color0 != color1) {
+			int palette[4][3];
+			unpack_565(color0, palette[0]);
+			unpack_565(color1, palette[1]);
+			for (uint32_t c = 0; c < 3; c++) {
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+
+			for (uint32_t i = 0; i < 16; i++) {
+				uint32_t best = 0;
+				int best_distance = INT32_MAX;
+				for (uint32_t p = 0; p < 4; p++) {
+					int distance = 0;
+					for (uint32_t c = 0; c < 3; c++) {
+						int d = block[i * 4 + c] - palette[p][c];
+						distance += d * d;
+					}
+					if (distance < best_distance) {
+						best_distance = distance;
+						best = p;
+					}
+				}
+				indices |= best << (i * 2);
+			}
+		}
+
+		destination[0] = color0 & 0xFF;
+		destination[1] = color0 >> 8;
+		destination[2] = color1 & 0xFF;
+		destination[3] = color1 >> 8;
+		for (uint32_t i = 0; i < 4; i++)
+			destination[4 + i] = (indices >> (i * 8)) & 0xFF;
+	}
+
+	static void encode_alpha_block(const uint8_t* block, uint8_t* destination) {
+		int min = 255, max = 0;
+		for (uint32_t i = 0; i < 16; i++) {
+			min = std::min(min, (int)block[i * 4 + 3]);
+			max = std::max(max, (int)block[i * 4 + 3]);
+		}
+
+		memset(destination, 0, 8);
+		destination[0] = (uint8_t)max;
+		destination[1] = (uint8_t)min;
+		if (min == max)
+			return;
+
+		int palette[8] = { max, min };
+		for (int i = 2; i < 8; i++)
+			palette[i] = ((8 - i) * max + (i - 1) * min) / 7;
+
+		uint64_t indices = 0;
+		for (uint32_t i = 0; i < 16; i++) {
+			uint64_t best = 0;
+			int best_distance = INT32_MAX;
+			for (uint32_t p = 0; p < 8; p++) {
+				int distance = std::abs(block[i * 4 + 3] - palette[p]);
+				if (distance < best_distance) {
+					best_distance = distance;
+					best = p;
+				}
+			}
+			indices |= best << (i * 3);
+		}
+
+		for (uint32_t i = 0; i < 6; i++)
+			destination[2 + i] = (indices >> (i * 8)) & 0xFF;
+	}
+
+	void compress_bc1(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* destination) {
+		uint8_t block[64];
+		for (uint32_t y = 0; y < (height + 3) / 4; y++) {
+			for (uint32_t x = 0; x < (width + 3) / 4; x++) {
+				fetch_block(rgba, width, height, x, y, block);
+				encode_color_block(block, destination);
+				destination += 8;
+			}
+		}
+	}
+
+	void compress_bc3(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* destination) {
+		uint8_t block[64];
+		for (uint32_t y = 0; y < (height + 3) / 4; y++) {
+			for (uint32_t x = 0; x < (width + 3) / 4; x++) {
+				fetch_block(rgba, width, height, x, y, block);
+				encode_alpha_block(block, destination);
+				encode_color_block(block, destination + 8);
+				destination += 16;
+			}
+		}
+	}
+
+	void build_mip_chain(const uint8_t* rgba, uint32_t width, uint32_t height, TextureImage& image) {
+		image = TextureImage();
+		image.width = width;
+		image.height = height;
+		image.internal_format = GL_RGBA8;
+		image.data_format = GL_RGBA;
+		image.data_type = GL_UNSIGNED_BYTE;
+
+		uint32_t offset = 0;
+		for (uint32_t i = 0, w = width, h = height; i < get_mip_level_count(width, height); i++, w = std::max(w / 2, 1u), h = std::max(h / 2, 1u)) {
+			TextureLevel level;
+			level.width = w;
+			level.height = h;
+			level.offset = offset;
+			level.size = w * h * 4;
+			image.levels.push_back(level);
+			offset += level.size;
+		}
+
+		image.data.resize(offset);
+		memcpy(image.data.data(), rgba, image.levels[0].size);
+		for (uint32_t i = 1; i < image.levels.size(); i++) {
+			const TextureLevel& previous = image.levels[i - 1];
+			downsample_rgba(image.data.data() + previous.offset, previous.width, previous.height, image.data.data() + image.levels[i].offset);
+		}
+	}
+
+	bool compress_image(const uint8_t* rgba, uint32_t width, uint32_t height, bool has_alpha, bool generate_mips, TextureImage& image) {
+		if (!rgba || width == 0 || height == 0)
+			return false;
+
+		BlockFormat format = has_alpha ? BlockFormat::BC3 : BlockFormat::BC1;
+		uint32_t level_count = generate_mips ? get_mip_level_count(width, height) : 1;
+
+		image = TextureImage();
+		image.width = width;
+		image.height = height;
+		image.internal_format = has_alpha ? FRACTAL_COMPRESSED_RGBA_S3TC_DXT5 : FRACTAL_COMPRESSED_RGB_S3TC_DXT1;
+		image.compressed = true;
+
+		uint32_t offset = 0;
+		for (uint32_t i = 0, w = width, h = height; i < level_count; i++, w = std::max(w / 2, 1u), h = std::max(h / 2, 1u)) {
+			TextureLevel level;
+			level.width = w;
+			level.height = h;
+			level.offset = offset;
+			level.size = get_compressed_size(format, w, h);
+			image.levels.push_back(level);
+			offset += level.size;
+		}
+		image.data.resize(offset);
+
+		std::vector<uint8_t> current(rgba, rgba + (size_t)width * height * 4);
+		std::vector<uint8_t> next;
+		for (uint32_t i = 0; i < level_count; i++) {
+			const TextureLevel& level = image.levels[i];
+			if (has_alpha)
+				compress_bc3(current.data(), level.width, level.height, image.data.data() + level.offset);
+			else
+				compress_bc1(current.data(), level.width, level.height, image.data.data() + level.offset);
+
+			if (i + 1 < level_count) {
+				next.resize((size_t)std::max(level.width / 2, 1u) * std::max(level.height / 2, 1u) * 4);
+				downsample_rgba(current.data(), level.width, level.height, next.data());
+				current.swap(next);
+			}
+		}
+
+		return true;
+	}
+
+	bool load_dds(const std::string& path, TextureImage& image) {
+		const uint32_t DDS_MAGIC = 0x20534444;
+		const uint32_t DDS_HEADER_SIZE = 128;
+		const uint32_t DDPF_FOURCC = 0x4;
+
+		image = TextureImage();
+		if (!read_file(path, image.data)) {
+			FRACTAL_LOG_ERROR("Failed to open DDS file '%s'", path.c_str());
+			return false;
+		}
+
+		if (image.data.size() < DDS_HEADER_SIZE || read32(image.data.data()) != DDS_MAGIC) {
+			FRACTAL_LOG_ERROR("'%s' is not a DDS file", path.c_str());
+			return false;
+		}
+
+		const uint8_t* header = image.data.data() + 4;
+		image.height = read32(header + 8);
+		image.width = read32(header + 12);
+		uint32_t level_count = std::max(read32(header + 24), 1u);
+		uint32_t pixel_flags = read32(header + 76);
+		uint32_t four_cc = read32(header + 80);
+
+		BlockFormat format;
+		if (!(pixel_flags & DDPF_FOURCC)) {
+			FRACTAL_LOG_ERROR("DDS file '%s' is not block compressed", path.c_str());
+			return false;
+		}
+		else if (four_cc == read32((const uint8_t*)"DXT1"))
+			format = BlockFormat::BC1;
+		else if (four_cc == read32((const uint8_t*)"DXT3"))
+			format = BlockFormat::BC2;
+		else if (four_cc == read32((const uint8_t*)"DXT5"))
+			format = BlockFormat::BC3;
+		else {
+			FRACTAL_LOG_ERROR("DDS file '%s' uses an unsupported format", path.c_str());
+			return false;
+		}
+
+		image.internal_format = get_block_gl_format(format);
+		image.compressed = true;
+
+		uint32_t offset = DDS_HEADER_SIZE;
+		for (uint32_t i = 0, w = image.width, h = image.height; i < level_count; i++, w = std::max(w / 2, 1u), h = std::max(h / 2, 1u)) {
+			TextureLevel level;
+			level.width = w;
+			level.height = h;
+			level.offset = offset;
+			level.size = get_compressed_size(format, w, h);
+			if (offset + level.size > image.data.size()) {
+				FRACTAL_LOG_ERROR("DDS file '%s' is truncated", path.c_str());
+				return false;
+			}
+			image.levels.push_back(level);
+			offset += level.size;
+		}
+
+		flip_image(image);
+		return true;
+	}
+
+	bool load_ktx(const std::string& path, TextureImage& image) {
+		const uint8_t KTX_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+		const uint32_t KTX_HEADER_SIZE = 64;
+		const uint32_t KTX_ENDIANNESS = 0x04030201;
+
+		image = TextureImage();
+		if (!read_file(path, image.data)) {
+			FRACTAL_LOG_ERROR("Failed to open KTX file '%s'", path.c_str());
+			return false;
+		}
+
+		const uint8_t* header = image.data.data();
+		if (image.data.size() < KTX_HEADER_SIZE || memcmp(header, KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER)) != 0) {
+			FRACTAL_LOG_ERROR("'%s' is not a KTX file", path.c_str());
+			return false;
+		}
+
+		if (read32(header + 12) != KTX_ENDIANNESS) {
+			FRACTAL_LOG_ERROR("KTX file '%s' has an unsupported byte order", path.c_str());
+			return false;
+		}
+
+		uint32_t data_type = read32(header + 16);
+		uint32_t data_format = read32(header + 24);
+		image.internal_format = read32(header + 28);
+		image.width = read32(header + 36);
+		image.height = std::max(read32(header + 40), 1u);
+		uint32_t depth = read32(header + 44);
+		uint32_t array_count = read32(header + 48);
+		uint32_t face_count = read32(header + 52);
+		uint32_t level_count = std::max(read32(header + 56), 1u);
+		uint32_t key_value_size = read32(header + 60);
+
+		if (depth > 1 || array_count > 0 || face_count != 1) {
+			FRACTAL_LOG_ERROR("KTX file '%s' is not a 2D texture", path.c_str());
+			return false;
+		}
+
+		BlockFormat format;
+		if (data_type == 0) {
+			if (!get_block_format(image.internal_format, format)) {
+				FRACTAL_LOG_ERROR("KTX file '%s' uses an unsupported compressed format", path.c_str());
+				return false;
+			}
+			image.compressed = true;
+		}
+		else if (data_type == GL_UNSIGNED_BYTE && (data_format == GL_RGBA || data_format == GL_RGB)) {
+			image.internal_format = (data_format == GL_RGBA) ? GL_RGBA8 : GL_RGB8;
+			image.data_format = data_format;
+			image.data_type = data_type;
+		}
+		else {
+			FRACTAL_LOG_ERROR("KTX file '%s' uses an unsupported format", path.c_str());
+			return false;
+		}
+
+		uint32_t offset = KTX_HEADER_SIZE + key_value_size;
+		for (uint32_t i = 0, w = image.width, h = image.height; i < level_count; i++, w = std::max(w / 2, 1u), h = std::max(h / 2, 1u)) {
+			if (offset + 4 > image.data.size())
+				break;
+
+			TextureLevel level;
+			level.width = w;
+			level.height = h;
+			level.size = read32(image.data.data() + offset);
+			level.offset = offset + 4;
+
+			uint32_t expected = get_row_size(image, level) * get_row_count(image, level);
+			if (level.size < expected || level.offset + level.size > image.data.size())
+				break;
+
+			image.levels.push_back(level);
+			offset = level.offset + ((level.size + 3) & ~3u);
+		}
+
+		if (image.levels.size() != level_count) {
+			FRACTAL_LOG_ERROR("KTX file '%s' is truncated", path.c_str());
+			return false;
+		}
+
+		flip_image(image);
+		return true;
+	}
+
+	static void flip_block(uint8_t* block, BlockFormat format, uint32_t rows) {
+		if (rows < 2)
+			return;
+
+		uint8_t* color = block;
+		if (format == BlockFormat::BC2) {
+			for (uint32_t y = 0; y < rows / 2; y++) {
+				std::swap(block[y * 2], block[(rows - 1 - y) * 2]);
+				std::swap(block[y * 2 + 1], block[(rows - 1 - y) * 2 + 1]);
+			}
+			color = block + 8;
+		}
+		else if (format == BlockFormat::BC3) {
+			uint64_t indices = 0, flipped = 0;
+			for (uint32_t i = 0; i < 6; i++)
+				indices |= (uint64_t)block[2 + i] << (i * 8);
+
+			flipped = indices;
+			for (uint32_t y = 0; y < rows; y++) {
+				uint64_t row = (indices >> (y * 12)) & 0xFFF;
+				uint32_t target = rows - 1 - y;
+				flipped = (flipped & ~(0xFFFull << (target * 12))) | (row << (target * 12));
+			}
+
+			for (uint32_t i = 0; i < 6; i++)
+				block[2 + i] = (flipped >> (i * 8)) & 0xFF;
+			color = block + 8;
+		}
+
+		for (uint32_t y = 0; y < rows / 2; y++)
+			std::swap(color[4 + y], color[4 + rows - 1 - y]);
+	}
+
+	void flip_image(TextureImage& image) {
+		BlockFormat format = BlockFormat::BC1;
+		if (image.compressed)
+			get_block_format(image.internal_format, format);
+
+		for (const TextureLevel& level : image.levels) {
+			uint8_t* data = image.data.data() + level.offset;
+			uint32_t stride = get_row_size(image, level);
+			uint32_t rows = get_row_count(image, level);
+
+			for (uint32_t y = 0; y < rows / 2; y++)
+				std::swap_ranges(data + y * stride, data + (y + 1) * stride, data + (rows - 1 - y) * stride);
+
+			if (!image.compressed)
+				continue;
+
+			//Exact when the height is a multiple of four, which block compressed assets are authored at.
+			uint32_t block_rows = std::min(level.height, 4u);
+			uint32_t block_size = get_block_size(format);
+			for (uint32_t i = 0; i < stride / block_size * rows; i++)
+				flip_block(data + i * block_size, format, block_rows);
+		}
+	}
+}
@@ -0,0 +1,253 @@
+/**
+ * @file texture_loader.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the asynchronous texture loader. Images are decoded on
+ * worker threads and uploaded on the GL thread in budgeted slices through a
+ * ring of pixel unpack buffers.
+ */
+
+#include "texture_loader.h"
+#include "log.h"
+#include "gpu_resources.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace Fractal {
+	using Clock = std::chrono::high_resolution_clock;
+
+	static float elapsed_ms(const Clock::time_point& start) {
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	TextureLoader::TextureLoader(uint32_t worker_count) {
+		m_workers = new ThreadPool(worker_count);
+
+		const uint8_t placeholder[4] = { 128, 128, 128, 255 };
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_placeholder_id);
+		glTextureStorage2D(m_placeholder_id, 1, GL_RGBA8, 1, 1);
+		glTextureSubImage2D(m_placeholder_id, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+		register_gpu_allocation(GpuResourceType::Texture, m_placeholder_id, GpuMemoryCategory::Texture, 4, GL_RGBA8, "Texture Placeholder");
+
+		for (auto& staging : m_staging) {
+			staging.buffer = new PixelUnpackBuffer(TEXTURE_STAGING_BUFFER_SIZE);
+			set_gpu_allocation_name(GpuResourceType::Buffer, staging.buffer->get_id(), "Texture Staging");
+		}
+	}
+
+	TextureLoader::~TextureLoader() {
+		m_workers->wait_idle();
+		delete m_workers;
+
+		if (m_uploading)
+			finish(m_uploading, true);
+		for (auto request : m_decoded)
+			finish(request, true);
+		m_decoded.clear();
+
+		for (auto& staging : m_staging)
+			delete staging.buffer;
+		destroy_gpu_resource(GpuResourceType::Texture, m_placeholder_id);
+	}
+
+	std::shared_ptr<Texture> TextureLoader::load(const std::string& path, const TextureSpecification& specification) {
+		std::shared_ptr<Texture> texture = std::make_shared<Texture>();
+		texture->m_texture_id = m_placeholder_id;
+		texture->m_placeholder = true;
+		texture->m_path = path;
+
+		Request* request = new Request();
+		request->texture = texture;
+		request->path = path;
+		request->specification = specification;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_progress.requested++;
+		}
+
+		m_workers->submit([this, request] { decode(request); });
+		return texture;
+	}
+
+	void TextureLoader::decode(Request* request) {
+		Clock::time_point start = Clock::now();
+
+		//Block compression runs here too, so it never touches the GL thread.
+		request->loaded = load_texture_image(request->path, request->specification, request->image);
+		request->decode_ms = elapsed_ms(start);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_decoded.push_back(request);
+		m_progress.decoded++;
+	}
+
+	void TextureLoader::update(float budget_ms) {
+		Clock::time_point start = Clock::now();
+
+		while (elapsed_ms(start) < budget_ms) {
+			if (!m_uploading) {
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					if (m_decoded.empty())
+						break;
+					m_uploading = m_decoded.front();
+					m_decoded.pop_front();
+				}
+
+				if (!m_uploading->loaded || m_uploading->texture.expired()) {
+					finish(m_uploading, true);
+					m_uploading = nullptr;
+					continue;
+				}
+
+				const TextureImage& image = m_uploading->image;
+				m_uploading->mip_levels = get_storage_level_count(image, m_uploading->specification);
+				glCreateTextures(GL_TEXTURE_2D, 1, &m_uploading->texture_id);
+				glTextureStorage2D(m_uploading->texture_id, m_uploading->mip_levels, image.internal_format, image.width, image.height);
+				apply_texture_specification(m_uploading->texture_id, m_uploading->specification, m_uploading->mip_levels);
+			}
+
+			//Every staging buffer is still in use by the GPU, continue next frame.
+			if (!upload_slice(m_uploading))
+				break;
+
+			if (m_uploading->level == std::min((uint32_t)m_uploading->image.levels.size(), m_uploading->mip_levels)) {
+				finish(m_uploading, false);
+				m_uploading = nullptr;
+			}
+		}
+	}
+
+	bool TextureLoader::upload_slice(Request* request) {
+		Clock::time_point start = Clock::now();
+
+		//Compressed levels are sliced in rows of 4x4 blocks.
+		const TextureImage& image = request->image;
+		const TextureLevel& level = image.levels[request->level];
+		uint32_t row_size = get_row_size(image, level);
+		uint32_t row_count = get_row_count(image, level);
+		uint32_t rows = std::max(TEXTURE_STAGING_BUFFER_SIZE / row_size, 1u);
+		rows = std::min(rows, row_count - request->rows_uploaded);
+		uint32_t size = rows * row_size;
+
+		StagingBuffer* staging = acquire_staging_buffer(size);
+		if (!staging)
+			return false;
+
+		void* destination = staging->buffer->map(size);
+		if (!destination) {
+			FRACTAL_LOG_ERROR("Failed to map texture staging buffer for '%s'", request->path.c_str());
+			return false;
+		}
+		memcpy(destination, image.get_data() + level.offset + (size_t)request->rows_uploaded * row_size, size);
+		staging->buffer->unmap();
+
+		staging->buffer->bind();
+		if (image.compressed) {
+			uint32_t y = request->rows_uploaded * 4;
+			uint32_t height = std::min(rows * 4, level.height - y);
+			glCompressedTextureSubImage2D(request->texture_id, request->level, 0, y, level.width, height, image.internal_format, size, nullptr);
+		}
+		else {
+			glPixelStorei(GL_UNPACK_ALIGNMENT, image.row_alignment);
+			glTextureSubImage2D(request->texture_id, request->level, 0, request->rows_uploaded, level.width, rows, image.data_format, image.data_type, nullptr);
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		}
+		staging->buffer->unbind();
+		staging->fence.insert();
+
+		request->rows_uploaded += rows;
+		if (request->rows_uploaded == row_count) {
+			request->level++;
+			request->rows_uploaded = 0;
+		}
+
+		request->upload_ms += elapsed_ms(start);
+		return true;
+	}
+
+	TextureLoader::StagingBuffer* TextureLoader::acquire_staging_buffer(uint32_t size) {
+		StagingBuffer* staging = &m_staging[m_staging_index];
+		if (!staging->fence.signaled())
+			return nullptr;
+
+		staging->fence.reset();
+		if (staging->buffer->get_size() < size)
+			staging->buffer->allocate_data(size);
+
+		m_staging_index = (m_staging_index + 1) % TEXTURE_STAGING_BUFFER_COUNT;
+		return staging;
+	}
+
+	void TextureLoader::finish(Request* request, bool failed) {
+		std::shared_ptr<Texture> texture = request->texture.lock();
+
+		const TextureImage& image = request->image;
+		if (texture && !failed) {
+			if (request->mip_levels > image.levels.size())
+				glGenerateTextureMipmap(request->texture_id);
+
+			texture->m_texture_id = request->texture_id;
+			texture->m_width = image.width;
+			texture->m_height = image.height;
+			texture->m_mip_levels = request->mip_levels;
+			texture->m_compressed = image.compressed;
+			texture->m_internal_format = image.internal_format;
+			texture->m_data_format = image.data_format;
+			texture->m_specification = request->specification;
+			texture->m_placeholder = false;
+			register_gpu_allocation(GpuResourceType::Texture, texture->m_texture_id, GpuMemoryCategory::Texture, texture->get_memory_size(), image.internal_format, request->path);
+			FRACTAL_LOG_GOOD("Loaded texture '%s' (decode %.2f ms, upload %.2f ms)", request->path.c_str(), request->decode_ms, request->upload_ms);
+		}
+		else {
+			if (request->texture_id)
+				destroy_gpu_resource(GpuResourceType::Texture, request->texture_id);
+			if (texture)
+				FRACTAL_LOG_ERROR("Failed to load texture '%s'", request->path.c_str());
+			failed = true;
+		}
+
+		TextureLoadStatistics statistics;
+		statistics.path = request->path;
+		statistics.width = image.width;
+		statistics.height = image.height;
+		statistics.decode_ms = request->decode_ms;
+		statistics.upload_ms = request->upload_ms;
+		statistics.failed = failed;
+		m_statistics.push_back(statistics);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (failed)
+				m_progress.failed++;
+			else
+				m_progress.completed++;
+		}
+
+		delete request;
+	}
+
+	bool TextureLoader::is_idle() const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_progress.completed + m_progress.failed == m_progress.requested;
+	}
+
+	TextureLoadProgress TextureLoader::get_progress() const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_progress;
+	}
+}
@@ -0,0 +1,84 @@
+/**
+ * @file thread_pool.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains a simple pool of worker threads fed from a shared queue,
+ * used for blocking work such as file decoding and disk writes.
+ */
+
+#include "thread_pool.h"
+#include <algorithm>
+
+namespace Fractal {
+	ThreadPool::ThreadPool(uint32_t thread_count) {
+		if (thread_count == 0)
+			thread_count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		for (uint32_t i = 0; i < thread_count; i++)
+			m_threads.emplace_back(&ThreadPool::worker_loop, this);
+	}
+
+	ThreadPool::~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_task_condition.notify_all();
+
+		for (auto& thread : m_threads)
+			thread.join();
+	}
+
+	void ThreadPool::submit(const std::function<void()>& task) {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_tasks.push_back(task);
+		}
+		m_task_condition.notify_one();
+	}
+
+	void ThreadPool::wait_idle() {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_idle_condition.wait(lock, [this] { return m_tasks.empty() && m_active == 0; });
+	}
+
+	uint32_t ThreadPool::get_pending() const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return (uint32_t)m_tasks.size() + m_active;
+	}
+
+	void ThreadPool::worker_loop() {
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_task_condition.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+				if (m_stop && m_tasks.empty())
+					return;
+
+				task = std::move(m_tasks.front());
+				m_tasks.pop_front();
+				m_active++;
+			}
+
+			task();
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_active--;
+				if (m_tasks.empty() && m_active == 0)
+					m_idle_condition.notify_all();
+			}
+		}
+	}
+}
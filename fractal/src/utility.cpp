@@ -17,11 +17,19 @@
 
 #include "utility.h"
 #include "config.h"
+#include "platform.h"
 
 #include <GLFW/glfw3.h>
 #include "stb_image.h"
 #include "application.h"
 
+#include <algorithm>
+#include <cctype>
+#include <stdlib.h>
+#ifndef FRACTAL_PLATFORM_WINDOWS
+#include <limits.h>
+#endif
+
 namespace Fractal {
     int version_major() {
         return FRACTAL_VERSION_MAJOR;
@@ -45,4 +53,19 @@ namespace Fractal {
     std::string get_name_of_path(const std::string& path) {
         return path.substr(path.find_last_of("/\\") + 1);;
     }
+
+    std::string get_canonical_path(const std::string& path) {
+#ifdef FRACTAL_PLATFORM_WINDOWS
+        char buffer[_MAX_PATH];
+        std::string canonical = _fullpath(buffer, path.c_str(), _MAX_PATH) ? buffer : path;
+
+        //Windows paths are case insensitive, so fold them for comparisons.
+        std::replace(canonical.begin(), canonical.end(), '\\', '/');
+        std::transform(canonical.begin(), canonical.end(), canonical.begin(), ::tolower);
+#else
+        char buffer[PATH_MAX];
+        std::string canonical = realpath(path.c_str(), buffer) ? buffer : path;
+#endif
+        return canonical;
+    }
 } 
@@ -16,6 +16,7 @@
  */
 
 #include "vertex_array.h"
+#include "gpu_resources.h"
 #include <glad/glad.h>
 
 namespace Fractal {
@@ -30,12 +31,22 @@ namespace Fractal {
 		return GL_NONE;
 	}
 
+	//Integer attributes keep their bits instead of being converted to floats.
+	static void set_attribute_pointer(const VertexBufferElement& element, uint32_t stride, uintptr_t offset) {
+		if (element.type == VertexShaderType::Int)
+			glVertexAttribIPointer(element.index, element.size, GL_INT, stride, (void*)offset);
+		else
+			glVertexAttribPointer(element.index, element.size, VertexShaderTypeToOpenGL(element.type), element.normalized ? GL_TRUE : GL_FALSE, stride, (void*)offset);
+	}
+
 	VertexArray::VertexArray() {
 		glGenVertexArrays(1, &m_vertex_array_buffer_id);
+		m_handle = register_gpu_resource(this);
 	}
 
 	VertexArray::~VertexArray() {
-		glDeleteVertexArrays(1, &m_vertex_array_buffer_id);
+		unregister_gpu_resource(m_handle);
+		destroy_gpu_resource(GpuResourceType::VertexArray, m_vertex_array_buffer_id);
 	}
 
 	void VertexArray::bind() {
@@ -59,14 +70,10 @@ namespace Fractal {
 		for (auto& elements : vertex_buf->get_layout()->get_layout()) {
 			switch (format) {
 			case VertexBufferFormat::VNCVNCVNC:
-				glVertexAttribPointer(elements.index, elements.size, VertexShaderTypeToOpenGL(elements.type), elements.normalized ? GL_TRUE : GL_FALSE,
-					stride * get_size_in_bytes(elements.type),
-					(void*)(elements.offset * get_size_in_bytes(elements.type)));
+				set_attribute_pointer(elements, stride * get_size_in_bytes(elements.type), elements.offset * get_size_in_bytes(elements.type));
 				break;
 			case VertexBufferFormat::VVVCCCNNN:
-				glVertexAttribPointer(elements.index, elements.size, VertexShaderTypeToOpenGL(elements.type), elements.normalized ? GL_TRUE : GL_FALSE,
-					0,
-					(void*)(elements.offset * get_size_in_bytes(elements.type)));
+				set_attribute_pointer(elements, 0, elements.offset * get_size_in_bytes(elements.type));
 				break;
 			}
 
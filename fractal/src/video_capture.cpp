@@ -0,0 +1,300 @@
+/**
+ * @file video_capture.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains the offline video capture. Frames are read back through
+ * a pixel pack buffer ring, then converted and written on worker threads.
+ */
+
+#include "video_capture.h"
+#include "utility.h"
+#include "log.h"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+#include <cstring>
+
+namespace Fractal {
+	constexpr uint32_t CAPTURE_READBACK_SLOTS = 3;
+	constexpr uint64_t CAPTURE_WAIT_TIMEOUT = 1000000000;
+
+	VideoCapture::~VideoCapture() {
+		stop();
+	}
+
+	bool VideoCapture::start(const CaptureSettings& settings) {
+		if (m_recording) {
+			FRACTAL_LOG_WARNING("Video capture is already recording to '%s'", m_settings.path.c_str());
+			return false;
+		}
+
+		m_settings = settings;
+		if (m_settings.format == CaptureFormat::Y4M) {
+			m_file = fopen(m_settings.path.c_str(), "wb");
+			if (!m_file) {
+				FRACTAL_LOG_ERROR("Failed to open capture file '%s'", m_settings.path.c_str());
+				return false;
+			}
+
+			fprintf(m_file, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C420jpeg\n", m_settings.width, m_settings.height, m_settings.fps);
+		}
+
+		m_readback = new AsyncReadback(CAPTURE_READBACK_SLOTS);
+		m_workers = new ThreadPool(m_settings.worker_count);
+
+		m_next_capture = 0;
+		m_next_write = 0;
+		m_queued = 0;
+		m_frames_written = 0;
+		m_bytes_written = 0;
+		m_write_failures = 0;
+		m_lost_frames = 0;
+		m_start_time = Time::get_time();
+		m_recording = true;
+
+		FRACTAL_LOG("Started video capture '%s' at %d by %d", m_settings.path.c_str(), m_settings.width, m_settings.height);
+		return true;
+	}
+
+	void VideoCapture::capture(FrameBuffer* frame_buffer) {
+		if (!m_recording)
+			return;
+
+		collect(false);
+
+		ReadbackTicket ticket = m_readback->request(frame_buffer, 0, 0, m_settings.width, m_settings.height);
+		if (!ticket.valid()) {
+			//The ring is full, so wait on the oldest readback rather than dropping this frame.
+			collect(true);
+			ticket = m_readback->request(frame_buffer, 0, 0, m_settings.width, m_settings.height);
+		}
+
+		if (ticket.valid())
+			m_pending.push_back({ ticket, m_next_capture++ });
+		else {
+			FRACTAL_LOG_ERROR("Video capture failed to read back frame %d", (int)m_next_capture);
+			m_lost_frames++;
+		}
+	}
+
+	void VideoCapture::stop() {
+		if (!m_recording)
+			return;
+
+		while (!m_pending.empty())
+			collect(true);
+
+		m_workers->wait_idle();
+		delete m_workers;
+		m_workers = nullptr;
+
+		delete m_readback;
+		m_readback = nullptr;
+
+		if (m_file) {
+			fclose(m_file);
+			m_file = nullptr;
+		}
+
+		for (auto frame : m_free_frames)
+			delete frame;
+		m_free_frames.clear();
+
+		m_stop_time = Time::get_time();
+		m_recording = false;
+
+		if (m_lost_frames > 0)
+			FRACTAL_LOG_ERROR("Video capture lost %d frames during readback", (int)m_lost_frames);
+		if (m_write_failures > 0)
+			FRACTAL_LOG_ERROR("Video capture failed to write %d frames to '%s'", (int)m_write_failures, m_settings.path.c_str());
+
+		CaptureStatistics statistics = get_statistics();
+		FRACTAL_LOG("Video capture wrote %d frames at %.1f fps, %.1f MB/s", (int)statistics.frames_written, statistics.frames_per_second, statistics.megabytes_per_second);
+	}
+
+	CaptureStatistics VideoCapture::get_statistics() const {
+		CaptureStatistics statistics;
+		statistics.frames_captured = m_next_capture;
+		statistics.frames_written = m_frames_written;
+		statistics.bytes_written = m_bytes_written;
+		statistics.frames_lost = m_lost_frames;
+		statistics.write_failures = m_write_failures;
+		statistics.elapsed = (m_recording ? Time::get_time() : m_stop_time) - m_start_time;
+
+		if (statistics.elapsed > 0.0f) {
+			statistics.frames_per_second = statistics.frames_written / statistics.elapsed;
+			statistics.megabytes_per_second = (statistics.bytes_written / (1024.0f * 1024.0f)) / statistics.elapsed;
+		}
+
+		return statistics;
+	}
+
+	void VideoCapture::collect(bool wait_for_oldest) {
+		while (!m_pending.empty()) {
+			PendingFrame& frame = m_pending.front();
+
+			ReadbackStatus status = wait_for_oldest ? m_readback->wait(frame.ticket, CAPTURE_WAIT_TIMEOUT) : m_readback->poll(frame.ticket);
+			if (status == ReadbackStatus::Pending) {
+				if (wait_for_oldest)
+					continue;
+				break;
+			}
+
+			ReadbackResult result;
+			if (status == ReadbackStatus::Ready && m_readback->map(frame.ticket, result))
+				queue_frame(result, frame.index);
+			else {
+				FRACTAL_LOG_ERROR("Video capture lost frame %d", (int)frame.index);
+				m_lost_frames++;
+				queue_frame(ReadbackResult(), frame.index);
+			}
+
+			m_readback->release(frame.ticket);
+			m_pending.pop_front();
+			wait_for_oldest = false;
+		}
+	}
+
+	void VideoCapture::queue_frame(const ReadbackResult& result, uint64_t index) {
+		std::vector<uint8_t>* pixels = nullptr;
+		{
+			//Bound the amount of frames waiting on the encoder instead of dropping any.
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this] { return m_queued < m_settings.max_queued_frames; });
+			m_queued++;
+
+			if (!m_free_frames.empty()) {
+				pixels = m_free_frames.back();
+				m_free_frames.pop_back();
+			}
+		}
+
+		if (!pixels)
+			pixels = new std::vector<uint8_t>();
+
+		if (result.data) {
+			//GL rows start at the bottom, flip them while copying out of the mapped buffer.
+			pixels->resize((size_t)result.stride * result.height);
+			const uint8_t* source = (const uint8_t*)result.data;
+			for (uint32_t y = 0; y < result.height; y++)
+				memcpy(pixels->data() + (size_t)y * result.stride, source + (size_t)(result.height - 1 - y) * result.stride, result.stride);
+		}
+		else
+			pixels->clear();
+
+		if (m_settings.format == CaptureFormat::Y4M)
+			m_workers->submit([this, pixels, index] { encode_y4m(pixels, index); });
+		else
+			m_workers->submit([this, pixels, index] { encode_png(pixels, index); });
+	}
+
+	void VideoCapture::encode_y4m(std::vector<uint8_t>* pixels, uint64_t index) {
+		const uint32_t width = m_settings.width;
+		const uint32_t height = m_settings.height;
+		const uint32_t chroma_width = (width + 1) / 2;
+		const uint32_t chroma_height = (height + 1) / 2;
+
+		std::vector<uint8_t> planes;
+		if (!pixels->empty()) {
+			planes.resize((size_t)width * height + 2 * (size_t)chroma_width * chroma_height);
+			uint8_t* y_plane = planes.data();
+			uint8_t* u_plane = y_plane + (size_t)width * height;
+			uint8_t* v_plane = u_plane + (size_t)chroma_width * chroma_height;
+			const uint8_t* rgba = pixels->data();
+
+			for (uint32_t y = 0; y < height; y++) {
+				const uint8_t* row = rgba + (size_t)y * width * 4;
+				for (uint32_t x = 0; x < width; x++)
+					y_plane[(size_t)y * width + x] = (uint8_t)((77 * row[x * 4] + 150 * row[x * 4 + 1] + 29 * row[x * 4 + 2] + 128) >> 8);
+			}
+
+			//Full range BT.601 chroma, averaged over each 2x2 block.
+			for (uint32_t cy = 0; cy < chroma_height; cy++) {
+				for (uint32_t cx = 0; cx < chroma_width; cx++) {
+					int r = 0, g = 0, b = 0, count = 0;
+					for (uint32_t dy = 0; dy < 2; dy++) {
+						for (uint32_t dx = 0; dx < 2; dx++) {
+							uint32_t px = cx * 2 + dx, py = cy * 2 + dy;
+							if (px >= width || py >= height)
+								continue;
+							const uint8_t* p = rgba + ((size_t)py * width + px) * 4;
+							r += p[0]; g += p[1]; b += p[2];
+							count++;
+						}
+					}
+					r /= count; g /= count; b /= count;
+
+					u_plane[(size_t)cy * chroma_width + cx] = (uint8_t)((-43 * r - 85 * g + 128 * b + 32768 + 128) >> 8);
+					v_plane[(size_t)cy * chroma_width + cx] = (uint8_t)((128 * r - 107 * g - 21 * b + 32768 + 128) >> 8);
+				}
+			}
+		}
+
+		recycle(pixels);
+
+		//Frames are converted in parallel but must reach the stream in order.
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_condition.wait(lock, [this, index] { return m_next_write == index; });
+
+		//A lost frame was already counted in collect(), it still advances the write order.
+		if (!planes.empty()) {
+			size_t written = fwrite("FRAME\n", 1, 6, m_file);
+			written += fwrite(planes.data(), 1, planes.size(), m_file);
+			m_bytes_written += written;
+			if (written == planes.size() + 6)
+				m_frames_written++;
+			else
+				m_write_failures++;
+		}
+
+		m_next_write++;
+		m_condition.notify_all();
+	}
+
+	static void png_write_callback(void* context, void* data, int size) {
+		std::vector<uint8_t>* output = (std::vector<uint8_t>*)context;
+		output->insert(output->end(), (uint8_t*)data, (uint8_t*)data + size);
+	}
+
+	void VideoCapture::encode_png(std::vector<uint8_t>* pixels, uint64_t index) {
+		if (!pixels->empty()) {
+			std::vector<uint8_t> encoded;
+			stbi_write_png_to_func(png_write_callback, &encoded, m_settings.width, m_settings.height, 4, pixels->data(), m_settings.width * 4);
+
+			char file_path[512];
+			snprintf(file_path, sizeof(file_path), "%s_%06llu.png", m_settings.path.c_str(), (unsigned long long)index);
+
+			FILE* file = fopen(file_path, "wb");
+			if (file) {
+				size_t written = fwrite(encoded.data(), 1, encoded.size(), file);
+				m_bytes_written += written;
+				if (fclose(file) == 0 && written == encoded.size() && !encoded.empty())
+					m_frames_written++;
+				else
+					m_write_failures++;
+			}
+			else
+				m_write_failures++;
+		}
+
+		recycle(pixels);
+	}
+
+	void VideoCapture::recycle(std::vector<uint8_t>* pixels) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_free_frames.push_back(pixels);
+		m_queued--;
+		m_condition.notify_all();
+	}
+}
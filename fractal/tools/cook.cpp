@@ -0,0 +1,474 @@
+/**
+ * @file cook.cpp
+ * @author strah19
+ * @date October 19 2026
+ * @version 1.0
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the MIT License as
+ * published by the Free Software Foundation.
+ *
+ * @section DESCRIPTION
+ *
+ * This file contains fractal_cook, the offline asset cooker. It walks a
+ * resource directory, converts every asset it understands into its runtime
+ * form and writes the results into a single asset pack. Cooked assets are
+ * cached by content hash so unchanged inputs are skipped.
+ */
+
+#include "asset_pack.h"
+#include "texture_compression.h"
+#include "model.h"
+#include "thread_pool.h"
+#include "file.h"
+#include "log.h"
+#include "stb_image.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace Fractal;
+
+constexpr uint32_t COOK_VERSION = 2;
+
+struct CookSettings {
+	std::string input;
+	std::string output;
+	std::string root;
+	std::string cache = "cook_cache";
+	bool compress = false;
+	bool force = false;
+	uint32_t threads = 0;
+};
+
+enum class CookType {
+	Texture,
+	Shader,
+	Mesh
+};
+
+struct CookJob {
+	std::string path;
+	std::string name;
+	CookType type;
+	uint64_t hash = 0;
+	std::string cache_path;
+	bool cached = false;
+	bool deferred = false;
+	bool failed = false;
+	std::string message;
+};
+
+static bool read_file(const std::string& path, std::string& data) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	std::stringstream stream;
+	stream << file.rdbuf();
+	data = stream.str();
+	return true;
+}
+
+static uint64_t hash_bytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+	const uint8_t* bytes = (const uint8_t*)data;
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+static std::string to_hex(uint64_t value) {
+	char buffer[17];
+	snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)value);
+	return buffer;
+}
+
+static bool get_cook_type(const std::string& path, CookType& type) {
+	std::string extension = path.substr(path.find_last_of('.') + 1);
+	std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+	if (extension == "png" || extension == "jpg" || extension == "jpeg" || extension == "tga" || extension == "bmp")
+		type = CookType::Texture;
+	else if (extension == "glsl")
+		type = CookType::Shader;
+	else if (extension == "obj" || extension == "gltf" || extension == "glb")
+		type = CookType::Mesh;
+	else
+		return false;
+	return true;
+}
+
+static bool cook_texture(const CookJob& job, const CookSettings& settings, TextureImage& image, std::string& message) {
+	int w, h, channels;
+	stbi_set_flip_vertically_on_load_thread(1);
+	stbi_uc* pixels = stbi_load(job.path.c_str(), &w, &h, &channels, 4);
+	if (!pixels) {
+		message = stbi_failure_reason();
+		return false;
+	}
+
+	bool cooked = true;
+	if (settings.compress)
+		cooked = compress_image(pixels, w, h, channels == 2 || channels == 4, true, image);
+	else
+		build_mip_chain(pixels, w, h, image);
+
+	stbi_image_free(pixels);
+	return cooked;
+}
+
+static std::string strip_comments(const std::string& line, bool& in_block) {
+	std::string result;
+	for (size_t i = 0; i < line.size(); i++) {
+		if (in_block) {
+			if (line.compare(i, 2, "*/") == 0) {
+				in_block = false;
+				i++;
+			}
+		}
+		else if (line.compare(i, 2, "/*") == 0) {
+			in_block = true;
+			i++;
+		}
+		else if (line.compare(i, 2, "//") == 0)
+			break;
+		else
+			result += line[i];
+	}
+
+	result.erase(result.find_last_not_of(" \t\r") + 1);
+	return result;
+}
+
+static bool cook_shader(const CookJob& job, std::string& output, std::string& message) {
+	static const char* STAGES[] = { "vertex", "fragment", "geometry", "tess-control", "tess-eval" };
+
+	std::string source;
+	if (!read_file(job.path, source)) {
+		message = "could not be read";
+		return false;
+	}
+
+	std::istringstream stream(source);
+	std::string line;
+	std::string stage;
+	std::vector<std::string> stages;
+	bool in_block = false, has_version = false;
+	int depth = 0;
+	uint32_t line_number = 0;
+
+	auto finish_stage = [&]() {
+		if (stage.empty())
+			return true;
+		if (!has_version)
+			message = "'" + stage + "' stage has no #version";
+		else if (depth != 0)
+			message = "'" + stage + "' stage has unbalanced braces";
+		return has_version && depth == 0;
+	};
+
+	while (getline(stream, line)) {
+		line_number++;
+		std::string code = strip_comments(line, in_block);
+
+		if (code.find("#shader") != std::string::npos) {
+			if (!finish_stage())
+				return false;
+
+			stage.clear();
+			for (const char* name : STAGES) {
+				if (code.find(name) != std::string::npos)
+					stage = name;
+			}
+
+			if (stage.empty() || std::find(stages.begin(), stages.end(), stage) != stages.end()) {
+				message = "line " + std::to_string(line_number) + ": unknown or repeated stage '" + code + "'";
+				return false;
+			}
+
+			stages.push_back(stage);
+			has_version = false;
+			depth = 0;
+			output += "#shader " + stage + '\n';
+			continue;
+		}
+
+		if (stage.empty()) {
+			if (code.find_first_not_of(" \t") != std::string::npos) {
+				message = "line " + std::to_string(line_number) + ": code before the first #shader section";
+				return false;
+			}
+			continue;
+		}
+
+		if (code.find("#version") != std::string::npos)
+			has_version = true;
+		depth += (int)std::count(code.begin(), code.end(), '{') - (int)std::count(code.begin(), code.end(), '}');
+
+		//Keep empty lines so compiler errors still point at the original line.
+		output += code + '\n';
+	}
+
+	if (!finish_stage())
+		return false;
+
+	if (std::find(stages.begin(), stages.end(), "vertex") == stages.end() || std::find(stages.begin(), stages.end(), "fragment") == stages.end()) {
+		message = "needs both a vertex and a fragment stage";
+		return false;
+	}
+	return true;
+}
+
+static void cook(CookJob& job, const CookSettings& settings) {
+	std::string data;
+	if (!read_file(job.path, data)) {
+		job.failed = true;
+		job.message = "could not be read";
+		return;
+	}
+
+	//The key covers the content, the cook settings and the cooker itself.
+	uint64_t key[3] = { COOK_VERSION, (uint64_t)job.type, (uint64_t)settings.compress };
+	job.hash = hash_bytes(data.data(), data.size(), hash_bytes(key, sizeof(key)));
+
+	//Text glTF files keep their geometry in companion .bin buffers next to them.
+	if (job.path.size() > 5 && job.path.compare(job.path.size() - 5, 5, ".gltf") == 0) {
+		size_t slash = job.path.find_last_of("/\\");
+		std::vector<std::string> files = list_directory((slash == std::string::npos) ? "." : job.path.substr(0, slash), false);
+		std::sort(files.begin(), files.end());
+		for (const std::string& file : files) {
+			std::string buffer;
+			if (file.size() > 4 && file.compare(file.size() - 4, 4, ".bin") == 0 && read_file(file, buffer))
+				job.hash = hash_bytes(buffer.data(), buffer.size(), job.hash);
+		}
+	}
+	job.cache_path = settings.cache + "/" + to_hex(job.hash) + ".fpak";
+
+	if (!settings.force && file_exists(job.cache_path)) {
+		job.cached = true;
+		return;
+	}
+
+	//Mesh imports are already parallel and log as they go, they run on the main thread.
+	if (job.type == CookType::Mesh) {
+		job.deferred = true;
+		return;
+	}
+
+	AssetPackWriter writer(false);
+	if (job.type == CookType::Texture) {
+		TextureImage image;
+		job.failed = !cook_texture(job, settings, image, job.message);
+		if (!job.failed)
+			writer.add_texture(job.name, image);
+	}
+	else {
+		std::string source;
+		job.failed = !cook_shader(job, source, job.message);
+		if (!job.failed)
+			writer.add_shader(job.name, source);
+	}
+
+	if (!job.failed && !writer.write(job.cache_path)) {
+		job.failed = true;
+		job.message = "could not write " + job.cache_path;
+	}
+}
+
+static bool add_cooked(AssetPackWriter& writer, const CookJob& job) {
+	AssetPack cached;
+	if (!cached.open(job.cache_path) || cached.get_entry_count() != 1)
+		return false;
+
+	const AssetPackEntry& entry = cached.get_entries()[0];
+	if (entry.type == AssetPackType::Texture) {
+		TextureImage image;
+		if (!cached.read_texture(entry, image))
+			return false;
+		writer.add_texture(job.name, image);
+	}
+	else if (entry.type == AssetPackType::Mesh) {
+		Model model;
+		if (!cached.read_mesh(entry, model))
+			return false;
+		writer.add_mesh(job.name, model);
+	}
+	else {
+		std::string text;
+		if (!cached.read_text(entry, text))
+			return false;
+		writer.add_shader(job.name, text);
+	}
+	return true;
+}
+
+static std::string build_manifest(const std::vector<CookJob>& jobs) {
+	std::string manifest;
+	for (const CookJob& job : jobs)
+		manifest += to_hex(job.hash) + " " + job.name + "\n";
+	return manifest;
+}
+
+static void print_usage() {
+	printf("Usage: fractal_cook <input directory> <output pack> [options]\n");
+	printf("  --root <directory>   Directory asset names are relative to (default: parent of input)\n");
+	printf("  --cache <directory>  Directory for cooked asset cache (default: cook_cache)\n");
+	printf("  --compress           Block compress textures to BC1/BC3\n");
+	printf("  --threads <count>    Worker thread count (default: all cores)\n");
+	printf("  --force              Ignore the cache and cook everything\n");
+}
+
+static bool parse_arguments(int argc, char* argv[], CookSettings& settings) {
+	std::vector<std::string> positional;
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+		if (argument == "--root" && i + 1 < argc)
+			settings.root = argv[++i];
+		else if (argument == "--cache" && i + 1 < argc)
+			settings.cache = argv[++i];
+		else if (argument == "--threads" && i + 1 < argc)
+			settings.threads = (uint32_t)std::max(atoi(argv[++i]), 0);
+		else if (argument == "--compress")
+			settings.compress = true;
+		else if (argument == "--force")
+			settings.force = true;
+		else if (argument.compare(0, 2, "--") == 0)
+			return false;
+		else
+			positional.push_back(argument);
+	}
+
+	if (positional.size() != 2)
+		return false;
+
+	settings.input = normalize_asset_name(positional[0]);
+	settings.output = positional[1];
+	while (!settings.input.empty() && settings.input.back() == '/')
+		settings.input.pop_back();
+
+	if (settings.root.empty()) {
+		size_t slash = settings.input.find_last_of('/');
+		settings.root = (slash == std::string::npos) ? "" : settings.input.substr(0, slash);
+	}
+	else
+		settings.root = normalize_asset_name(settings.root);
+	while (!settings.root.empty() && settings.root.back() == '/')
+		settings.root.pop_back();
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+	CookSettings settings;
+	if (!parse_arguments(argc, argv, settings)) {
+		print_usage();
+		return 1;
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	std::vector<CookJob> jobs;
+	for (const std::string& file : list_directory(settings.input)) {
+		CookJob job;
+		if (!get_cook_type(file, job.type))
+			continue;
+
+		job.path = file;
+		std::string name = normalize_asset_name(file);
+		job.name = (!settings.root.empty() && name.compare(0, settings.root.size() + 1, settings.root + "/") == 0) ? name.substr(settings.root.size() + 1) : name;
+		jobs.push_back(job);
+	}
+
+	if (jobs.empty()) {
+		FRACTAL_LOG_ERROR("No assets found in '%s'", settings.input.c_str());
+		return 1;
+	}
+
+	if (!create_directory(settings.cache)) {
+		FRACTAL_LOG_ERROR("Could not create cache directory '%s'", settings.cache.c_str());
+		return 1;
+	}
+
+	std::sort(jobs.begin(), jobs.end(), [](const CookJob& a, const CookJob& b) { return a.name < b.name; });
+
+	{
+		ThreadPool pool(settings.threads);
+		for (CookJob& job : jobs)
+			pool.submit([&job, &settings] { cook(job, settings); });
+		pool.wait_idle();
+
+		ModelImportSettings import_settings;
+		import_settings.thread_pool = &pool;
+		for (CookJob& job : jobs) {
+			if (!job.deferred)
+				continue;
+
+			Model model;
+			AssetPackWriter writer(false);
+			//Cooking reads the source files, a cooked build would only look in the packs it is building.
+			if (!import_model(job.path, model, import_settings)) {
+				job.failed = true;
+				job.message = "could not be imported";
+				continue;
+			}
+
+			writer.add_mesh(job.name, model);
+			if (!writer.write(job.cache_path)) {
+				job.failed = true;
+				job.message = "could not write " + job.cache_path;
+			}
+		}
+	}
+
+	uint32_t failed = 0, cached = 0;
+	for (const CookJob& job : jobs) {
+		if (job.failed) {
+			FRACTAL_LOG_ERROR("%s: %s", job.path.c_str(), job.message.c_str());
+			failed++;
+		}
+		else if (job.cached)
+			cached++;
+		else
+			FRACTAL_LOG("Cooked %s", job.name.c_str());
+	}
+
+	if (failed) {
+		FRACTAL_LOG_ERROR("%d of %d assets failed to cook", failed, (uint32_t)jobs.size());
+		return 1;
+	}
+
+	std::string manifest = build_manifest(jobs);
+	std::string manifest_path = settings.output + ".manifest";
+	std::string previous;
+	if (!settings.force && file_exists(settings.output) && read_file(manifest_path, previous) && previous == manifest) {
+		FRACTAL_LOG_GOOD("'%s' is up to date (%d assets)", settings.output.c_str(), (uint32_t)jobs.size());
+		return 0;
+	}
+
+	AssetPackWriter writer;
+	for (const CookJob& job : jobs) {
+		if (!add_cooked(writer, job)) {
+			FRACTAL_LOG_ERROR("Cached asset '%s' for '%s' is unreadable, run again with --force", job.cache_path.c_str(), job.name.c_str());
+			return 1;
+		}
+	}
+
+	if (!writer.write(settings.output))
+		return 1;
+
+	std::ofstream manifest_file(manifest_path, std::ios::binary | std::ios::trunc);
+	manifest_file << manifest;
+
+	float seconds = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - start).count();
+	FRACTAL_LOG_GOOD("Wrote '%s': %d assets (%d cached), %.2f MB -> %.2f MB in %.2f s", settings.output.c_str(), (uint32_t)jobs.size(), cached,
+		writer.get_original_size() / (1024.0f * 1024.0f), writer.get_stored_size() / (1024.0f * 1024.0f), seconds);
+	return 0;
+}
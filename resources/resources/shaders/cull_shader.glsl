@@ -0,0 +1,133 @@
+#shader compute
+#version 450 core
+
+layout(local_size_x = 64) in;
+
+struct DrawCommand
+{
+	uint count;
+	uint instance_count;
+	uint first_index;
+	uint base_vertex;
+	uint base_instance;
+};
+
+struct Bounds
+{
+	vec4 min;
+	vec4 max;
+};
+
+layout(binding = 0) buffer GlobalMatrices 
+{
+    mat4 proj_view;
+};
+
+layout(std430, binding = 1) buffer Commands
+{
+	DrawCommand commands[];
+};
+
+layout(std430, binding = 2) readonly buffer CommandBounds
+{
+	Bounds bounds[];
+};
+
+layout(std430, binding = 3) buffer Visibility
+{
+	uint visibility[];
+};
+
+layout(std430, binding = 4) buffer Counters
+{
+	uint tested;
+	uint visible;
+	uint occluded;
+	uint late_visible;
+};
+
+layout(binding = 32) uniform sampler2D u_pyramid;
+
+uniform int u_phase;
+uniform int u_count;
+uniform int u_pyramid_valid;
+uniform int u_pyramid_levels;
+uniform vec2 u_pyramid_size;
+
+bool is_visible(Bounds box)
+{
+	if (box.min.x > box.max.x)
+		return true;
+
+	vec3 ndc_min = vec3(1.0);
+	vec3 ndc_max = vec3(-1.0);
+	for (int i = 0; i < 8; i++) {
+		vec3 corner = vec3((i & 1) != 0 ? box.max.x : box.min.x, (i & 2) != 0 ? box.max.y : box.min.y, (i & 4) != 0 ? box.max.z : box.min.z);
+		vec4 clip = proj_view * vec4(corner, 1.0);
+		// Crosses the near plane, too close to cull safely.
+		if (clip.w <= 0.0)
+			return true;
+
+		vec3 ndc = clip.xyz / clip.w;
+		ndc_min = min(ndc_min, ndc);
+		ndc_max = max(ndc_max, ndc);
+	}
+
+	if (ndc_max.x < -1.0 || ndc_min.x > 1.0 || ndc_max.y < -1.0 || ndc_min.y > 1.0 || ndc_min.z > 1.0)
+		return false;
+	if (u_pyramid_valid == 0)
+		return true;
+
+	vec2 pixel_min = clamp(ndc_min.xy * 0.5 + 0.5, 0.0, 1.0) * u_pyramid_size;
+	vec2 pixel_max = clamp(ndc_max.xy * 0.5 + 0.5, 0.0, 1.0) * u_pyramid_size;
+	vec2 extent = pixel_max - pixel_min;
+
+	// The level where the box covers at most two texels in each direction.
+	int level = clamp(int(ceil(log2(max(max(extent.x, extent.y), 1.0)))), 0, u_pyramid_levels - 1);
+	ivec2 level_size = max(ivec2(u_pyramid_size) >> level, ivec2(1));
+	ivec2 first = min(ivec2(pixel_min) >> level, level_size - 1);
+	ivec2 last = min(ivec2(pixel_max) >> level, level_size - 1);
+
+	float depth = 0.0;
+	for (int y = first.y; y <= last.y; y++)
+		for (int x = first.x; x <= last.x; x++)
+			depth = max(depth, texelFetch(u_pyramid, ivec2(x, y), level).r);
+
+	return (ndc_min.z * 0.5 + 0.5) <= depth;
+}
+
+void main()
+{
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= uint(u_count))
+		return;
+
+	if (commands[index].count == 0u) {
+		commands[index].instance_count = 0u;
+		visibility[index] = 1u;
+		return;
+	}
+
+	if (u_phase == 0) {
+		bool early = is_visible(bounds[index]);
+		visibility[index] = early ? 1u : 0u;
+		commands[index].instance_count = early ? 1u : 0u;
+		atomicAdd(tested, 1u);
+		if (early)
+			atomicAdd(visible, 1u);
+		return;
+	}
+
+	// Drawn in the early phase already, only the culled ones are tested again.
+	if (visibility[index] != 0u) {
+		commands[index].instance_count = 0u;
+		return;
+	}
+
+	bool late = is_visible(bounds[index]);
+	commands[index].instance_count = late ? 1u : 0u;
+	if (late)
+		atomicAdd(late_visible, 1u);
+	else
+		atomicAdd(occluded, 1u);
+}
@@ -1,6 +1,9 @@
 #shader vertex
 #version 450 core
 
+// The depth pre-pass and the main pass must produce bit identical depth.
+invariant gl_Position;
+
 layout (location = 0) in vec3 pos;
 layout (location = 1) in vec4 color;
 layout(location = 2) in vec2 tex_coord;
@@ -0,0 +1,24 @@
+#shader vertex
+#version 450 core
+
+// The depth pre-pass and the main pass must produce bit identical depth.
+invariant gl_Position;
+
+layout (location = 0) in vec3 pos;
+
+layout(binding = 0) buffer GlobalMatrices 
+{
+    mat4 proj_view;
+};
+
+void main()
+{
+	gl_Position = proj_view * vec4(pos, 1.0);
+}
+
+#shader fragment
+#version 450 core
+
+void main()
+{
+}
@@ -0,0 +1,41 @@
+#shader compute
+#version 450 core
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(binding = 32) uniform sampler2D u_depth;
+layout(r32f, binding = 0) readonly uniform image2D u_source;
+layout(r32f, binding = 1) writeonly uniform image2D u_destination;
+
+uniform int u_level;
+uniform vec2 u_offset;
+uniform vec2 u_source_size;
+uniform vec2 u_destination_size;
+
+void main()
+{
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+	ivec2 size = ivec2(u_destination_size);
+	if (texel.x >= size.x || texel.y >= size.y)
+		return;
+
+	if (u_level == 0) {
+		imageStore(u_destination, texel, vec4(texelFetch(u_depth, texel + ivec2(u_offset), 0).r));
+		return;
+	}
+
+	// Odd sources fold their last row and column into the last texel so no depth is skipped.
+	ivec2 source_size = ivec2(u_source_size);
+	ivec2 first = texel * 2;
+	ivec2 last = min(first + 1, source_size - 1);
+	if (texel.x == size.x - 1)
+		last.x = source_size.x - 1;
+	if (texel.y == size.y - 1)
+		last.y = source_size.y - 1;
+
+	float depth = 0.0;
+	for (int y = first.y; y <= last.y; y++)
+		for (int x = first.x; x <= last.x; x++)
+			depth = max(depth, imageLoad(u_source, ivec2(x, y)).r);
+	imageStore(u_destination, texel, vec4(depth));
+}
@@ -0,0 +1,27 @@
+#shader vertex
+#version 450 core
+
+layout (location = 0) in vec3 pos;
+layout (location = 1) in int object_id;
+
+uniform mat4 u_proj_view;
+
+flat out uint v_object_id;
+
+void main()
+{
+	v_object_id = uint(object_id);
+	gl_Position = u_proj_view * vec4(pos, 1.0);
+}
+
+#shader fragment
+#version 450 core
+
+flat in uint v_object_id;
+
+layout (location = 0) out uint id;
+
+void main()
+{
+	id = v_object_id;
+}
@@ -0,0 +1,61 @@
+#shader vertex
+#version 450 core
+
+uniform vec2 u_uv_scale;
+
+out vec2 out_tex_coord;
+
+void main()
+{
+	// Single triangle covering the screen, generated from the vertex id.
+	vec2 uv = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	out_tex_coord = uv * u_uv_scale;
+	gl_Position = vec4(uv * 2.0 - 1.0, 0.0, 1.0);
+}
+
+#shader fragment
+#version 450 core
+
+out vec4 frag_color;
+
+in vec2 out_tex_coord;
+
+layout(binding = 0) uniform sampler2D u_source;
+uniform int u_filter;
+uniform float u_sharpness;
+uniform vec2 u_uv_clamp;
+uniform vec2 u_texel_size;
+
+vec3 fetch(vec2 uv)
+{
+	// Both edges are clamped, the taps past the left and bottom edge would otherwise wrap around.
+	return texture(u_source, clamp(uv, u_texel_size * 0.5, u_uv_clamp)).rgb;
+}
+
+void main()
+{
+	vec3 center = fetch(out_tex_coord);
+
+	if (u_filter == 0) {
+		frag_color = vec4(center, 1.0);
+		return;
+	}
+
+	// Contrast adaptive sharpening on the cross neighbourhood.
+	vec3 north = fetch(out_tex_coord + vec2(0.0, u_texel_size.y));
+	vec3 south = fetch(out_tex_coord - vec2(0.0, u_texel_size.y));
+	vec3 east = fetch(out_tex_coord + vec2(u_texel_size.x, 0.0));
+	vec3 west = fetch(out_tex_coord - vec2(u_texel_size.x, 0.0));
+
+	vec3 min_rgb = min(center, min(min(north, south), min(east, west)));
+	vec3 max_rgb = max(center, max(max(north, south), max(east, west)));
+
+	vec3 amplitude = clamp(min(min_rgb, 1.0 - max_rgb) / max(max_rgb, 1e-5), 0.0, 1.0);
+	amplitude = sqrt(amplitude);
+
+	float peak = -1.0 / mix(8.0, 5.0, clamp(u_sharpness, 0.0, 1.0));
+	vec3 weight = amplitude * peak;
+
+	vec3 color = (center + (north + south + east + west) * weight) / (1.0 + 4.0 * weight);
+	frag_color = vec4(clamp(color, 0.0, 1.0), 1.0);
+}
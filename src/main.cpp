@@ -8,6 +8,7 @@
 
 #define WINDOW_WIDTH 1200
 #define WINDOW_HEIGHT 800
+#define MAX_TRAJECTORY_POINTS 1000
 
 class Sandbox : public Fractal::Application {
 public:
@@ -17,25 +18,77 @@ public:
         renderer = new Fractal::Renderer;
 		Fractal::set_renderer(renderer);
 
-        texture = new Fractal::Texture();
-        texture->initialize("resources/texture.png");
+        texture_loader = new Fractal::TextureLoader;
+        Fractal::AssetManagerSettings asset_settings;
+        asset_settings.texture_loader = texture_loader;
+        assets = new Fractal::AssetManager(asset_settings);
+        texture = assets->load_texture("resources/texture.png");
+
+        dynamic_resolution = new Fractal::DynamicResolution;
+        picking = new Fractal::PickingPass;
+        Fractal::set_gpu_memory_budget(512ull * 1024 * 1024);
+
+        projectile = world.create();
+        world.add<Fractal::Transform>(projectile);
+        world.add<Fractal::Velocity>(projectile);
+        world.add<Fractal::Renderable>(projectile);
+        world.add<Fractal::PreviousTransform>(projectile);
+
+        systems.add("History", Fractal::get_previous_transform_access(), Fractal::store_previous_transforms);
+        systems.add("Motion", Fractal::get_motion_access(), Fractal::update_motion);
+        systems.add("Ground", Fractal::SystemAccess().write<Fractal::Transform>().write<Fractal::Velocity>(), land);
+        systems.add("Trajectory", Fractal::SystemAccess().read<Fractal::Transform>().exclusive(), [this](Fractal::World&, float) {
+            record_trajectory();
+        });
+
+        //The trajectory system creates entities, so the ticks stay on the main thread.
+        enable_fixed_timestep(timestep_settings);
     }
 
-    void on_update() {
-        camera.update();
+    void on_fixed_update(float step) {
+        systems.run(world, step, get_job_system());
+    }
 
-        if (p.y > 0) {
-            p.x = i_p.x + (i_v.x * t);
-            p.y = i_p.y + (i_v.y * t) + (.5 * g * (t * t));
-            p.z = i_p.z + (i_v.z * t);
-            
-            if (p.x - p_delta.x > .005 || p.y - p_delta.y > .005 || p.z - p_delta.z > .005) {
-                p_delta = p;
-                if (traj_index < 1000)
-                    trajectory_points[traj_index++] = p;
+    static void land(Fractal::World& world, float delta) {
+        world.each<Fractal::Transform, Fractal::Velocity>([](Fractal::Entity, Fractal::Transform& transform, Fractal::Velocity& velocity) {
+            if (transform.position.y <= 0 && (velocity.linear.y < 0 || velocity.acceleration.y < 0)) {
+                transform.position.y = 0;
+                velocity.linear = glm::vec3(0);
+                velocity.acceleration = glm::vec3(0);
             }
+        });
+    }
+
+    void record_trajectory() {
+        glm::vec3 p = world.get<Fractal::Transform>(projectile)->position;
+        if (p.y <= 0 || trajectory.size() >= MAX_TRAJECTORY_POINTS)
+            return;
+
+        if (p.x - p_delta.x > .005 || p.y - p_delta.y > .005 || p.z - p_delta.z > .005) {
+            p_delta = p;
+            Fractal::BoundingBox bounds;
+            bounds.expand(p - glm::vec3(.03f));
+            bounds.expand(p + glm::vec3(.03f));
+            scene_index.insert(bounds);
+
+            Fractal::Entity point = world.create();
+            world.add<Fractal::Transform>(point, p, glm::vec3(.03f));
+            //Drawn after culling the scene index instead of by render_entities.
+            world.add<Fractal::Renderable>(point, Fractal::RenderableShape::Cube, glm::vec4(1, 0, 0, 1), 0u, nullptr, false);
+            trajectory.push_back(point);
         }
+    }
+
+    void on_update() {
+        assets->begin_frame();
+        texture_loader->update(2.0f);
+        camera.update();
+
+        if (!is_fixed_timestep())
+            systems.run(world, get_frame_time(), get_job_system());
+        world.get<Fractal::Renderable>(projectile)->texture = texture->get_texture_id();
 
+        dynamic_resolution->begin();
         Fractal::RendererCommands::clear(background_color.r, background_color.g, background_color.b, background_color.a);
 
 		renderer->begin_scene(&camera.get_camera());
@@ -45,8 +98,25 @@ public:
 
 
 		renderer->end_scene();
-        t += get_frame_time();
-        traj_timer = t;
+        dynamic_resolution->end();
+        pick_points();
+    }
+
+    void pick_points() {
+        picking->begin(&camera.get_camera());
+        for (uint32_t i : visible_points) {
+            Fractal::Vertex vertices[Fractal::CUBE_VERTEX_COUNT];
+            glm::mat4 model = world.get<Fractal::Transform>(trajectory[i])->get_matrix();
+            Fractal::Geometry::create_geometry(vertices, model, { 1, 0, 0, 1 }, -1.0f, Fractal::CUBE_TEX_COORDS, Fractal::CUBE_VERTEX_COUNT, Fractal::CUBE_POSITIONS);
+            picking->submit(vertices, Fractal::CUBE_VERTEX_COUNT, Fractal::cube_indices, Fractal::CUBE_INDICES_COUNT, i + 1);
+        }
+        picking->end();
+
+        if (!camera.get_mode())
+            picking->pick(Fractal::MousePositionEvent::GetMousePosition());
+        Fractal::PickingResult result;
+        while (picking->poll(result))
+            hovered_point = result.get_id();
     }
 
     void render_plane() {
@@ -54,9 +124,14 @@ public:
         Fractal::Cube::draw_cube({ 0, 0, 0 }, { line_thickness, WINDOW_HEIGHT, line_thickness }, { 0, 0, 0, 1 });
         Fractal::Cube::draw_cube({ 0, 0, 0 }, { line_thickness, line_thickness, WINDOW_HEIGHT }, { 0, 0, 0, 1 });
 
-        Fractal::Quad::draw_quad(p, { 1, 1 }, texture->get_texture_id());
-        for (int i = 0; i < traj_index; i++) {
-            Fractal::Cube::draw_cube(trajectory_points[i], { .03, .03, .03 }, {1, 0, 0, 1});
+        Fractal::render_entities(world, renderer, get_interpolation_alpha());
+        visible_points.clear();
+        renderer->cull(scene_index, visible_points);
+        for (uint32_t i : visible_points) {
+            Fractal::Renderable renderable = *world.get<Fractal::Renderable>(trajectory[i]);
+            if (i + 1 == hovered_point)
+                renderable.color = glm::vec4(1, 1, 0, 1);
+            Fractal::submit_renderable(renderer, *world.get<Fractal::Transform>(trajectory[i]), renderable);
         }
     }
 
@@ -73,16 +148,169 @@ public:
             ImGui::Separator();
             ImGui::SliderFloat3("Inital Position", &i_p[0], -100, 100);
             ImGui::SliderFloat3("Inital Velocity", &i_v[0], -20, 20);
+
+            ImGui::Separator();
+            if (!is_offline_rendering()) {
+                if (ImGui::Button("Record 10s (Y4M)")) {
+                    Fractal::OfflineRenderSettings settings;
+                    settings.capture.path = "capture.y4m";
+                    settings.capture.width = get_window()->properties()->m_width;
+                    settings.capture.height = get_window()->properties()->m_height;
+                    settings.frame_count = settings.capture.fps * 10;
+                    begin_offline_render(settings);
+                }
+            }
+            else {
+                Fractal::CaptureStatistics capture = get_video_capture()->get_statistics();
+                ImGui::Text("Recording: %d frames, %.1f fps, %.1f MB/s", (int)capture.frames_written, capture.frames_per_second, capture.megabytes_per_second);
+                if (ImGui::Button("Stop Recording"))
+                    end_offline_render();
+            }
             ImGui::End();
 
             ds_gui();
+            dynamic_resolution_gui();
+            allocation_gui();
+            gpu_memory_gui();
+        }
+    }
+
+    void gpu_memory_gui() {
+        Fractal::GpuMemoryStatistics gs = Fractal::get_gpu_memory_statistics();
+        const float mb = 1024.0f * 1024.0f;
+
+        ImGui::Begin("GPU Memory");
+        ImGui::Text("Tracked: %.2f MB (peak %.2f MB)", gs.total / mb, gs.peak / mb);
+        ImGui::Text("Pending Destructions: %d", Fractal::get_pending_gpu_destructions());
+        if (gs.budget > 0)
+            ImGui::ProgressBar((float)gs.total / (float)gs.budget, ImVec2(-1, 0), "Budget");
+        if (gs.driver_info) {
+            ImGui::Text("Driver: %.2f / %.2f MB available", gs.driver_available / mb, gs.driver_total / mb);
+            ImGui::Text("Untracked Growth: %.2f MB", gs.untracked / mb);
+        }
+        ImGui::Separator();
+        for (uint32_t i = 0; i < (uint32_t)Fractal::GpuMemoryCategory::Count; i++)
+            ImGui::Text("%s: %d (%.2f MB)", Fractal::get_gpu_memory_category_name((Fractal::GpuMemoryCategory)i), gs.category_counts[i], gs.category_bytes[i] / mb);
+        ImGui::Separator();
+        if (ImGui::TreeNode("Allocations")) {
+            for (const Fractal::GpuAllocation& allocation : Fractal::get_gpu_allocations())
+                ImGui::Text("%s %d '%s': %.2f KB", Fractal::get_gpu_memory_category_name(allocation.category), allocation.id, allocation.name.c_str(), allocation.size / 1024.0f);
+            ImGui::TreePop();
+        }
+        ImGui::End();
+    }
+
+    void allocation_gui() {
+        ImGui::Begin("Allocations");
+        if (!Fractal::is_allocation_tracking_enabled()) {
+            ImGui::Text("Build with FRACTAL_TRACK_ALLOCATIONS to track allocations.");
+            ImGui::End();
+            return;
         }
+
+        const Fractal::AllocationFrame& frame = Fractal::get_allocation_frame();
+        Fractal::AllocationCounters total = frame.get_total();
+        ImGui::Text("Frame %d: %d allocations, %.2f KB", (int)frame.frame, (int)total.allocations, total.bytes / 1024.0f);
+        ImGui::Text("No Allocation Violations: %d", (int)frame.violations);
+        ImGui::Separator();
+        ImGui::Columns(4);
+        ImGui::Text("Subsystem"); ImGui::NextColumn();
+        ImGui::Text("Allocations"); ImGui::NextColumn();
+        ImGui::Text("KB"); ImGui::NextColumn();
+        ImGui::Text("Frees"); ImGui::NextColumn();
+        for (uint32_t i = 0; i < (uint32_t)Fractal::AllocationTag::Count; i++) {
+            const Fractal::AllocationCounters& counters = frame.counters[i];
+            ImGui::Text("%s", Fractal::get_allocation_tag_name((Fractal::AllocationTag)i)); ImGui::NextColumn();
+            ImGui::Text("%d", (int)counters.allocations); ImGui::NextColumn();
+            ImGui::Text("%.2f", counters.bytes / 1024.0f); ImGui::NextColumn();
+            ImGui::Text("%d", (int)counters.frees); ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+        ImGui::Separator();
+
+        allocation_history.resize(Fractal::ALLOCATION_HISTORY_SIZE);
+        allocation_counts.resize(Fractal::ALLOCATION_HISTORY_SIZE);
+        uint32_t count = Fractal::get_allocation_history(allocation_history.data(), Fractal::ALLOCATION_HISTORY_SIZE);
+        for (uint32_t i = 0; i < count; i++)
+            allocation_counts[i] = (float)allocation_history[i].get_total().allocations;
+        ImGui::PlotLines("Allocations", allocation_counts.data(), (int)count, 0, nullptr, 0.0f, FLT_MAX, ImVec2(0, 60));
+
+        if (ImGui::Button("Dump CSV"))
+            Fractal::write_allocation_csv("allocations.csv");
+        ImGui::End();
+    }
+
+    void dynamic_resolution_gui() {
+        Fractal::DynamicResolutionSettings& settings = dynamic_resolution->settings();
+        bool enabled = dynamic_resolution->is_enabled();
+        int filter = (int)settings.filter;
+
+        ImGui::Begin("Dynamic Resolution");
+        if (ImGui::Checkbox("Enabled", &enabled))
+            dynamic_resolution->set_enabled(enabled);
+        ImGui::SliderFloat("Target GPU Time (ms)", &settings.target_frame_ms, 1.0f, 33.0f);
+        ImGui::SliderFloat("Min Scale", &settings.min_scale, 0.25f, 1.0f);
+        ImGui::Combo("Filter", &filter, "Bilinear\0Sharpen\0");
+        settings.filter = (Fractal::UpscaleFilter)filter;
+        ImGui::SliderFloat("Sharpness", &settings.sharpness, 0.0f, 1.0f);
+        ImGui::Separator();
+        ImGui::Text("Scale: %.2f (%d x %d)", dynamic_resolution->get_scale(), dynamic_resolution->get_render_width(), dynamic_resolution->get_render_height());
+        ImGui::Text("GPU Time: %.2f ms", dynamic_resolution->get_gpu_time());
+
+        const std::vector<float>& scales = dynamic_resolution->get_scale_history();
+        const std::vector<float>& times = dynamic_resolution->get_gpu_time_history();
+        ImGui::PlotLines("Scale", scales.data(), (int)scales.size(), dynamic_resolution->get_history_offset(), nullptr, 0.0f, 1.0f, ImVec2(0, 60));
+        ImGui::PlotLines("GPU Time", times.data(), (int)times.size(), dynamic_resolution->get_history_offset(), nullptr, 0.0f, settings.target_frame_ms * 2.0f, ImVec2(0, 60));
+        ImGui::End();
     }
 
     void ds_gui() {
         Fractal::DeviceStatistics ds = renderer->get_graphics_device()->get_device_stats();
 
         ImGui::Begin("Device Statistics");
+        bool depth_prepass = renderer->is_depth_prepass();
+        if (ImGui::Checkbox("Depth Pre-Pass", &depth_prepass))
+            renderer->set_depth_prepass(depth_prepass);
+        bool occlusion_culling = renderer->is_occlusion_culling();
+        if (ImGui::Checkbox("Occlusion Culling", &occlusion_culling))
+            renderer->set_occlusion_culling(occlusion_culling);
+        if (occlusion_culling) {
+            const Fractal::OcclusionStatistics& os = renderer->get_occlusion_statistics();
+            ImGui::Text("Tested: %d, Visible: %d, Late Visible: %d, Occluded: %d", os.tested, os.visible, os.late_visible, os.occluded);
+        }
+        Fractal::BvhStatistics bs = scene_index.get_statistics();
+        ImGui::Text("BVH: %d objects, %d nodes, %d visible", bs.object_count, bs.node_count, (int)visible_points.size());
+        ImGui::Text("BVH Queries: %d, %.3f ms, %d nodes visited", bs.queries, bs.query_ms, (int)bs.nodes_visited);
+        if (ImGui::Button("Rebuild BVH"))
+            scene_index.build();
+        ImGui::SameLine();
+        ImGui::Text("Build: %.3f ms, Refit: %.3f ms", bs.build_ms, bs.refit_ms);
+        scene_index.reset_query_statistics();
+        ImGui::Text("Entities: %d, System Batches: %d", (int)world.size(), systems.get_batch_count());
+        for (const Fractal::SystemStatistics& system : systems.get_statistics())
+            ImGui::Text("%s: %.3f ms (batch %d)", system.name.c_str(), system.ms, system.batch);
+        bool fixed = is_fixed_timestep();
+        bool changed = ImGui::Checkbox("Fixed Timestep", &fixed);
+        changed |= ImGui::SliderFloat("Tick Rate", &timestep_settings.tick_rate, 10.0f, 240.0f);
+        changed |= ImGui::SliderInt("Max Steps", (int*)&timestep_settings.max_steps, 1, 16);
+        if (changed) {
+            if (fixed)
+                enable_fixed_timestep(timestep_settings);
+            else
+                disable_fixed_timestep();
+        }
+        const Fractal::FixedTimestepStatistics& ts = get_fixed_timestep()->get_statistics();
+        ImGui::Text("Ticks: %d (%.3f ms), Alpha: %.2f", ts.steps, ts.tick_ms, ts.alpha);
+        ImGui::Text("Dropped: %.2f ms (%d frames)", ts.dropped_ms, (int)ts.dropped_frames);
+        const std::vector<Fractal::WorkerStatistics>& workers = get_job_system()->get_statistics();
+        for (uint32_t i = 0; i < (uint32_t)workers.size(); i++) {
+            char label[64];
+            snprintf(label, sizeof(label), "%s %d: %d jobs, %d steals", i == 0 ? "Main" : "Worker", i, workers[i].jobs, workers[i].steals);
+            ImGui::ProgressBar(workers[i].utilization, ImVec2(-1, 0), label);
+        }
+        const Fractal::PickingStatistics& ps = picking->get_statistics();
+        ImGui::SliderFloat("Picking Scale", &picking->settings().scale, 0.1f, 1.0f);
+        ImGui::Text("Hovered Point: %d (%d frames late, %d rejected)", (int)hovered_point - 1, ps.latency_frames, ps.rejected);
         ImGui::Separator();
         ImGui::Text("Draw Count: %d", ds.draw_count);
         ImGui::Separator();
@@ -92,13 +320,50 @@ public:
         ImGui::Text("Max Vertex Count: %d", ds.max_vertex_count);
         ImGui::Text("Max Index Count: %d", ds.max_index_count);
         ImGui::Separator();
+        for (uint32_t i = 0; i < Fractal::MAX_LOD_LEVELS; i++) {
+            if (ds.lod_objects[i] > 0)
+                ImGui::Text("LOD %d: %d objects, %d triangles", i, ds.lod_objects[i], ds.lod_triangles[i]);
+        }
+        ImGui::Separator();
+        Fractal::AssetStatistics as = assets->get_statistics();
+        ImGui::Text("Assets: %d (%d resident)", as.asset_count, as.resident_count);
+        ImGui::Text("Asset Memory: %.2f / %.2f MB", as.memory_used / (1024.0f * 1024.0f), as.memory_budget / (1024.0f * 1024.0f));
+        ImGui::Text("Loads: %d, Reloads: %d, Evictions: %d", as.loads, as.reloads, as.evictions);
+        ImGui::Separator();
+        Fractal::ArenaStatistics fs = Fractal::get_frame_arenas().get_previous().get_statistics();
+        ImGui::Text("Frame Arena: %.2f / %.2f KB", fs.used / 1024.0f, fs.capacity / 1024.0f);
+        ImGui::Text("Frame Allocations: %d (%d overflowed)", fs.allocations, fs.overflows);
+        ImGui::Separator();
         ImGui::Text("FPS: %d", get_fps());
+        const Fractal::FrameSyncStatistics& ss = get_frame_sync()->get_statistics();
+        ImGui::Text("GPU Wait: %.2f ms (average %.2f ms)", ss.wait_ms, ss.average_wait_ms);
+        ImGui::Text("Frames In Flight: %d, %s bound", ss.frames_in_flight, ss.gpu_bound ? "GPU" : "CPU");
+        ImGui::Separator();
+        Fractal::FramePacerSettings pacing = get_frame_pacer()->get_settings();
+        int vsync = (int)pacing.vsync;
+        bool paced = ImGui::Combo("Vsync", &vsync, "Off\0On\0Adaptive\0");
+        paced |= ImGui::SliderFloat("Frame Limit (0 = none)", &pacing.target_fps, 0.0f, 240.0f);
+        paced |= ImGui::Checkbox("Low Latency", &pacing.low_latency);
+        if (paced) {
+            pacing.vsync = (Fractal::VsyncMode)vsync;
+            set_frame_pacing(pacing);
+        }
+        const Fractal::FramePacerStatistics& fp = get_frame_pacer()->get_statistics();
+        ImGui::Text("Frame: %.2f ms (average %.2f, jitter %.2f)", fp.frame_ms, fp.average_frame_ms, fp.jitter_ms);
+        ImGui::Text("Min %.2f ms, Max %.2f ms, %d missed", fp.min_frame_ms, fp.max_frame_ms, (int)fp.missed_deadlines);
+        ImGui::Text("Sleep %.2f ms, Spin %.2f ms, Latency Wait %.2f ms", fp.sleep_ms, fp.spin_ms, fp.latency_wait_ms);
+        const std::vector<float>& frame_times = get_frame_pacer()->get_history();
+        ImGui::PlotLines("Frame Time", frame_times.data(), (int)frame_times.size(), get_frame_pacer()->get_history_offset(), nullptr, 0.0f, fp.average_frame_ms * 2.0f, ImVec2(0, 60));
         ImGui::End();
     }
 
     ~Sandbox() {
         delete renderer;
-        delete texture;
+        texture.reset();
+        delete assets;
+        delete texture_loader;
+        delete dynamic_resolution;
+        delete picking;
     }
 
     void on_user_event(Fractal::Event& event) {
@@ -109,29 +374,44 @@ public:
 
 	void keyboard_event(Fractal::KeyboardEvents& keyboard) {
         if (keyboard.GetKeyPress(GLFW_KEY_R)) {
-            p = i_p;
-            p_delta = p;
-            t = 0;
-            traj_index = 0;
+            world.get<Fractal::Transform>(projectile)->position = i_p;
+            world.get<Fractal::Velocity>(projectile)->linear = i_v;
+            world.get<Fractal::Velocity>(projectile)->acceleration = { 0, g, 0 };
+            world.get<Fractal::PreviousTransform>(projectile)->transform = *world.get<Fractal::Transform>(projectile);
+            p_delta = i_p;
+            for (Fractal::Entity point : trajectory)
+                world.destroy(point);
+            trajectory.clear();
+            scene_index.clear();
+            hovered_point = Fractal::PICKING_NO_OBJECT;
         }
     }
 private:
     Fractal::PerspectiveCameraController camera;
     Fractal::Renderer* renderer;
 
-    Fractal::Texture* texture;
+    Fractal::TextureLoader* texture_loader;
+    Fractal::AssetManager* assets;
+    Fractal::TextureHandle texture;
+    Fractal::DynamicResolution* dynamic_resolution;
+    Fractal::PickingPass* picking;
+    uint32_t hovered_point = Fractal::PICKING_NO_OBJECT;
+    std::vector<Fractal::AllocationFrame> allocation_history;
+    std::vector<float> allocation_counts;
 
     float g = -9.81;
-    double t = 0.0;
-    glm::vec3 p = { 0, 0, 0 };
     glm::vec3 i_p = { 0, 30, 0 };
     glm::vec3 i_v = { 0, 0, 0 };
 
     glm::vec3 cam_p = { -17, 12, 24 };
 
-    glm::vec3 trajectory_points[1000];
-    float traj_timer = 0;
-    int traj_index = 0;
+    Fractal::World world;
+    Fractal::SystemScheduler systems;
+    Fractal::FixedTimestepSettings timestep_settings;
+    Fractal::Entity projectile;
+    std::vector<Fractal::Entity> trajectory;
+    Fractal::Bvh scene_index;
+    std::vector<uint32_t> visible_points;
     glm::vec3 p_delta = { 0, 0, 0 };
 
     glm::vec4 background_color = { 0.4, 0.6, 0.6, 1 };